@@ -85,6 +85,8 @@ enum class StructType
     D3D12ExperimentalFeaturesDesc,
 
     VulkanDeviceExtendedDesc,
+
+    CPUDeviceExtendedDesc,
 };
 
 // TODO: Implementation or backend or something else?
@@ -2102,6 +2104,19 @@ public:
     virtual SLANG_NO_THROW const RayTracingPipelineDesc& SLANG_MCALL getDesc() = 0;
 };
 
+/// Tracks the creation of a pipeline created with one of the `IDevice::create*PipelineAsync()` methods.
+class IPipelineCreationTask : public ISlangUnknown
+{
+    SLANG_COM_INTERFACE(0x3e67f46a, 0x7513, 0x4948, {0xb9, 0xdf, 0xfa, 0x35, 0x58, 0xaf, 0xc2, 0xf0});
+
+public:
+    /// Returns true once the pipeline creation has finished, successfully or not.
+    virtual SLANG_NO_THROW bool SLANG_MCALL isReady() = 0;
+
+    /// Block until the pipeline creation has finished and return its result.
+    virtual SLANG_NO_THROW Result SLANG_MCALL wait() = 0;
+};
+
 struct ScissorRect
 {
     uint32_t minX = 0;
@@ -2470,6 +2485,37 @@ struct CommandBufferDesc
 
     /// The name of the command buffer for debugging purposes.
     const char* label = nullptr;
+
+    /// Make the command buffer reusable.
+    /// A reusable command buffer is not consumed on submit and can be submitted any number of times, including
+    /// while a previous submission is still in flight. Its recorded commands, resolved pipelines and any native
+    /// recording are kept unchanged, and all resources it references are retained until the command buffer
+    /// itself is released.
+    bool reusable = false;
+
+    /// Remove redundant commands after pipelines are resolved.
+    /// Bind state commands that are identical to the currently bound state, repeated barriers and empty debug
+    /// groups are removed. The number of removed commands is reported by `ICommandBuffer::getStats`.
+    bool optimizeCommands = false;
+};
+
+struct CommandBufferStats
+{
+    /// Number of commands in the command buffer.
+    uint32_t commandCount = 0;
+    /// Number of commands removed when finishing the command buffer (see `CommandBufferDesc::optimizeCommands`).
+    uint32_t removedCommandCount = 0;
+    /// Number of bytes of command memory used by the recorded commands.
+    uint64_t memoryUsed = 0;
+    /// Highest number of bytes of command memory used by any recording with this command buffer.
+    uint64_t memoryPeak = 0;
+    /// Number of bytes of command memory held by the command buffer, including unused pages kept for reuse.
+    uint64_t memoryReserved = 0;
+    /// Number of command memory pages held by the command buffer.
+    uint32_t memoryPageCount = 0;
+    /// Number of times binding data built for unchanged shader objects was reused instead of rebuilt.
+    /// Only counted by backends that cache binding data (CPU).
+    uint32_t bindingDataReuseCount = 0;
 };
 
 class ICommandBuffer : public ISlangUnknown
@@ -2480,6 +2526,17 @@ public:
     virtual SLANG_NO_THROW const CommandBufferDesc& SLANG_MCALL getDesc() = 0;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) = 0;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getStats(CommandBufferStats* outStats) = 0;
+
+    /// Serialize the recorded transfer commands (copies, clears, uploads, query resolves, state changes and debug
+    /// markers) and the descriptors of the referenced resources into a binary blob.
+    /// The capture can be replayed on any device with the `slang-rhi-transfer-replay` tool to measure transfer costs.
+    /// Data staged by `uploadBufferData` and `uploadTextureData` is included, so the command buffer must be
+    /// captured before it is submitted (unless it is reusable).
+    /// Returns `SLANG_E_NOT_AVAILABLE` if the command buffer records commands that depend on pipelines, shader
+    /// objects, acceleration structures or callbacks, which cannot be captured.
+    virtual SLANG_NO_THROW Result SLANG_MCALL captureTransfers(ISlangBlob** outBlob) = 0;
 };
 
 class IPassEncoder : public ISlangUnknown
@@ -2766,6 +2823,21 @@ public:
 
     virtual SLANG_NO_THROW void SLANG_MCALL executeCallback(const ExecuteCallbackDesc& desc) = 0;
 
+    /// Create a child encoder for encoding commands in parallel.
+    /// The child records into its own command storage and can be used from another thread while the parent
+    /// and other children are encoding. When the parent is finished, the commands of all children are inserted
+    /// at the position the parent was at when each child was created, in creation order.
+    /// Child encoders can only be created while no pass is open on the parent and cannot create children
+    /// themselves. Child encoders must not be finished and must have no open pass when the parent is finished.
+    virtual SLANG_NO_THROW Result SLANG_MCALL createChildEncoder(ICommandEncoder** outEncoder) = 0;
+
+    inline ComPtr<ICommandEncoder> createChildEncoder()
+    {
+        ComPtr<ICommandEncoder> encoder;
+        SLANG_RETURN_NULL_ON_FAIL(createChildEncoder(encoder.writeRef()));
+        return encoder;
+    }
+
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(
         const CommandBufferDesc& desc,
         ICommandBuffer** outCommandBuffer
@@ -3028,6 +3100,30 @@ struct HeapReport
     uint64_t numAllocations = 0;
 };
 
+/// Per command type counts and CPU times, see `IDevice::getCommandProfile`.
+struct CommandProfileEntry
+{
+    /// Name of the command type.
+    const char* command = nullptr;
+    /// Number of encoded commands.
+    uint64_t encodeCount = 0;
+    /// Total CPU time spent encoding commands in nanoseconds.
+    uint64_t encodeTimeNS = 0;
+    /// Number of commands recorded to native command buffers or executed by the backend.
+    uint64_t executeCount = 0;
+    /// Total CPU time spent recording or executing commands in the backend in nanoseconds.
+    uint64_t executeTimeNS = 0;
+};
+
+enum class CommandProfileFormat
+{
+    /// JSON object with one entry per command type.
+    JSON,
+    /// Chrome trace event format with the most recent backend command spans
+    /// (viewable in chrome://tracing or Perfetto).
+    ChromeTrace,
+};
+
 class IHeap : public ISlangUnknown
 {
     SLANG_COM_INTERFACE(0x1c3b8f2a, 0x4d5e, 0x4b6c, {0x9f, 0x7d, 0x3e, 0x1c, 0x8b, 0x6f, 0x2c, 0x5a});
@@ -3349,6 +3445,15 @@ struct DeviceDesc
     /// finishing a command encoder.
     PipelineCompilationMode pipelineCompilationMode = PipelineCompilationMode::Serial;
 
+    /// Record the specialization arguments of every specialized pipeline created by the device.
+    /// The recorded manifest can be retrieved with `IDevice::getPipelineManifest()`.
+    bool recordPipelineManifest = false;
+
+    /// Maximum number of specialized pipelines cached by the device. 0 means unlimited.
+    /// When the limit is exceeded, the least recently used specialized pipelines are evicted and are created again
+    /// on their next use. Command buffers keep the pipelines they use alive until they are released.
+    uint32_t maxSpecializedPipelineCount = 0;
+
     /// Enable launching CUDA kernels from inside graphics command buffers
     /// (Vulkan only, via VK_NVX_binary_import). On by default. Set to
     /// false if the application doesn't need vkCmdCuLaunchKernelNVX;
@@ -3371,6 +3476,18 @@ struct DeviceDesc
     BindlessDesc bindless = {};
 };
 
+struct SpecializedPipelineCacheStats
+{
+    /// Number of specialized pipelines currently cached.
+    uint32_t entryCount = 0;
+    /// Number of lookups that found a cached specialized pipeline.
+    uint64_t hitCount = 0;
+    /// Number of lookups that did not find a cached specialized pipeline.
+    uint64_t missCount = 0;
+    /// Number of specialized pipelines evicted because of `DeviceDesc::maxSpecializedPipelineCount`.
+    uint64_t evictionCount = 0;
+};
+
 class IDevice : public ISlangUnknown
 {
     SLANG_COM_INTERFACE(0x311ee28b, 0xdb5a, 0x4a3c, {0x89, 0xda, 0xf0, 0x03, 0x0f, 0xd5, 0x70, 0x4b});
@@ -3677,8 +3794,61 @@ public:
         return pipeline;
     }
 
+    /// Create a render pipeline asynchronously.
+    /// Target code compilation and backend pipeline creation run on the task pool, and the returned pipeline can be
+    /// used right away. If the pipeline is still being created when a command encoder using it is finished,
+    /// `fallback` is used in its place if specified, otherwise finishing the encoder waits for the pipeline.
+    /// The fallback must be created from a program with the same parameter layout, without unbound specialization
+    /// parameters. Pipelines for programs that require specialization are specialized when used, as usual.
+    /// `outTask` can be used to poll or wait for the creation. It may be null.
+    virtual SLANG_NO_THROW Result SLANG_MCALL createRenderPipelineAsync(
+        const RenderPipelineDesc& desc,
+        IRenderPipeline* fallback,
+        IRenderPipeline** outPipeline,
+        IPipelineCreationTask** outTask
+    ) = 0;
+
+    /// Create a compute pipeline asynchronously.
+    /// See `createRenderPipelineAsync()` for details.
+    virtual SLANG_NO_THROW Result SLANG_MCALL createComputePipelineAsync(
+        const ComputePipelineDesc& desc,
+        IComputePipeline* fallback,
+        IComputePipeline** outPipeline,
+        IPipelineCreationTask** outTask
+    ) = 0;
+
+    /// Create a ray tracing pipeline asynchronously.
+    /// See `createRenderPipelineAsync()` for details.
+    virtual SLANG_NO_THROW Result SLANG_MCALL createRayTracingPipelineAsync(
+        const RayTracingPipelineDesc& desc,
+        IRayTracingPipeline* fallback,
+        IRayTracingPipeline** outPipeline,
+        IPipelineCreationTask** outTask
+    ) = 0;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL getCompilationReportList(ISlangBlob** outReportListBlob) = 0;
 
+    /// Get the manifest of specialized pipelines created by the device.
+    /// Requires `DeviceDesc::recordPipelineManifest`.
+    /// The manifest can be stored and passed to `precompilePipelines()` on a later run.
+    virtual SLANG_NO_THROW Result SLANG_MCALL getPipelineManifest(ISlangBlob** outManifest) = 0;
+
+    /// Create the specialized pipelines listed in a manifest ahead of their first use.
+    /// Manifest entries are matched to `pipelines` by the shader program the pipelines were created with.
+    /// Entries that match none of the pipelines, or refer to types that no longer exist, are skipped.
+    /// Shaders are compiled and pipelines are created in parallel on the task pool.
+    /// Returns once all pipelines are created.
+    virtual SLANG_NO_THROW Result SLANG_MCALL precompilePipelines(
+        IPipeline** pipelines,
+        uint32_t pipelineCount,
+        ISlangBlob* manifest
+    ) = 0;
+
+    /// Get statistics of the cache of specialized pipelines, see `DeviceDesc::maxSpecializedPipelineCount`.
+    virtual SLANG_NO_THROW Result SLANG_MCALL getSpecializedPipelineCacheStats(
+        SpecializedPipelineCacheStats* outStats
+    ) = 0;
+
     /// Read back texture resource and stores the result in `outData`.
     /// `layout` is the layout to store the data in. It is the caller's responsibility to
     /// ensure that the layout is compatible with the texture format and mip level.
@@ -3807,6 +3977,18 @@ public:
     /// number of heaps available or written
     virtual SLANG_NO_THROW Result SLANG_MCALL reportHeaps(HeapReport* heapReports, uint32_t* heapCount) = 0;
 
+    /// Get per command type counts and CPU times collected since the device was created or the profile was reset.
+    /// Uses the same calling convention as `reportHeaps`, with one entry per command type.
+    /// Returns SLANG_E_NOT_AVAILABLE unless slang-rhi is built with `SLANG_RHI_ENABLE_COMMAND_PROFILING`.
+    virtual SLANG_NO_THROW Result SLANG_MCALL getCommandProfile(CommandProfileEntry* entries, uint32_t* entryCount) = 0;
+
+    /// Write the collected command profile in the given format.
+    /// Returns SLANG_E_NOT_AVAILABLE unless slang-rhi is built with `SLANG_RHI_ENABLE_COMMAND_PROFILING`.
+    virtual SLANG_NO_THROW Result SLANG_MCALL dumpCommandProfile(CommandProfileFormat format, ISlangBlob** outBlob) = 0;
+
+    /// Reset the collected command profile.
+    virtual SLANG_NO_THROW Result SLANG_MCALL resetCommandProfile() = 0;
+
     /// Set the device's CUDA context as current on this thread.
     /// For non-CUDA devices, this is a no-op.
     virtual SLANG_NO_THROW Result SLANG_MCALL setCudaContextCurrent() = 0;
@@ -3956,6 +4138,19 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL queryCache(ISlangBlob* key, ISlangBlob** outData) = 0;
 };
 
+struct FilePersistentCacheDesc
+{
+    /// Directory to store the cache in. It is created if it does not exist.
+    /// A cache directory can be shared by multiple caches, including caches in other processes.
+    const char* path = nullptr;
+    /// Maximum total size of the cached data in bytes (0 for no limit).
+    /// When exceeded, the least recently used entries are evicted.
+    uint64_t maxSize = 0;
+    /// Maximum number of entries in the cache.
+    /// Only used when the cache directory is initialized, afterwards the existing capacity is kept.
+    uint32_t maxEntryCount = 16384;
+};
+
 /// Options for downstream API debug layers.
 struct DebugLayerOptions
 {
@@ -4041,6 +4236,22 @@ public:
         return blob;
     }
 
+    /// Create a persistent cache stored in a directory on disk.
+    /// The cache can be used as `DeviceDesc::persistentShaderCache` and `DeviceDesc::persistentPipelineCache`,
+    /// shared by multiple devices, and shared with other processes using the same directory.
+    /// Queried entries are returned as views of memory-mapped cache files.
+    virtual SLANG_NO_THROW Result SLANG_MCALL createFilePersistentCache(
+        const FilePersistentCacheDesc& desc,
+        IPersistentCache** outCache
+    ) = 0;
+
+    ComPtr<IPersistentCache> createFilePersistentCache(const FilePersistentCacheDesc& desc)
+    {
+        ComPtr<IPersistentCache> cache;
+        SLANG_RETURN_NULL_ON_FAIL(createFilePersistentCache(desc, cache.writeRef()));
+        return cache;
+    }
+
     /// Reports current set of live objects.
     /// Lists all live RHI objects as well as D3D's live objects (using ReportLiveObjects).
     virtual SLANG_NO_THROW Result SLANG_MCALL reportLiveObjects() = 0;
@@ -4095,6 +4306,28 @@ struct VulkanDeviceExtendedDesc
     const char* const* deviceExtensions = nullptr;
 };
 
+struct CPUDeviceExtendedDesc
+{
+    StructType structType = StructType::CPUDeviceExtendedDesc;
+    const void* next = nullptr;
+
+    /// Number of thread groups executed by a single task when a compute dispatch is split
+    /// across the global task pool. A value of 0 selects the grain size automatically.
+    uint32_t computeGrainSize = 0;
+    /// Execute all work on the submitting thread instead of the global task pool.
+    /// Useful for deterministic debugging.
+    bool singleThreaded = false;
+    /// Execute submitted command buffers on a dedicated queue thread.
+    /// Submits return immediately, wait fences only block the queue thread and signal fences are
+    /// set once execution has finished, even if it failed. Execution errors are returned by the next
+    /// `ICommandQueue::waitOnHost()`.
+    bool asyncQueue = false;
+    /// Number of times a fence wait polls the fence values before the waiting thread is put to sleep.
+    uint32_t fenceSpinCount = 64;
+    /// Request huge pages for the memory backing `IHeap` pages (where supported by the OS).
+    bool heapHugePages = false;
+};
+
 } // namespace rhi
 
 /// Get the global interface to the RHI.
@@ -4,6 +4,8 @@
 #include "device.h"
 #include "format-conversion.h"
 #include "pipeline-resolver.h"
+#include "command-list-optimizer.h"
+#include "command-capture.h"
 
 namespace rhi {
 
@@ -684,18 +686,61 @@ Result CommandEncoder::uploadTextureData(
 
 Result CommandEncoder::uploadBufferData(IBuffer* dst, Offset offset, Size size, const void* data)
 {
-    RefPtr<StagingHeap::Handle> handle;
-    // Buffer copy offsets must be aligned to four bytes.
-    SLANG_RETURN_ON_FAIL(getDevice()->m_uploadHeap.stageHandle(data, size, 4, {}, handle.writeRef()));
+    IBuffer* src;
+    Offset srcOffset;
+    if (size <= kMaxBatchedUploadSize)
+    {
+        // Small uploads are sub-allocated from a staging block owned by the encoder,
+        // which avoids a heap allocation per upload.
+        // Buffer copy offsets must be aligned to four bytes.
+        Size blockOffset = calcAligned2(m_uploadBlockUsed, 4);
+        if (!m_uploadBlock || blockOffset + size > m_uploadBlock->getSize())
+        {
+            SLANG_RETURN_ON_FAIL(
+                getDevice()->m_uploadHeap.allocHandle(kUploadBlockSize, 4, {}, m_uploadBlock.writeRef())
+            );
+            m_commandList->retainResource(m_uploadBlock);
+            blockOffset = 0;
+        }
+        void* mapped;
+        SLANG_RETURN_ON_FAIL(m_uploadBlock->map(&mapped));
+        std::memcpy(static_cast<uint8_t*>(mapped) + blockOffset, data, size);
+        m_uploadBlock->unmap();
+        m_uploadBlockUsed = blockOffset + size;
+        src = m_uploadBlock->getBuffer();
+        srcOffset = m_uploadBlock->getOffset() + blockOffset;
+    }
+    else
+    {
+        RefPtr<StagingHeap::Handle> handle;
+        // Buffer copy offsets must be aligned to four bytes.
+        SLANG_RETURN_ON_FAIL(getDevice()->m_uploadHeap.stageHandle(data, size, 4, {}, handle.writeRef()));
+        m_commandList->retainResource(handle);
+        src = handle->getBuffer();
+        srcOffset = handle->getOffset();
+    }
 
-    m_commandList->retainResource(handle);
+    // Extend the previous upload if it is contiguous in both the staging and the destination buffer.
+    // Commands of a child encoder created after the previous upload are spliced in behind it, so don't merge then.
+    CommandList::CommandSlot* lastCommand = m_commandList->getLastCommand();
+    bool childAfterLast = !m_childEncoders.empty() && m_childEncoders.back().position == lastCommand;
+    if (lastCommand && lastCommand->id == CommandID::CopyBuffer && !childAfterLast)
+    {
+        auto& prev = m_commandList->getCommand<commands::CopyBuffer>(lastCommand);
+        if (prev.dst == dst && prev.src == src && prev.dstOffset + prev.size == offset &&
+            prev.srcOffset + prev.size == srcOffset)
+        {
+            prev.size += size;
+            return SLANG_OK;
+        }
+    }
 
     commands::CopyBuffer cmd;
 
     cmd.dst = dst;
     cmd.dstOffset = offset;
-    cmd.src = handle->getBuffer();
-    cmd.srcOffset = handle->getOffset();
+    cmd.src = src;
+    cmd.srcOffset = srcOffset;
     cmd.size = size;
 
     m_commandList->write(std::move(cmd));
@@ -916,6 +961,51 @@ void CommandEncoder::executeCallback(const ExecuteCallbackDesc& desc)
     m_commandList->write(std::move(cmd));
 }
 
+Result CommandEncoder::createChildEncoder(ICommandEncoder** outEncoder)
+{
+    if (m_isChildEncoder || isPassActive() || !m_commandList)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    RefPtr<CommandEncoder> encoder;
+    SLANG_RETURN_ON_FAIL(createChildEncoderImpl(encoder.writeRef()));
+    encoder->m_isChildEncoder = true;
+    m_childEncoders.push_back({encoder, m_commandList->getLastCommand()});
+    returnComPtr(outEncoder, encoder);
+    return SLANG_OK;
+}
+
+Result CommandEncoder::finishChildEncoders(CommandBuffer* commandBuffer)
+{
+    if (m_isChildEncoder)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    for (const ChildEncoder& child : m_childEncoders)
+    {
+        if (child.encoder->isPassActive())
+        {
+            return SLANG_E_INVALID_ARG;
+        }
+    }
+    // Splice in reverse creation order, so children sharing an insertion point end up in creation order.
+    for (auto it = m_childEncoders.rbegin(); it != m_childEncoders.rend(); ++it)
+    {
+        CommandEncoder* child = it->encoder;
+        RefPtr<CommandBuffer> childCommandBuffer;
+        SLANG_RETURN_ON_FAIL(child->detachCommandBuffer(childCommandBuffer.writeRef()));
+        commandBuffer->m_commandList.splice(it->position, childCommandBuffer->m_commandList);
+        for (auto& specializationArgs : child->m_pipelineSpecializationArgs)
+        {
+            m_pipelineSpecializationArgs.push_back(std::move(specializationArgs));
+        }
+        child->m_pipelineSpecializationArgs.clear();
+        commandBuffer->m_childCommandBuffers.push_back(childCommandBuffer);
+    }
+    m_childEncoders.clear();
+    return SLANG_OK;
+}
+
 Result CommandEncoder::finish(const CommandBufferDesc& desc, ICommandBuffer** outCommandBuffer)
 {
     // iterate over commands and specialize pipelines
@@ -959,6 +1049,15 @@ ICommandBuffer* CommandBuffer::getInterface(const Guid& guid)
     return nullptr;
 }
 
+CommandBuffer::CommandBuffer(Device* device)
+    : DeviceChild(device)
+    , m_commandList(m_allocator, m_trackedObjects, m_trackedExecuteCallbackObjects)
+{
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+    m_commandList.setProfiler(&device->m_commandProfiler);
+#endif
+}
+
 CommandBuffer::~CommandBuffer()
 {
     resetCallbackObjects();
@@ -970,9 +1069,48 @@ Result CommandBuffer::reset()
     resetCallbackObjects();
     m_allocator.reset();
     m_trackedObjects.clear();
+    m_removedCommandCount = 0;
+    m_bindingDataReuseCount = 0;
+    m_childCommandBuffers.clear();
     return SLANG_OK;
 }
 
+void CommandBuffer::optimizeCommands()
+{
+    m_removedCommandCount = m_desc.optimizeCommands ? optimizeCommandList(&m_commandList) : 0;
+}
+
+Result CommandBuffer::getStats(CommandBufferStats* outStats)
+{
+    CommandBufferStats stats;
+    for (const CommandList::CommandSlot* command : m_commandList)
+    {
+        stats.commandCount++;
+    }
+    stats.removedCommandCount = m_removedCommandCount;
+    stats.bindingDataReuseCount = m_bindingDataReuseCount;
+    auto addMemoryStats = [&stats](const ArenaAllocator::Stats& allocatorStats)
+    {
+        stats.memoryUsed += allocatorStats.usedBytes;
+        stats.memoryPeak += allocatorStats.peakUsedBytes;
+        stats.memoryReserved += allocatorStats.reservedBytes;
+        stats.memoryPageCount += uint32_t(allocatorStats.pageCount);
+    };
+    addMemoryStats(m_allocator.getStats());
+    for (const auto& childCommandBuffer : m_childCommandBuffers)
+    {
+        addMemoryStats(childCommandBuffer->m_allocator.getStats());
+        stats.bindingDataReuseCount += childCommandBuffer->m_bindingDataReuseCount;
+    }
+    *outStats = stats;
+    return SLANG_OK;
+}
+
+Result CommandBuffer::captureTransfers(ISlangBlob** outBlob)
+{
+    return captureTransferCommands(getDevice(), m_commandList, outBlob);
+}
+
 void CommandBuffer::resetCallbackObjects()
 {
     for (const ExecuteCallbackObjectRetainer& object : m_trackedExecuteCallbackObjects)
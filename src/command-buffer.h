@@ -11,11 +11,10 @@
 #include "reference.h"
 #include "command-list.h"
 #include "device-child.h"
+#include "staging-heap.h"
 
 #include "rhi-shared-fwd.h"
 
-#include <set>
-
 namespace rhi {
 
 struct BindingData
@@ -115,7 +114,7 @@ public:
     ComPtr<IComputePipeline> m_pipeline;
     RefPtr<RootShaderObject> m_rootObject;
     /// Command list, nullptr if pass encoder is not active.
-    CommandList* m_commandList;
+    CommandList* m_commandList = nullptr;
 
     ComputePassEncoder(CommandEncoder* commandEncoder);
 
@@ -154,7 +153,7 @@ public:
     ComPtr<IShaderTable> m_shaderTable;
     RefPtr<RootShaderObject> m_rootObject;
     /// Command list, nullptr if pass encoder is not active.
-    CommandList* m_commandList;
+    CommandList* m_commandList = nullptr;
 
     RayTracingPassEncoder(CommandEncoder* commandEncoder);
 
@@ -208,6 +207,28 @@ public:
     // This is populated during command encoding and later used when asynchronously resolving pipelines.
     std::vector<RefPtr<ExtendedShaderObjectTypeListObject>> m_pipelineSpecializationArgs;
 
+    struct ChildEncoder
+    {
+        RefPtr<CommandEncoder> encoder;
+        /// Command after which the child's commands are inserted, nullptr to insert at the front.
+        CommandList::CommandSlot* position;
+    };
+
+    /// Child encoders created with `createChildEncoder`, in creation order.
+    std::vector<ChildEncoder> m_childEncoders;
+    /// True if this encoder was created with `createChildEncoder`.
+    bool m_isChildEncoder = false;
+
+    /// Uploads of at most this size are staged in the encoder's upload block (see `uploadBufferData`).
+    static constexpr Size kMaxBatchedUploadSize = 4 * 1024;
+    /// Size of the staging blocks used for batched uploads.
+    static constexpr Size kUploadBlockSize = 64 * 1024;
+
+    /// Current staging block for small uploads, retained by the command list.
+    RefPtr<StagingHeap::Handle> m_uploadBlock;
+    /// Number of bytes used in the current upload block.
+    Size m_uploadBlockUsed = 0;
+
     CommandEncoder(Device* device, const CommandEncoderDesc& desc)
         : DeviceChild(device)
         , m_desc(desc)
@@ -227,9 +248,30 @@ public:
     );
     Result resolvePipelines(Device* device);
 
+    /// Returns true if a render, compute or ray tracing pass is currently open.
+    bool isPassActive() const
+    {
+        return m_renderPassEncoder.m_commandList || m_computePassEncoder.m_commandList ||
+               m_rayTracingPassEncoder.m_commandList;
+    }
+
+    /// Create an encoder of the same type, recording into its own command buffer from the same queue.
+    virtual Result createChildEncoderImpl(CommandEncoder** outEncoder) = 0;
+
+    /// Release the command buffer of a child encoder once its parent is finished.
+    /// Runs the backend specific finalization that `finish` performs before recording.
+    virtual Result detachCommandBuffer(CommandBuffer** outCommandBuffer) = 0;
+
+    /// Move the commands of all child encoders into `commandBuffer` at their insertion points.
+    /// Command data is relinked, not copied. The child command buffers are kept alive by `commandBuffer`.
+    /// Must be called at the start of `finish`, before pipelines are resolved.
+    Result finishChildEncoders(CommandBuffer* commandBuffer);
+
     // ICommandEncoder implementation
     virtual SLANG_NO_THROW const CommandEncoderDesc& SLANG_MCALL getDesc() override { return m_desc; }
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL createChildEncoder(ICommandEncoder** outEncoder) override;
+
     virtual SLANG_NO_THROW IRenderPassEncoder* SLANG_MCALL beginRenderPass(const RenderPassDesc& desc) override;
     virtual SLANG_NO_THROW IComputePassEncoder* SLANG_MCALL beginComputePass() override;
     virtual SLANG_NO_THROW IRayTracingPassEncoder* SLANG_MCALL beginRayTracingPass() override;
@@ -393,11 +435,7 @@ public:
     ICommandBuffer* getInterface(const Guid& guid);
 
 public:
-    CommandBuffer(Device* device)
-        : DeviceChild(device)
-        , m_commandList(m_allocator, m_trackedObjects, m_trackedExecuteCallbackObjects)
-    {
-    }
+    CommandBuffer(Device* device);
     virtual ~CommandBuffer();
 
     virtual void makeExternal() override { establishStrongReferenceToDevice(); }
@@ -412,16 +450,32 @@ public:
         m_descHolder.holdString(m_desc.label);
     }
 
+    /// Returns true if the command buffer was finished with `CommandBufferDesc::reusable`.
+    /// Reusable command buffers are never reset or returned to a pool after execution.
+    bool isReusable() const { return m_desc.reusable; }
+
+    /// Remove redundant commands from the command list if requested by `CommandBufferDesc::optimizeCommands`.
+    /// Must be called after pipelines are resolved.
+    void optimizeCommands();
+
     // ICommandBuffer implementation
     virtual SLANG_NO_THROW const CommandBufferDesc& SLANG_MCALL getDesc() override { return m_desc; }
+    virtual SLANG_NO_THROW Result SLANG_MCALL getStats(CommandBufferStats* outStats) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL captureTransfers(ISlangBlob** outBlob) override;
 
 public:
     CommandBufferDesc m_desc;
     StructHolder m_descHolder;
     ArenaAllocator m_allocator;
-    std::set<RefPtr<RefObject>> m_trackedObjects;
+    RefObjectSet m_trackedObjects;
     std::vector<ExecuteCallbackObjectRetainer> m_trackedExecuteCallbackObjects;
     CommandList m_commandList;
+    uint32_t m_removedCommandCount = 0;
+    /// Number of times a backend reused cached binding data, see `CommandBufferStats::bindingDataReuseCount`.
+    uint32_t m_bindingDataReuseCount = 0;
+    /// Command buffers of child encoders whose commands were spliced into this command buffer.
+    /// They own the command data and per-buffer backend resources, and are released on reset.
+    std::vector<RefPtr<CommandBuffer>> m_childCommandBuffers;
 
 private:
     void resetCallbackObjects();
@@ -0,0 +1,1226 @@
+#include "command-capture.h"
+#include "rhi-shared.h"
+
+#include "core/blob.h"
+#include "core/short_vector.h"
+#include "core/timer.h"
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace rhi {
+
+namespace {
+
+static constexpr uint32_t kCaptureObjectTypeCount = 4;
+
+inline bool isUploadBuffer(IBuffer* buffer)
+{
+    return buffer && checked_cast<Buffer*>(buffer)->m_desc.memoryType == MemoryType::Upload;
+}
+
+/// Returns true for the commands that can be captured, see `kCaptureVersion`.
+bool isTransferCommand(CommandID id)
+{
+    switch (id)
+    {
+    case CommandID::CopyBuffer:
+    case CommandID::CopyTexture:
+    case CommandID::CopyTextureToBuffer:
+    case CommandID::ClearBuffer:
+    case CommandID::ClearTextureFloat:
+    case CommandID::ClearTextureUint:
+    case CommandID::ClearTextureDepthStencil:
+    case CommandID::UploadTextureData:
+    case CommandID::ResolveQuery:
+    case CommandID::BeginRenderPass:
+    case CommandID::EndRenderPass:
+    case CommandID::BeginComputePass:
+    case CommandID::EndComputePass:
+    case CommandID::BeginRayTracingPass:
+    case CommandID::EndRayTracingPass:
+    case CommandID::SetBufferState:
+    case CommandID::SetTextureState:
+    case CommandID::GlobalBarrier:
+    case CommandID::PushDebugGroup:
+    case CommandID::PopDebugGroup:
+    case CommandID::InsertDebugMarker:
+    case CommandID::WriteTimestamp:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Appends values to a capture, see `kCaptureVersion` for the encoding.
+class CaptureStreamWriter
+{
+public:
+    std::vector<uint8_t> data;
+
+    void writeU8(uint8_t value) { data.push_back(value); }
+    void writeBool(bool value) { writeU8(value ? 1 : 0); }
+
+    void writeU32(uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            data.push_back(uint8_t(value >> (i * 8)));
+    }
+
+    void writeU64(uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+            data.push_back(uint8_t(value >> (i * 8)));
+    }
+
+    void writeF32(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeU32(bits);
+    }
+
+    template<typename T>
+    void writeEnum(T value)
+    {
+        writeU32(uint32_t(value));
+    }
+
+    void writeBytes(const void* bytes, size_t size)
+    {
+        const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+        data.insert(data.end(), begin, begin + size);
+    }
+
+    /// Append `size` uninitialized bytes and return a pointer to them.
+    uint8_t* reserveBytes(size_t size)
+    {
+        size_t offset = data.size();
+        data.resize(offset + size);
+        return data.data() + offset;
+    }
+
+    void writeString(const char* str)
+    {
+        writeBool(str != nullptr);
+        if (str)
+        {
+            size_t length = strlen(str);
+            writeU32(uint32_t(length));
+            writeBytes(str, length);
+        }
+    }
+
+    void writeOffset3D(const Offset3D& offset)
+    {
+        writeU32(offset.x);
+        writeU32(offset.y);
+        writeU32(offset.z);
+    }
+
+    void writeExtent3D(const Extent3D& extent)
+    {
+        writeU32(extent.width);
+        writeU32(extent.height);
+        writeU32(extent.depth);
+    }
+
+    void writeSubresourceRange(const SubresourceRange& range)
+    {
+        writeU32(range.layer);
+        writeU32(range.layerCount);
+        writeU32(range.mip);
+        writeU32(range.mipCount);
+    }
+
+    void writeSubresourceLayout(const SubresourceLayout& layout)
+    {
+        writeExtent3D(layout.size);
+        writeU64(layout.colPitch);
+        writeU64(layout.rowPitch);
+        writeU64(layout.slicePitch);
+        writeU64(layout.sizeInBytes);
+        writeU64(layout.blockWidth);
+        writeU64(layout.blockHeight);
+        writeU64(layout.rowCount);
+    }
+
+    void writeMarkerColor(const MarkerColor& color)
+    {
+        writeF32(color.r);
+        writeF32(color.g);
+        writeF32(color.b);
+    }
+};
+
+} // namespace
+
+/// Reads values written by `CaptureStreamWriter`.
+/// Reading past the end of the data marks the reader as failed and returns zero values.
+class CaptureStreamReader
+{
+public:
+    CaptureStreamReader(const uint8_t* data, size_t size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    bool isFailed() const { return m_failed; }
+    void fail() { m_failed = true; }
+
+    /// Return a pointer to the next `size` bytes and skip them, or null if there are not enough bytes left.
+    const uint8_t* readBytes(uint64_t size)
+    {
+        if (m_failed || uint64_t(m_size - m_offset) < size)
+        {
+            m_failed = true;
+            return nullptr;
+        }
+        const uint8_t* bytes = m_data + m_offset;
+        m_offset += size_t(size);
+        return bytes;
+    }
+
+    uint8_t readU8()
+    {
+        const uint8_t* bytes = readBytes(1);
+        return bytes ? bytes[0] : 0;
+    }
+
+    bool readBool() { return readU8() != 0; }
+
+    uint32_t readU32()
+    {
+        const uint8_t* bytes = readBytes(4);
+        uint32_t value = 0;
+        for (int i = 0; bytes && i < 4; ++i)
+            value |= uint32_t(bytes[i]) << (i * 8);
+        return value;
+    }
+
+    uint64_t readU64()
+    {
+        const uint8_t* bytes = readBytes(8);
+        uint64_t value = 0;
+        for (int i = 0; bytes && i < 8; ++i)
+            value |= uint64_t(bytes[i]) << (i * 8);
+        return value;
+    }
+
+    float readF32()
+    {
+        uint32_t bits = readU32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    template<typename T>
+    T readEnum()
+    {
+        return T(readU32());
+    }
+
+    /// Read a string into `outString`, returning null for a null string.
+    const char* readString(std::string& outString)
+    {
+        if (!readBool())
+            return nullptr;
+        uint32_t length = readU32();
+        const uint8_t* bytes = readBytes(length);
+        if (!bytes)
+            return nullptr;
+        outString.assign(reinterpret_cast<const char*>(bytes), length);
+        return outString.c_str();
+    }
+
+    Offset3D readOffset3D()
+    {
+        Offset3D offset;
+        offset.x = readU32();
+        offset.y = readU32();
+        offset.z = readU32();
+        return offset;
+    }
+
+    Extent3D readExtent3D()
+    {
+        Extent3D extent;
+        extent.width = readU32();
+        extent.height = readU32();
+        extent.depth = readU32();
+        return extent;
+    }
+
+    SubresourceRange readSubresourceRange()
+    {
+        SubresourceRange range;
+        range.layer = readU32();
+        range.layerCount = readU32();
+        range.mip = readU32();
+        range.mipCount = readU32();
+        return range;
+    }
+
+    SubresourceLayout readSubresourceLayout()
+    {
+        SubresourceLayout layout;
+        layout.size = readExtent3D();
+        layout.colPitch = readU64();
+        layout.rowPitch = readU64();
+        layout.slicePitch = readU64();
+        layout.sizeInBytes = readU64();
+        layout.blockWidth = readU64();
+        layout.blockHeight = readU64();
+        layout.rowCount = readU64();
+        return layout;
+    }
+
+    MarkerColor readMarkerColor()
+    {
+        MarkerColor color;
+        color.r = readF32();
+        color.g = readF32();
+        color.b = readF32();
+        return color;
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+    bool m_failed = false;
+};
+
+namespace {
+
+class CaptureWriter
+{
+public:
+    CaptureWriter(Device* device)
+        : m_device(device)
+    {
+    }
+
+    Result writeCommand(const CommandList& commandList, const CommandList::CommandSlot* slot);
+
+    ComPtr<ISlangBlob> finish();
+
+private:
+    Device* m_device;
+    std::unordered_map<const void*, uint32_t> m_objectIndices;
+    CaptureStreamWriter m_objects;
+    CaptureStreamWriter m_commands;
+    uint32_t m_objectCount = 0;
+    uint32_t m_commandCount = 0;
+    /// Payload of the object record being written.
+    /// Objects are added while writing the command referencing them, so they have their own payload.
+    CaptureStreamWriter m_objectPayload;
+    /// Payload of the command record being written.
+    CaptureStreamWriter m_commandPayload;
+
+    static void writeRecord(CaptureStreamWriter& dst, uint32_t type, const CaptureStreamWriter& payload)
+    {
+        dst.writeU32(type);
+        dst.writeU32(uint32_t(payload.data.size()));
+        dst.writeBytes(payload.data.data(), payload.data.size());
+    }
+
+    /// Add an object record with the current payload.
+    uint32_t addObject(const void* key, CaptureObjectType type)
+    {
+        uint32_t index = m_objectCount++;
+        m_objectIndices[key] = index;
+        writeRecord(m_objects, uint32_t(type), m_objectPayload);
+        return index;
+    }
+
+    bool findObject(const void* key, uint32_t& outIndex) const
+    {
+        auto it = m_objectIndices.find(key);
+        if (it == m_objectIndices.end())
+            return false;
+        outIndex = it->second;
+        return true;
+    }
+
+    uint32_t addBuffer(IBuffer* buffer)
+    {
+        uint32_t index;
+        if (findObject(buffer, index))
+            return index;
+        const BufferDesc& desc = checked_cast<Buffer*>(buffer)->m_desc;
+        m_objectPayload.data.clear();
+        m_objectPayload.writeU64(desc.size);
+        m_objectPayload.writeU32(desc.elementSize);
+        m_objectPayload.writeEnum(desc.format);
+        m_objectPayload.writeEnum(desc.memoryType);
+        m_objectPayload.writeEnum(desc.usage);
+        m_objectPayload.writeEnum(desc.defaultState);
+        return addObject(buffer, CaptureObjectType::Buffer);
+    }
+
+    uint32_t addTexture(ITexture* texture)
+    {
+        uint32_t index;
+        if (findObject(texture, index))
+            return index;
+        const TextureDesc& desc = checked_cast<Texture*>(texture)->m_desc;
+        m_objectPayload.data.clear();
+        m_objectPayload.writeEnum(desc.type);
+        m_objectPayload.writeExtent3D(desc.size);
+        m_objectPayload.writeU32(desc.arrayLength);
+        m_objectPayload.writeU32(desc.mipCount);
+        m_objectPayload.writeEnum(desc.format);
+        m_objectPayload.writeU32(desc.sampleCount);
+        m_objectPayload.writeU32(desc.sampleQuality);
+        m_objectPayload.writeEnum(desc.memoryType);
+        m_objectPayload.writeEnum(desc.usage);
+        m_objectPayload.writeEnum(desc.defaultState);
+        return addObject(texture, CaptureObjectType::Texture);
+    }
+
+    uint32_t addTextureView(ITextureView* textureView)
+    {
+        uint32_t index;
+        if (findObject(textureView, index))
+            return index;
+        // The texture is added first, so it is created before the view on replay.
+        uint32_t textureIndex = addTexture(textureView->getTexture());
+        const TextureViewDesc& desc = checked_cast<TextureView*>(textureView)->m_desc;
+        m_objectPayload.data.clear();
+        m_objectPayload.writeU32(textureIndex);
+        m_objectPayload.writeEnum(desc.format);
+        m_objectPayload.writeEnum(desc.aspect);
+        m_objectPayload.writeSubresourceRange(desc.subresourceRange);
+        return addObject(textureView, CaptureObjectType::TextureView);
+    }
+
+    uint32_t addQueryPool(IQueryPool* queryPool)
+    {
+        uint32_t index;
+        if (findObject(queryPool, index))
+            return index;
+        const QueryPoolDesc& desc = queryPool->getDesc();
+        m_objectPayload.data.clear();
+        m_objectPayload.writeEnum(desc.type);
+        m_objectPayload.writeU32(desc.count);
+        return addObject(queryPool, CaptureObjectType::QueryPool);
+    }
+
+    void writeObject(IBuffer* buffer)
+    {
+        m_commandPayload.writeU32(buffer ? addBuffer(buffer) + 1 : 0);
+    }
+
+    void writeObject(ITexture* texture)
+    {
+        m_commandPayload.writeU32(texture ? addTexture(texture) + 1 : 0);
+    }
+
+    void writeObject(ITextureView* textureView)
+    {
+        m_commandPayload.writeU32(textureView ? addTextureView(textureView) + 1 : 0);
+    }
+
+    void writeObject(IQueryPool* queryPool)
+    {
+        m_commandPayload.writeU32(queryPool ? addQueryPool(queryPool) + 1 : 0);
+    }
+
+    void beginCommand() { m_commandPayload.data.clear(); }
+
+    void endCommand(CommandID id)
+    {
+        writeRecord(m_commands, uint32_t(id), m_commandPayload);
+        m_commandCount++;
+    }
+
+    /// Copy data staged in an upload buffer into the command payload.
+    Result writeBufferData(IBuffer* buffer, uint64_t offset, uint64_t size)
+    {
+        m_commandPayload.writeU64(size);
+        uint8_t* dst = m_commandPayload.reserveBytes(size);
+        // Staging heap pages are host-visible and usually stay mapped, so the data is copied directly.
+        Buffer* bufferImpl = checked_cast<Buffer*>(buffer);
+        void* mapped;
+        if (SLANG_SUCCEEDED(m_device->m_uploadHeap.mapPageBuffer(bufferImpl, &mapped)))
+        {
+            std::memcpy(dst, static_cast<const uint8_t*>(mapped) + offset, size);
+            return m_device->m_uploadHeap.unmapPageBuffer(bufferImpl);
+        }
+        // Upload buffers created by the application may be mapped by it, read them back through the device.
+        return m_device->readBuffer(buffer, offset, size, dst);
+    }
+};
+
+Result CaptureWriter::writeCommand(const CommandList& commandList, const CommandList::CommandSlot* slot)
+{
+    if (!isTransferCommand(slot->id))
+        return SLANG_E_NOT_AVAILABLE;
+
+    beginCommand();
+    switch (slot->id)
+    {
+    case CommandID::CopyBuffer:
+    {
+        const auto& cmd = commandList.getCommand<commands::CopyBuffer>(slot);
+        writeObject(cmd.dst);
+        m_commandPayload.writeU64(cmd.dstOffset);
+        m_commandPayload.writeU64(cmd.size);
+        // Data staged in upload buffers is stored inline.
+        bool isStaged = isUploadBuffer(cmd.src);
+        m_commandPayload.writeBool(isStaged);
+        if (isStaged)
+        {
+            SLANG_RETURN_ON_FAIL(writeBufferData(cmd.src, cmd.srcOffset, cmd.size));
+        }
+        else
+        {
+            writeObject(cmd.src);
+            m_commandPayload.writeU64(cmd.srcOffset);
+        }
+        break;
+    }
+    case CommandID::CopyTexture:
+    {
+        const auto& cmd = commandList.getCommand<commands::CopyTexture>(slot);
+        writeObject(cmd.dst);
+        m_commandPayload.writeSubresourceRange(cmd.dstSubresource);
+        m_commandPayload.writeOffset3D(cmd.dstOffset);
+        writeObject(cmd.src);
+        m_commandPayload.writeSubresourceRange(cmd.srcSubresource);
+        m_commandPayload.writeOffset3D(cmd.srcOffset);
+        m_commandPayload.writeExtent3D(cmd.extent);
+        break;
+    }
+    case CommandID::CopyTextureToBuffer:
+    {
+        const auto& cmd = commandList.getCommand<commands::CopyTextureToBuffer>(slot);
+        writeObject(cmd.dst);
+        m_commandPayload.writeU64(cmd.dstOffset);
+        m_commandPayload.writeU64(cmd.dstSize);
+        m_commandPayload.writeU64(cmd.dstRowPitch);
+        writeObject(cmd.src);
+        m_commandPayload.writeU32(cmd.srcLayer);
+        m_commandPayload.writeU32(cmd.srcMip);
+        m_commandPayload.writeOffset3D(cmd.srcOffset);
+        m_commandPayload.writeExtent3D(cmd.extent);
+        break;
+    }
+    case CommandID::ClearBuffer:
+    {
+        const auto& cmd = commandList.getCommand<commands::ClearBuffer>(slot);
+        writeObject(cmd.buffer);
+        m_commandPayload.writeU64(cmd.range.offset);
+        m_commandPayload.writeU64(cmd.range.size);
+        break;
+    }
+    case CommandID::ClearTextureFloat:
+    {
+        const auto& cmd = commandList.getCommand<commands::ClearTextureFloat>(slot);
+        writeObject(cmd.texture);
+        m_commandPayload.writeSubresourceRange(cmd.subresourceRange);
+        for (float value : cmd.clearValue)
+            m_commandPayload.writeF32(value);
+        break;
+    }
+    case CommandID::ClearTextureUint:
+    {
+        const auto& cmd = commandList.getCommand<commands::ClearTextureUint>(slot);
+        writeObject(cmd.texture);
+        m_commandPayload.writeSubresourceRange(cmd.subresourceRange);
+        for (uint32_t value : cmd.clearValue)
+            m_commandPayload.writeU32(value);
+        break;
+    }
+    case CommandID::ClearTextureDepthStencil:
+    {
+        const auto& cmd = commandList.getCommand<commands::ClearTextureDepthStencil>(slot);
+        writeObject(cmd.texture);
+        m_commandPayload.writeSubresourceRange(cmd.subresourceRange);
+        m_commandPayload.writeBool(cmd.clearDepth);
+        m_commandPayload.writeF32(cmd.depthValue);
+        m_commandPayload.writeBool(cmd.clearStencil);
+        m_commandPayload.writeU8(cmd.stencilValue);
+        break;
+    }
+    case CommandID::UploadTextureData:
+    {
+        const auto& cmd = commandList.getCommand<commands::UploadTextureData>(slot);
+        writeObject(cmd.dst);
+        m_commandPayload.writeSubresourceRange(cmd.subresourceRange);
+        m_commandPayload.writeOffset3D(cmd.offset);
+        m_commandPayload.writeExtent3D(cmd.extent);
+        uint32_t layoutCount = cmd.subresourceRange.layerCount * cmd.subresourceRange.mipCount;
+        uint64_t dataSize = 0;
+        m_commandPayload.writeU32(layoutCount);
+        for (uint32_t i = 0; i < layoutCount; ++i)
+        {
+            m_commandPayload.writeSubresourceLayout(cmd.layouts[i]);
+            dataSize += cmd.layouts[i].sizeInBytes;
+        }
+        // Data staged in upload buffers is stored inline, one subresource after the other.
+        bool isStaged = isUploadBuffer(cmd.srcBuffer);
+        m_commandPayload.writeBool(isStaged);
+        if (isStaged)
+        {
+            SLANG_RETURN_ON_FAIL(writeBufferData(cmd.srcBuffer, cmd.srcOffset, dataSize));
+        }
+        else
+        {
+            writeObject(cmd.srcBuffer);
+            m_commandPayload.writeU64(cmd.srcOffset);
+        }
+        break;
+    }
+    case CommandID::ResolveQuery:
+    {
+        const auto& cmd = commandList.getCommand<commands::ResolveQuery>(slot);
+        writeObject(cmd.queryPool);
+        m_commandPayload.writeU32(cmd.index);
+        m_commandPayload.writeU32(cmd.count);
+        writeObject(cmd.buffer);
+        m_commandPayload.writeU64(cmd.offset);
+        break;
+    }
+    case CommandID::BeginRenderPass:
+    {
+        const auto& cmd = commandList.getCommand<commands::BeginRenderPass>(slot);
+        uint32_t colorAttachmentCount = cmd.desc.colorAttachments ? cmd.desc.colorAttachmentCount : 0;
+        m_commandPayload.writeU32(colorAttachmentCount);
+        for (uint32_t i = 0; i < colorAttachmentCount; ++i)
+        {
+            const RenderPassColorAttachment& attachment = cmd.desc.colorAttachments[i];
+            writeObject(attachment.view);
+            writeObject(attachment.resolveTarget);
+            m_commandPayload.writeEnum(attachment.loadOp);
+            m_commandPayload.writeEnum(attachment.storeOp);
+            for (float value : attachment.clearValue)
+                m_commandPayload.writeF32(value);
+        }
+        const RenderPassDepthStencilAttachment* depthStencil = cmd.desc.depthStencilAttachment;
+        m_commandPayload.writeBool(depthStencil != nullptr);
+        if (depthStencil)
+        {
+            writeObject(depthStencil->view);
+            m_commandPayload.writeEnum(depthStencil->depthLoadOp);
+            m_commandPayload.writeEnum(depthStencil->depthStoreOp);
+            m_commandPayload.writeF32(depthStencil->depthClearValue);
+            m_commandPayload.writeBool(depthStencil->depthReadOnly);
+            m_commandPayload.writeEnum(depthStencil->stencilLoadOp);
+            m_commandPayload.writeEnum(depthStencil->stencilStoreOp);
+            m_commandPayload.writeU8(depthStencil->stencilClearValue);
+            m_commandPayload.writeBool(depthStencil->stencilReadOnly);
+        }
+        break;
+    }
+    case CommandID::SetBufferState:
+    {
+        const auto& cmd = commandList.getCommand<commands::SetBufferState>(slot);
+        writeObject(cmd.buffer);
+        m_commandPayload.writeEnum(cmd.state);
+        break;
+    }
+    case CommandID::SetTextureState:
+    {
+        const auto& cmd = commandList.getCommand<commands::SetTextureState>(slot);
+        writeObject(cmd.texture);
+        m_commandPayload.writeSubresourceRange(cmd.subresourceRange);
+        m_commandPayload.writeEnum(cmd.state);
+        break;
+    }
+    case CommandID::PushDebugGroup:
+    {
+        const auto& cmd = commandList.getCommand<commands::PushDebugGroup>(slot);
+        m_commandPayload.writeString(cmd.name);
+        m_commandPayload.writeMarkerColor(cmd.color);
+        break;
+    }
+    case CommandID::InsertDebugMarker:
+    {
+        const auto& cmd = commandList.getCommand<commands::InsertDebugMarker>(slot);
+        m_commandPayload.writeString(cmd.name);
+        m_commandPayload.writeMarkerColor(cmd.color);
+        break;
+    }
+    case CommandID::WriteTimestamp:
+    {
+        const auto& cmd = commandList.getCommand<commands::WriteTimestamp>(slot);
+        writeObject(cmd.queryPool);
+        m_commandPayload.writeU32(cmd.queryIndex);
+        break;
+    }
+    default:
+        // Commands without parameters are recorded without payload.
+        break;
+    }
+    endCommand(slot->id);
+    return SLANG_OK;
+}
+
+ComPtr<ISlangBlob> CaptureWriter::finish()
+{
+    CaptureStreamWriter header;
+    header.writeU32(kCaptureMagic);
+    header.writeU32(kCaptureVersion);
+    header.writeU32(m_objectCount);
+    header.writeU32(m_commandCount);
+
+    size_t size = header.data.size() + m_objects.data.size() + m_commands.data.size();
+    ComPtr<ISlangBlob> blob = OwnedBlob::create(size);
+    uint8_t* dst = (uint8_t*)blob->getBufferPointer();
+    auto append = [&](const CaptureStreamWriter& part)
+    {
+        if (!part.data.empty())
+            std::memcpy(dst, part.data.data(), part.data.size());
+        dst += part.data.size();
+    };
+    append(header);
+    append(m_objects);
+    append(m_commands);
+    return blob;
+}
+
+} // namespace
+
+Result captureTransferCommands(Device* device, const CommandList& commandList, ISlangBlob** outBlob)
+{
+    CaptureWriter writer(device);
+    for (const CommandList::CommandSlot* slot : commandList)
+    {
+        SLANG_RETURN_ON_FAIL(writer.writeCommand(commandList, slot));
+    }
+    ComPtr<ISlangBlob> blob = writer.finish();
+    returnComPtr(outBlob, blob);
+    return SLANG_OK;
+}
+
+// CaptureReplayer
+
+Result CaptureReplayer::load(const void* data, size_t size)
+{
+    m_objects.clear();
+    m_commands.clear();
+    m_timings.clear();
+
+    if (!data)
+        return SLANG_E_INVALID_ARG;
+    m_data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+
+    CaptureStreamReader reader(m_data.data(), m_data.size());
+    uint32_t magic = reader.readU32();
+    uint32_t version = reader.readU32();
+    if (reader.isFailed())
+        return SLANG_E_INVALID_ARG;
+    if (magic != kCaptureMagic || version != kCaptureVersion)
+        return SLANG_E_NOT_AVAILABLE;
+    uint32_t objectCount = reader.readU32();
+    uint32_t commandCount = reader.readU32();
+
+    auto readRecord = [&](uint32_t& outType, const uint8_t*& outData, uint32_t& outSize) -> bool
+    {
+        outType = reader.readU32();
+        outSize = reader.readU32();
+        outData = reader.readBytes(outSize);
+        return !reader.isFailed();
+    };
+
+    for (uint32_t i = 0; i < objectCount; ++i)
+    {
+        Object object;
+        uint32_t type;
+        if (!readRecord(type, object.data, object.size) || type >= kCaptureObjectTypeCount)
+            return SLANG_FAIL;
+        object.type = CaptureObjectType(type);
+        m_objects.push_back(object);
+    }
+
+    for (uint32_t i = 0; i < commandCount; ++i)
+    {
+        Command command;
+        uint32_t type;
+        if (!readRecord(type, command.data, command.size) || type >= kCommandCount ||
+            !isTransferCommand(CommandID(type)))
+            return SLANG_FAIL;
+        command.id = CommandID(type);
+        m_commands.push_back(command);
+    }
+
+    return SLANG_OK;
+}
+
+Result CaptureReplayer::createObjects(IDevice* device)
+{
+    for (size_t i = 0; i < m_objects.size(); ++i)
+    {
+        Object& object = m_objects[i];
+        CaptureStreamReader reader(object.data, object.size);
+        switch (object.type)
+        {
+        case CaptureObjectType::Buffer:
+        {
+            BufferDesc desc;
+            desc.size = reader.readU64();
+            desc.elementSize = reader.readU32();
+            desc.format = reader.readEnum<Format>();
+            desc.memoryType = reader.readEnum<MemoryType>();
+            desc.usage = reader.readEnum<BufferUsage>();
+            desc.defaultState = reader.readEnum<ResourceState>();
+            if (reader.isFailed())
+                return SLANG_FAIL;
+            SLANG_RETURN_ON_FAIL(device->createBuffer(desc, nullptr, object.buffer.writeRef()));
+            break;
+        }
+        case CaptureObjectType::Texture:
+        {
+            TextureDesc desc;
+            desc.type = reader.readEnum<TextureType>();
+            desc.size = reader.readExtent3D();
+            desc.arrayLength = reader.readU32();
+            desc.mipCount = reader.readU32();
+            desc.format = reader.readEnum<Format>();
+            desc.sampleCount = reader.readU32();
+            desc.sampleQuality = reader.readU32();
+            desc.memoryType = reader.readEnum<MemoryType>();
+            desc.usage = reader.readEnum<TextureUsage>();
+            desc.defaultState = reader.readEnum<ResourceState>();
+            if (reader.isFailed())
+                return SLANG_FAIL;
+            SLANG_RETURN_ON_FAIL(device->createTexture(desc, nullptr, object.texture.writeRef()));
+            break;
+        }
+        case CaptureObjectType::TextureView:
+        {
+            uint32_t textureIndex = reader.readU32();
+            TextureViewDesc desc;
+            desc.format = reader.readEnum<Format>();
+            desc.aspect = reader.readEnum<TextureAspect>();
+            desc.subresourceRange = reader.readSubresourceRange();
+            if (reader.isFailed() || textureIndex >= i || m_objects[textureIndex].type != CaptureObjectType::Texture)
+                return SLANG_FAIL;
+            SLANG_RETURN_ON_FAIL(
+                device->createTextureView(m_objects[textureIndex].texture, desc, object.textureView.writeRef())
+            );
+            break;
+        }
+        case CaptureObjectType::QueryPool:
+        {
+            QueryPoolDesc desc;
+            desc.type = reader.readEnum<QueryType>();
+            desc.count = reader.readU32();
+            if (reader.isFailed())
+                return SLANG_FAIL;
+            SLANG_RETURN_ON_FAIL(device->createQueryPool(desc, object.queryPool.writeRef()));
+            break;
+        }
+        }
+    }
+    return SLANG_OK;
+}
+
+Result CaptureReplayer::replay(ICommandQueue* queue, bool perCommand, double* outTotalTimeMS)
+{
+    m_timings.assign(m_commands.size(), {});
+    m_renderPassEncoder = nullptr;
+    m_computePassEncoder = nullptr;
+    m_rayTracingPassEncoder = nullptr;
+
+    Timer totalTimer;
+    Timer unitTimer;
+    ComPtr<ICommandEncoder> encoder;
+    size_t unitStart = 0;
+    for (size_t i = 0; i < m_commands.size(); ++i)
+    {
+        if (!encoder)
+        {
+            SLANG_RETURN_ON_FAIL(queue->createCommandEncoder(encoder.writeRef()));
+            unitStart = i;
+            unitTimer.reset();
+        }
+
+        CommandTiming& timing = m_timings[i];
+        timing.id = m_commands[i].id;
+        Timer encodeTimer;
+        SLANG_RETURN_ON_FAIL(encodeCommand(encoder, m_commands[i]));
+        timing.encodeTimeUS = encodeTimer.elapsedUS();
+
+        bool last = i + 1 == m_commands.size();
+        if (last || (perCommand && !getPassEncoder()))
+        {
+            // Close a pass left open by a truncated capture.
+            if (IPassEncoder* passEncoder = getPassEncoder())
+                passEncoder->end();
+            m_renderPassEncoder = nullptr;
+            m_computePassEncoder = nullptr;
+            m_rayTracingPassEncoder = nullptr;
+
+            ComPtr<ICommandBuffer> commandBuffer;
+            SLANG_RETURN_ON_FAIL(encoder->finish(commandBuffer.writeRef()));
+            SLANG_RETURN_ON_FAIL(queue->submit(commandBuffer));
+            SLANG_RETURN_ON_FAIL(queue->waitOnHost());
+            if (perCommand)
+                m_timings[unitStart].executeTimeMS = unitTimer.elapsedMS();
+            encoder = nullptr;
+        }
+    }
+
+    if (outTotalTimeMS)
+        *outTotalTimeMS = totalTimer.elapsedMS();
+    return SLANG_OK;
+}
+
+IPassEncoder* CaptureReplayer::getPassEncoder() const
+{
+    if (m_renderPassEncoder)
+        return m_renderPassEncoder;
+    if (m_computePassEncoder)
+        return m_computePassEncoder;
+    return m_rayTracingPassEncoder;
+}
+
+template<typename T>
+T* CaptureReplayer::readObject(CaptureStreamReader& reader) const
+{
+    uint32_t encoded = reader.readU32();
+    if (encoded == 0)
+        return nullptr;
+    uint32_t index = encoded - 1;
+    T* object = nullptr;
+    if (index < m_objects.size())
+    {
+        const Object& entry = m_objects[index];
+        if constexpr (std::is_same_v<T, IBuffer>)
+            object = entry.buffer;
+        else if constexpr (std::is_same_v<T, ITexture>)
+            object = entry.texture;
+        else if constexpr (std::is_same_v<T, ITextureView>)
+            object = entry.textureView;
+        else if constexpr (std::is_same_v<T, IQueryPool>)
+            object = entry.queryPool;
+    }
+    // The object does not exist or has a different type.
+    if (!object)
+        reader.fail();
+    return object;
+}
+
+Result CaptureReplayer::encodeCommand(ICommandEncoder* encoder, const Command& command)
+{
+    // Commands are only encoded after all their fields were read successfully.
+    CaptureStreamReader reader(command.data, command.size);
+
+    switch (command.id)
+    {
+    case CommandID::CopyBuffer:
+    {
+        IBuffer* dst = readObject<IBuffer>(reader);
+        uint64_t dstOffset = reader.readU64();
+        uint64_t size = reader.readU64();
+        if (reader.readBool())
+        {
+            // Staged data is stored inline.
+            uint64_t dataSize = reader.readU64();
+            const uint8_t* data = reader.readBytes(dataSize);
+            if (reader.isFailed() || !dst || dataSize != size)
+                return SLANG_FAIL;
+            SLANG_RETURN_ON_FAIL(encoder->uploadBufferData(dst, dstOffset, size, data));
+        }
+        else
+        {
+            IBuffer* src = readObject<IBuffer>(reader);
+            uint64_t srcOffset = reader.readU64();
+            if (reader.isFailed() || !dst || !src)
+                return SLANG_FAIL;
+            encoder->copyBuffer(dst, dstOffset, src, srcOffset, size);
+        }
+        break;
+    }
+    case CommandID::CopyTexture:
+    {
+        ITexture* dst = readObject<ITexture>(reader);
+        SubresourceRange dstSubresource = reader.readSubresourceRange();
+        Offset3D dstOffset = reader.readOffset3D();
+        ITexture* src = readObject<ITexture>(reader);
+        SubresourceRange srcSubresource = reader.readSubresourceRange();
+        Offset3D srcOffset = reader.readOffset3D();
+        Extent3D extent = reader.readExtent3D();
+        if (reader.isFailed() || !dst || !src)
+            return SLANG_FAIL;
+        encoder->copyTexture(dst, dstSubresource, dstOffset, src, srcSubresource, srcOffset, extent);
+        break;
+    }
+    case CommandID::CopyTextureToBuffer:
+    {
+        IBuffer* dst = readObject<IBuffer>(reader);
+        uint64_t dstOffset = reader.readU64();
+        uint64_t dstSize = reader.readU64();
+        uint64_t dstRowPitch = reader.readU64();
+        ITexture* src = readObject<ITexture>(reader);
+        uint32_t srcLayer = reader.readU32();
+        uint32_t srcMip = reader.readU32();
+        Offset3D srcOffset = reader.readOffset3D();
+        Extent3D extent = reader.readExtent3D();
+        if (reader.isFailed() || !dst || !src)
+            return SLANG_FAIL;
+        encoder->copyTextureToBuffer(dst, dstOffset, dstSize, dstRowPitch, src, srcLayer, srcMip, srcOffset, extent);
+        break;
+    }
+    case CommandID::ClearBuffer:
+    {
+        IBuffer* buffer = readObject<IBuffer>(reader);
+        BufferRange range;
+        range.offset = reader.readU64();
+        range.size = reader.readU64();
+        if (reader.isFailed() || !buffer)
+            return SLANG_FAIL;
+        encoder->clearBuffer(buffer, range);
+        break;
+    }
+    case CommandID::ClearTextureFloat:
+    {
+        ITexture* texture = readObject<ITexture>(reader);
+        SubresourceRange subresourceRange = reader.readSubresourceRange();
+        float clearValue[4];
+        for (float& value : clearValue)
+            value = reader.readF32();
+        if (reader.isFailed() || !texture)
+            return SLANG_FAIL;
+        encoder->clearTextureFloat(texture, subresourceRange, clearValue);
+        break;
+    }
+    case CommandID::ClearTextureUint:
+    {
+        ITexture* texture = readObject<ITexture>(reader);
+        SubresourceRange subresourceRange = reader.readSubresourceRange();
+        uint32_t clearValue[4];
+        for (uint32_t& value : clearValue)
+            value = reader.readU32();
+        if (reader.isFailed() || !texture)
+            return SLANG_FAIL;
+        encoder->clearTextureUint(texture, subresourceRange, clearValue);
+        break;
+    }
+    case CommandID::ClearTextureDepthStencil:
+    {
+        ITexture* texture = readObject<ITexture>(reader);
+        SubresourceRange subresourceRange = reader.readSubresourceRange();
+        bool clearDepth = reader.readBool();
+        float depthValue = reader.readF32();
+        bool clearStencil = reader.readBool();
+        uint8_t stencilValue = reader.readU8();
+        if (reader.isFailed() || !texture)
+            return SLANG_FAIL;
+        encoder->clearTextureDepthStencil(
+            texture,
+            subresourceRange,
+            clearDepth,
+            depthValue,
+            clearStencil,
+            stencilValue
+        );
+        break;
+    }
+    case CommandID::UploadTextureData:
+    {
+        ITexture* dst = readObject<ITexture>(reader);
+        SubresourceRange subresourceRange = reader.readSubresourceRange();
+        Offset3D offset = reader.readOffset3D();
+        Extent3D extent = reader.readExtent3D();
+        uint32_t layoutCount = reader.readU32();
+        // Every layout takes more than one byte, this bounds the count before allocating.
+        if (reader.isFailed() || !dst || layoutCount == 0 || layoutCount > command.size)
+            return SLANG_FAIL;
+        short_vector<SubresourceLayout, 16> layouts(layoutCount);
+        for (SubresourceLayout& layout : layouts)
+            layout = reader.readSubresourceLayout();
+        if (!reader.readBool())
+        {
+            // Buffer to texture copies are recorded as single subresource uploads.
+            IBuffer* srcBuffer = readObject<IBuffer>(reader);
+            uint64_t srcOffset = reader.readU64();
+            if (reader.isFailed() || !srcBuffer)
+                return SLANG_FAIL;
+            encoder->copyBufferToTexture(
+                dst,
+                subresourceRange.layer,
+                subresourceRange.mip,
+                offset,
+                srcBuffer,
+                srcOffset,
+                layouts[0].sizeInBytes,
+                layouts[0].rowPitch,
+                extent
+            );
+        }
+        else
+        {
+            // Staged data is stored inline, one subresource after the other.
+            uint64_t dataSize = reader.readU64();
+            uint64_t layoutDataSize = 0;
+            short_vector<SubresourceData, 16> subresourceData(layoutCount);
+            for (uint32_t i = 0; i < layoutCount; ++i)
+            {
+                subresourceData[i].data = reader.readBytes(layouts[i].sizeInBytes);
+                subresourceData[i].rowPitch = layouts[i].rowPitch;
+                subresourceData[i].slicePitch = layouts[i].slicePitch;
+                layoutDataSize += layouts[i].sizeInBytes;
+            }
+            if (reader.isFailed() || dataSize != layoutDataSize)
+                return SLANG_FAIL;
+            SLANG_RETURN_ON_FAIL(
+                encoder->uploadTextureData(dst, subresourceRange, offset, extent, subresourceData.data(), layoutCount)
+            );
+        }
+        break;
+    }
+    case CommandID::ResolveQuery:
+    {
+        IQueryPool* queryPool = readObject<IQueryPool>(reader);
+        uint32_t index = reader.readU32();
+        uint32_t count = reader.readU32();
+        IBuffer* buffer = readObject<IBuffer>(reader);
+        uint64_t offset = reader.readU64();
+        if (reader.isFailed() || !queryPool || !buffer)
+            return SLANG_FAIL;
+        encoder->resolveQuery(queryPool, index, count, buffer, offset);
+        break;
+    }
+    case CommandID::BeginRenderPass:
+    {
+        RenderPassDesc desc;
+        uint32_t colorAttachmentCount = reader.readU32();
+        // Every attachment takes more than one byte, this bounds the count before allocating.
+        if (reader.isFailed() || colorAttachmentCount > command.size)
+            return SLANG_FAIL;
+        short_vector<RenderPassColorAttachment, 8> colorAttachments(colorAttachmentCount);
+        for (RenderPassColorAttachment& attachment : colorAttachments)
+        {
+            attachment.view = readObject<ITextureView>(reader);
+            attachment.resolveTarget = readObject<ITextureView>(reader);
+            attachment.loadOp = reader.readEnum<LoadOp>();
+            attachment.storeOp = reader.readEnum<StoreOp>();
+            for (float& value : attachment.clearValue)
+                value = reader.readF32();
+        }
+        if (colorAttachmentCount > 0)
+        {
+            desc.colorAttachments = colorAttachments.data();
+            desc.colorAttachmentCount = colorAttachmentCount;
+        }
+        RenderPassDepthStencilAttachment depthStencil;
+        if (reader.readBool())
+        {
+            depthStencil.view = readObject<ITextureView>(reader);
+            depthStencil.depthLoadOp = reader.readEnum<LoadOp>();
+            depthStencil.depthStoreOp = reader.readEnum<StoreOp>();
+            depthStencil.depthClearValue = reader.readF32();
+            depthStencil.depthReadOnly = reader.readBool();
+            depthStencil.stencilLoadOp = reader.readEnum<LoadOp>();
+            depthStencil.stencilStoreOp = reader.readEnum<StoreOp>();
+            depthStencil.stencilClearValue = reader.readU8();
+            depthStencil.stencilReadOnly = reader.readBool();
+            desc.depthStencilAttachment = &depthStencil;
+        }
+        if (reader.isFailed())
+            return SLANG_FAIL;
+        m_renderPassEncoder = encoder->beginRenderPass(desc);
+        break;
+    }
+    case CommandID::EndRenderPass:
+        if (m_renderPassEncoder)
+            m_renderPassEncoder->end();
+        m_renderPassEncoder = nullptr;
+        break;
+    case CommandID::BeginComputePass:
+        m_computePassEncoder = encoder->beginComputePass();
+        break;
+    case CommandID::EndComputePass:
+        if (m_computePassEncoder)
+            m_computePassEncoder->end();
+        m_computePassEncoder = nullptr;
+        break;
+    case CommandID::BeginRayTracingPass:
+        m_rayTracingPassEncoder = encoder->beginRayTracingPass();
+        break;
+    case CommandID::EndRayTracingPass:
+        if (m_rayTracingPassEncoder)
+            m_rayTracingPassEncoder->end();
+        m_rayTracingPassEncoder = nullptr;
+        break;
+    case CommandID::SetBufferState:
+    {
+        IBuffer* buffer = readObject<IBuffer>(reader);
+        ResourceState state = reader.readEnum<ResourceState>();
+        if (reader.isFailed() || !buffer)
+            return SLANG_FAIL;
+        encoder->setBufferState(buffer, state);
+        break;
+    }
+    case CommandID::SetTextureState:
+    {
+        ITexture* texture = readObject<ITexture>(reader);
+        SubresourceRange subresourceRange = reader.readSubresourceRange();
+        ResourceState state = reader.readEnum<ResourceState>();
+        if (reader.isFailed() || !texture)
+            return SLANG_FAIL;
+        encoder->setTextureState(texture, subresourceRange, state);
+        break;
+    }
+    case CommandID::GlobalBarrier:
+        encoder->globalBarrier();
+        break;
+    case CommandID::PushDebugGroup:
+    case CommandID::InsertDebugMarker:
+    {
+        std::string nameStorage;
+        const char* name = reader.readString(nameStorage);
+        MarkerColor color = reader.readMarkerColor();
+        if (reader.isFailed())
+            return SLANG_FAIL;
+        IPassEncoder* passEncoder = getPassEncoder();
+        if (command.id == CommandID::PushDebugGroup)
+        {
+            if (passEncoder)
+                passEncoder->pushDebugGroup(name, color);
+            else
+                encoder->pushDebugGroup(name, color);
+        }
+        else
+        {
+            if (passEncoder)
+                passEncoder->insertDebugMarker(name, color);
+            else
+                encoder->insertDebugMarker(name, color);
+        }
+        break;
+    }
+    case CommandID::PopDebugGroup:
+        if (IPassEncoder* passEncoder = getPassEncoder())
+            passEncoder->popDebugGroup();
+        else
+            encoder->popDebugGroup();
+        break;
+    case CommandID::WriteTimestamp:
+    {
+        IQueryPool* queryPool = readObject<IQueryPool>(reader);
+        uint32_t queryIndex = reader.readU32();
+        if (reader.isFailed() || !queryPool)
+            return SLANG_FAIL;
+        if (IPassEncoder* passEncoder = getPassEncoder())
+            passEncoder->writeTimestamp(queryPool, queryIndex);
+        else
+            encoder->writeTimestamp(queryPool, queryIndex);
+        break;
+    }
+    default:
+        // Other commands are rejected by `load`.
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+} // namespace rhi
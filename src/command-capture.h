@@ -0,0 +1,120 @@
+#pragma once
+
+#include <slang-rhi.h>
+
+#include "core/common.h"
+
+#include "command-list.h"
+#include "rhi-shared-fwd.h"
+
+#include <vector>
+
+namespace rhi {
+
+/// Binary capture of the transfer commands of a command list.
+///
+/// Every value is serialized explicitly, field by field, in little-endian byte order: integers and enums as
+/// fixed-size integers, floats as their IEEE-754 bits and booleans as a single byte. The format therefore does not
+/// depend on struct layouts, the pointer size or the byte order of the host.
+///
+/// A capture starts with the magic, version, object count and command count (uint32 each), followed by
+/// `objectCount` object records and `commandCount` command records. Each record starts with the record type
+/// (`CaptureObjectType` or `CommandID`) and the size of the payload following it (uint32 each).
+///
+/// Object records hold the descriptors of buffers, textures, texture views and query pools referenced by commands.
+/// Commands refer to objects by index + 1, so 0 means null. Resource contents are not captured, except for data
+/// staged in upload buffers by `uploadBufferData` and `uploadTextureData`, which is stored inline with the command.
+///
+/// Only transfer commands (copies, clears, uploads, query resolves and timestamps), pass boundaries, state changes,
+/// barriers and debug markers are captured. Programs and shader objects are not, so command lists with pipeline
+/// state, draws, dispatches, acceleration structure and cooperative vector operations or execute callbacks cannot be
+/// captured.
+static constexpr uint32_t kCaptureMagic = 0x50435253; // "SRCP"
+static constexpr uint32_t kCaptureVersion = 2;
+
+enum class CaptureObjectType : uint32_t
+{
+    Buffer,
+    Texture,
+    TextureView,
+    QueryPool,
+};
+
+class CaptureStreamReader;
+
+/// Serialize a finished command list.
+/// Copies staged upload data, so this must be called before the command buffer is submitted (or on a reusable
+/// command buffer). Returns `SLANG_E_NOT_AVAILABLE` if the command list contains commands that cannot be captured.
+Result captureTransferCommands(Device* device, const CommandList& commandList, ISlangBlob** outBlob);
+
+/// Replays a transfer command capture on any device through the public API.
+class CaptureReplayer
+{
+public:
+    struct CommandTiming
+    {
+        CommandID id;
+        /// CPU time spent encoding the command in microseconds.
+        double encodeTimeUS;
+        /// Time from encoding to completion in milliseconds, measured by `replay` with `perCommand`.
+        /// Commands inside a pass report the time of the whole pass on the command beginning the pass.
+        double executeTimeMS;
+    };
+
+    /// Parse and validate a capture. The data is copied.
+    Result load(const void* data, size_t size);
+
+    /// Create the captured objects on a device.
+    Result createObjects(IDevice* device);
+
+    /// Encode and submit the captured commands to a queue and wait for completion.
+    /// If `perCommand` is set, every command outside a pass and every pass is submitted and waited for on its own
+    /// to measure its execution time.
+    /// Returns the total time from the start of encoding to completion in milliseconds in `outTotalTimeMS`.
+    Result replay(ICommandQueue* queue, bool perCommand, double* outTotalTimeMS = nullptr);
+
+    uint32_t getObjectCount() const { return uint32_t(m_objects.size()); }
+    CaptureObjectType getObjectType(uint32_t index) const { return m_objects[index].type; }
+    IBuffer* getBuffer(uint32_t index) const { return m_objects[index].buffer; }
+    ITexture* getTexture(uint32_t index) const { return m_objects[index].texture; }
+
+    uint32_t getCommandCount() const { return uint32_t(m_commands.size()); }
+    const std::vector<CommandTiming>& getTimings() const { return m_timings; }
+
+private:
+    struct Object
+    {
+        CaptureObjectType type;
+        const uint8_t* data;
+        uint32_t size;
+        ComPtr<IBuffer> buffer;
+        ComPtr<ITexture> texture;
+        ComPtr<ITextureView> textureView;
+        ComPtr<IQueryPool> queryPool;
+    };
+
+    struct Command
+    {
+        CommandID id;
+        const uint8_t* data;
+        uint32_t size;
+    };
+
+    std::vector<uint8_t> m_data;
+    std::vector<Object> m_objects;
+    std::vector<Command> m_commands;
+    std::vector<CommandTiming> m_timings;
+
+    IRenderPassEncoder* m_renderPassEncoder = nullptr;
+    IComputePassEncoder* m_computePassEncoder = nullptr;
+    IRayTracingPassEncoder* m_rayTracingPassEncoder = nullptr;
+
+    IPassEncoder* getPassEncoder() const;
+    Result encodeCommand(ICommandEncoder* encoder, const Command& command);
+
+    /// Read an object reference. Invalid references fail the reader.
+    template<typename T>
+    T* readObject(CaptureStreamReader& reader) const;
+};
+
+} // namespace rhi
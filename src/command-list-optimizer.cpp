@@ -0,0 +1,210 @@
+#include "command-list-optimizer.h"
+
+#include "command-list.h"
+
+#include <cstring>
+#include <vector>
+
+namespace rhi {
+
+namespace {
+
+template<typename T>
+inline bool arraysEqual(uint32_t countA, uint32_t countB, const T* a, const T* b)
+{
+    return (countA == countB) ? std::memcmp(a, b, countA * sizeof(T)) == 0 : false;
+}
+
+inline bool isSameRenderState(const RenderState& a, const RenderState& b)
+{
+    if (a.stencilRef != b.stencilRef || !(a.indexBuffer == b.indexBuffer) || a.indexFormat != b.indexFormat)
+        return false;
+    if (!arraysEqual(a.viewportCount, b.viewportCount, a.viewports, b.viewports) ||
+        !arraysEqual(a.scissorRectCount, b.scissorRectCount, a.scissorRects, b.scissorRects))
+        return false;
+    if (a.vertexBufferCount != b.vertexBufferCount)
+        return false;
+    for (uint32_t i = 0; i < a.vertexBufferCount; ++i)
+    {
+        if (!(a.vertexBuffers[i] == b.vertexBuffers[i]))
+            return false;
+    }
+    return true;
+}
+
+class CommandListOptimizer
+{
+public:
+    CommandListOptimizer(CommandList* commandList)
+        : m_commandList(commandList)
+    {
+    }
+
+    uint32_t optimize()
+    {
+        uint32_t commandCount = 0;
+        for (CommandList::CommandSlot* command : *m_commandList)
+        {
+            commandCount++;
+            if (visit(command))
+                m_commands.push_back(command);
+        }
+        uint32_t removedCount = commandCount - uint32_t(m_commands.size());
+        if (removedCount > 0)
+            m_commandList->setCommands(m_commands.data(), m_commands.size());
+        return removedCount;
+    }
+
+private:
+    CommandList* m_commandList;
+    /// Commands that are kept, in order.
+    std::vector<CommandList::CommandSlot*> m_commands;
+    /// Barrier commands kept since the last non-barrier command.
+    std::vector<CommandList::CommandSlot*> m_barrierRun;
+
+    const commands::SetRenderState* m_renderState = nullptr;
+    const commands::SetComputeState* m_computeState = nullptr;
+    const commands::SetRayTracingState* m_rayTracingState = nullptr;
+
+    void invalidateState()
+    {
+        m_renderState = nullptr;
+        m_computeState = nullptr;
+        m_rayTracingState = nullptr;
+    }
+
+    /// Returns true if the command is kept.
+    bool visit(CommandList::CommandSlot* command)
+    {
+        switch (command->id)
+        {
+        case CommandID::SetRenderState:
+        {
+            const auto& cmd = m_commandList->getCommand<commands::SetRenderState>(command);
+            if (m_renderState && m_renderState->pipeline == cmd.pipeline &&
+                m_renderState->specializationArgs == cmd.specializationArgs &&
+                m_renderState->bindingData == cmd.bindingData && isSameRenderState(m_renderState->state, cmd.state))
+            {
+                return false;
+            }
+            invalidateState();
+            m_renderState = &cmd;
+            m_barrierRun.clear();
+            return true;
+        }
+        case CommandID::SetComputeState:
+        {
+            const auto& cmd = m_commandList->getCommand<commands::SetComputeState>(command);
+            if (m_computeState && m_computeState->pipeline == cmd.pipeline &&
+                m_computeState->specializationArgs == cmd.specializationArgs &&
+                m_computeState->bindingData == cmd.bindingData)
+            {
+                return false;
+            }
+            invalidateState();
+            m_computeState = &cmd;
+            m_barrierRun.clear();
+            return true;
+        }
+        case CommandID::SetRayTracingState:
+        {
+            const auto& cmd = m_commandList->getCommand<commands::SetRayTracingState>(command);
+            if (m_rayTracingState && m_rayTracingState->pipeline == cmd.pipeline &&
+                m_rayTracingState->specializationArgs == cmd.specializationArgs &&
+                m_rayTracingState->shaderTable == cmd.shaderTable &&
+                m_rayTracingState->bindingData == cmd.bindingData)
+            {
+                return false;
+            }
+            invalidateState();
+            m_rayTracingState = &cmd;
+            m_barrierRun.clear();
+            return true;
+        }
+        case CommandID::SetBufferState:
+        {
+            const auto& cmd = m_commandList->getCommand<commands::SetBufferState>(command);
+            for (auto it = m_barrierRun.rbegin(); it != m_barrierRun.rend(); ++it)
+            {
+                if ((*it)->id != CommandID::SetBufferState)
+                    continue;
+                const auto& prev = m_commandList->getCommand<commands::SetBufferState>(*it);
+                if (prev.buffer != cmd.buffer)
+                    continue;
+                if (prev.state == cmd.state)
+                    return false;
+                break;
+            }
+            m_barrierRun.push_back(command);
+            return true;
+        }
+        case CommandID::SetTextureState:
+        {
+            const auto& cmd = m_commandList->getCommand<commands::SetTextureState>(command);
+            for (auto it = m_barrierRun.rbegin(); it != m_barrierRun.rend(); ++it)
+            {
+                if ((*it)->id != CommandID::SetTextureState)
+                    continue;
+                const auto& prev = m_commandList->getCommand<commands::SetTextureState>(*it);
+                if (prev.texture != cmd.texture)
+                    continue;
+                if (prev.state == cmd.state && prev.subresourceRange == cmd.subresourceRange)
+                    return false;
+                break;
+            }
+            m_barrierRun.push_back(command);
+            return true;
+        }
+        case CommandID::GlobalBarrier:
+        {
+            for (const CommandList::CommandSlot* prev : m_barrierRun)
+            {
+                if (prev->id == CommandID::GlobalBarrier)
+                    return false;
+            }
+            m_barrierRun.push_back(command);
+            return true;
+        }
+        case CommandID::PopDebugGroup:
+        {
+            // Drop the group if nothing was kept since it was pushed.
+            if (!m_commands.empty() && m_commands.back()->id == CommandID::PushDebugGroup)
+            {
+                m_commands.pop_back();
+                return false;
+            }
+            m_barrierRun.clear();
+            return true;
+        }
+        case CommandID::Draw:
+        case CommandID::DrawIndexed:
+        case CommandID::DrawIndirect:
+        case CommandID::DrawIndexedIndirect:
+        case CommandID::DrawMeshTasks:
+        case CommandID::DispatchCompute:
+        case CommandID::DispatchComputeIndirect:
+        case CommandID::DispatchRays:
+        case CommandID::PushDebugGroup:
+        case CommandID::InsertDebugMarker:
+        case CommandID::WriteTimestamp:
+            // These commands leave the bound state untouched.
+            m_barrierRun.clear();
+            return true;
+        default:
+            // Pass boundaries, callbacks and transfer commands invalidate the bound state.
+            invalidateState();
+            m_barrierRun.clear();
+            return true;
+        }
+    }
+};
+
+} // namespace
+
+uint32_t optimizeCommandList(CommandList* commandList)
+{
+    CommandListOptimizer optimizer(commandList);
+    return optimizer.optimize();
+}
+
+} // namespace rhi
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <slang-rhi.h>
+
+namespace rhi {
+
+class CommandList;
+
+/// Removes redundant commands from a command list with resolved pipelines.
+///
+/// - `SetComputeState`, `SetRenderState` and `SetRayTracingState` commands that are identical to the state
+///   currently active in the pass are removed. Backends already skip re-binding identical state, so this does not
+///   change the recorded barriers.
+/// - Within a run of consecutive barrier commands, transitions that repeat the previous transition of the same
+///   resource and repeated global barriers are removed.
+/// - Debug groups that are empty are removed.
+///
+/// Returns the number of removed commands.
+uint32_t optimizeCommandList(CommandList* commandList);
+
+} // namespace rhi
@@ -1,11 +1,27 @@
 #include "command-list.h"
 #include "rhi-shared.h"
+#include "command-profiler.h"
 
 namespace rhi {
 
+const char* getCommandName(CommandID id)
+{
+#define SLANG_RHI_COMMAND_NAME_X(x)                                                                                    \
+    case CommandID::x:                                                                                                 \
+        return commands::Traits<commands::x>::name;
+
+    switch (id)
+    {
+        SLANG_RHI_COMMANDS(SLANG_RHI_COMMAND_NAME_X)
+    }
+
+#undef SLANG_RHI_COMMAND_NAME_X
+    return "Unknown";
+}
+
 CommandList::CommandList(
     ArenaAllocator& allocator,
-    std::set<RefPtr<RefObject>>& trackedObjects,
+    RefObjectSet& trackedObjects,
     std::vector<ExecuteCallbackObjectRetainer>& trackedExecuteCallbackObjects
 )
     : m_allocator(allocator)
@@ -22,8 +38,51 @@ void CommandList::reset()
     m_writesTimestamp = false;
 }
 
+void CommandList::setCommands(CommandSlot* const* commands, size_t count)
+{
+    m_commandSlots = nullptr;
+    m_lastCommandSlot = nullptr;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (m_lastCommandSlot)
+        {
+            m_lastCommandSlot->next = commands[i];
+        }
+        else
+        {
+            m_commandSlots = commands[i];
+        }
+        m_lastCommandSlot = commands[i];
+    }
+    if (m_lastCommandSlot)
+    {
+        m_lastCommandSlot->next = nullptr;
+    }
+}
+
+void CommandList::splice(CommandSlot* position, CommandList& other)
+{
+    if (other.m_commandSlots)
+    {
+        CommandSlot*& next = position ? position->next : m_commandSlots;
+        other.m_lastCommandSlot->next = next;
+        if (!next)
+        {
+            m_lastCommandSlot = other.m_lastCommandSlot;
+        }
+        next = other.m_commandSlots;
+    }
+    for (const QueryWriteRange& range : other.m_queryWrites)
+    {
+        trackQueryWrite(range.queryPool, range.index, range.count);
+    }
+    m_writesTimestamp |= other.m_writesTimestamp;
+    other.reset();
+}
+
 void CommandList::write(commands::CopyBuffer&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::CopyBuffer);
     retainResource<Buffer>(cmd.dst);
     retainResource<Buffer>(cmd.src);
     writeCommand(std::move(cmd));
@@ -31,6 +90,7 @@ void CommandList::write(commands::CopyBuffer&& cmd)
 
 void CommandList::write(commands::CopyTexture&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::CopyTexture);
     retainResource<Texture>(cmd.dst);
     retainResource<Texture>(cmd.src);
     writeCommand(std::move(cmd));
@@ -38,6 +98,7 @@ void CommandList::write(commands::CopyTexture&& cmd)
 
 void CommandList::write(commands::CopyTextureToBuffer&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::CopyTextureToBuffer);
     retainResource<Buffer>(cmd.dst);
     retainResource<Texture>(cmd.src);
     writeCommand(std::move(cmd));
@@ -45,30 +106,35 @@ void CommandList::write(commands::CopyTextureToBuffer&& cmd)
 
 void CommandList::write(commands::ClearBuffer&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::ClearBuffer);
     retainResource<Buffer>(cmd.buffer);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::ClearTextureFloat&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::ClearTextureFloat);
     retainResource<Texture>(cmd.texture);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::ClearTextureUint&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::ClearTextureUint);
     retainResource<Texture>(cmd.texture);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::ClearTextureDepthStencil&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::ClearTextureDepthStencil);
     retainResource<Texture>(cmd.texture);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::UploadTextureData&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::UploadTextureData);
     retainResource<Texture>(cmd.dst);
     retainResource<Buffer>(cmd.srcBuffer);
     writeCommand(std::move(cmd));
@@ -76,6 +142,7 @@ void CommandList::write(commands::UploadTextureData&& cmd)
 
 void CommandList::write(commands::ResolveQuery&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::ResolveQuery);
     retainResource<QueryPool>(cmd.queryPool);
     retainResource<Buffer>(cmd.buffer);
     writeCommand(std::move(cmd));
@@ -83,6 +150,7 @@ void CommandList::write(commands::ResolveQuery&& cmd)
 
 void CommandList::write(commands::BeginRenderPass&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::BeginRenderPass);
     if (cmd.desc.colorAttachments && cmd.desc.colorAttachmentCount > 0)
     {
         cmd.desc.colorAttachments = (RenderPassColorAttachment*)
@@ -104,11 +172,13 @@ void CommandList::write(commands::BeginRenderPass&& cmd)
 
 void CommandList::write(commands::EndRenderPass&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::EndRenderPass);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::SetRenderState&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::SetRenderState);
     // Resources are already retained in the CommandEncoder
     // for (uint32_t i = 0; i < cmd.state.vertexBufferCount; ++i)
     //     retainResource<Buffer>(cmd.state.vertexBuffers[i].buffer);
@@ -119,16 +189,19 @@ void CommandList::write(commands::SetRenderState&& cmd)
 
 void CommandList::write(commands::Draw&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::Draw);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::DrawIndexed&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::DrawIndexed);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::DrawIndirect&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::DrawIndirect);
     retainResource<Buffer>(cmd.argBuffer.buffer);
     retainResource<Buffer>(cmd.countBuffer.buffer);
     writeCommand(std::move(cmd));
@@ -136,6 +209,7 @@ void CommandList::write(commands::DrawIndirect&& cmd)
 
 void CommandList::write(commands::DrawIndexedIndirect&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::DrawIndexedIndirect);
     retainResource<Buffer>(cmd.argBuffer.buffer);
     retainResource<Buffer>(cmd.countBuffer.buffer);
     writeCommand(std::move(cmd));
@@ -143,48 +217,57 @@ void CommandList::write(commands::DrawIndexedIndirect&& cmd)
 
 void CommandList::write(commands::DrawMeshTasks&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::DrawMeshTasks);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::BeginComputePass&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::BeginComputePass);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::EndComputePass&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::EndComputePass);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::SetComputeState&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::SetComputeState);
     retainResource<ComputePipeline>(cmd.pipeline);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::DispatchCompute&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::DispatchCompute);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::DispatchComputeIndirect&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::DispatchComputeIndirect);
     retainResource<Buffer>(cmd.argBuffer.buffer);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::BeginRayTracingPass&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::BeginRayTracingPass);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::EndRayTracingPass&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::EndRayTracingPass);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::SetRayTracingState&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::SetRayTracingState);
     retainResource<RayTracingPipeline>(cmd.pipeline);
     retainResource<ShaderTable>(cmd.shaderTable);
     writeCommand(std::move(cmd));
@@ -192,11 +275,13 @@ void CommandList::write(commands::SetRayTracingState&& cmd)
 
 void CommandList::write(commands::DispatchRays&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::DispatchRays);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::BuildAccelerationStructure&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::BuildAccelerationStructure);
     if (cmd.desc.inputs && cmd.desc.inputCount > 0)
     {
         cmd.desc.inputs = (AccelerationStructureBuildInput*)
@@ -271,6 +356,7 @@ void CommandList::write(commands::BuildAccelerationStructure&& cmd)
 
 void CommandList::write(commands::CopyAccelerationStructure&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::CopyAccelerationStructure);
     retainResource<AccelerationStructure>(cmd.dst);
     retainResource<AccelerationStructure>(cmd.src);
     writeCommand(std::move(cmd));
@@ -278,6 +364,7 @@ void CommandList::write(commands::CopyAccelerationStructure&& cmd)
 
 void CommandList::write(commands::QueryAccelerationStructureProperties&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::QueryAccelerationStructureProperties);
     if (cmd.accelerationStructures && cmd.accelerationStructureCount > 0)
     {
         cmd.accelerationStructures = (IAccelerationStructure**)
@@ -304,6 +391,7 @@ void CommandList::write(commands::QueryAccelerationStructureProperties&& cmd)
 
 void CommandList::write(commands::ExecuteClusterOperation&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::ExecuteClusterOperation);
     retainResource<Buffer>(cmd.desc.argCountBuffer.buffer);
     retainResource<Buffer>(cmd.desc.argsBuffer.buffer);
     retainResource<Buffer>(cmd.desc.scratchBuffer.buffer);
@@ -315,6 +403,7 @@ void CommandList::write(commands::ExecuteClusterOperation&& cmd)
 
 void CommandList::write(commands::ConvertCooperativeVectorMatrix&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::ConvertCooperativeVectorMatrix);
     retainResource<Buffer>(cmd.dstBuffer);
     retainResource<Buffer>(cmd.srcBuffer);
     if (cmd.dstDescs && cmd.matrixCount > 0)
@@ -332,23 +421,27 @@ void CommandList::write(commands::ConvertCooperativeVectorMatrix&& cmd)
 
 void CommandList::write(commands::SetBufferState&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::SetBufferState);
     retainResource<Buffer>(cmd.buffer);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::SetTextureState&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::SetTextureState);
     retainResource<Texture>(cmd.texture);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::GlobalBarrier&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::GlobalBarrier);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::PushDebugGroup&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::PushDebugGroup);
     if (cmd.name)
         cmd.name = (const char*)writeData(cmd.name, strlen(cmd.name) + 1);
     writeCommand(std::move(cmd));
@@ -356,11 +449,13 @@ void CommandList::write(commands::PushDebugGroup&& cmd)
 
 void CommandList::write(commands::PopDebugGroup&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::PopDebugGroup);
     writeCommand(std::move(cmd));
 }
 
 void CommandList::write(commands::InsertDebugMarker&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::InsertDebugMarker);
     if (cmd.name)
         cmd.name = (const char*)writeData(cmd.name, strlen(cmd.name) + 1);
     writeCommand(std::move(cmd));
@@ -368,6 +463,7 @@ void CommandList::write(commands::InsertDebugMarker&& cmd)
 
 void CommandList::write(commands::WriteTimestamp&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::WriteTimestamp);
     retainResource<QueryPool>(cmd.queryPool);
     writeCommand(std::move(cmd));
     trackQueryWrite(cmd.queryPool, cmd.queryIndex, 1);
@@ -376,6 +472,7 @@ void CommandList::write(commands::WriteTimestamp&& cmd)
 
 void CommandList::write(commands::ExecuteCallback&& cmd)
 {
+    SLANG_RHI_COMMAND_PROFILE_SCOPE(m_profiler, Encode, CommandID::ExecuteCallback);
     if (cmd.desc.userData && cmd.desc.userDataSize > 0)
         cmd.desc.userData = writeData(cmd.desc.userData, cmd.desc.userDataSize);
 
@@ -3,11 +3,12 @@
 #include <slang-rhi.h>
 #include "core/common.h"
 #include "core/arena-allocator.h"
+#include "core/ref-object-set.h"
 #include "core/short_vector.h"
 
 #include <utility>
-#include <set>
 #include <cstring>
+#include <iterator>
 #include <vector>
 
 // clang-format off
@@ -58,6 +59,9 @@ namespace rhi {
 
 struct BindingData;
 class ExtendedShaderObjectTypeListObject;
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+class CommandProfiler;
+#endif
 
 #define SLANG_RHI_COMMAND_ENUM_X(x) x,
 
@@ -68,6 +72,16 @@ enum class CommandID : uint32_t
 
 #undef SLANG_RHI_COMMAND_ENUM_X
 
+#define SLANG_RHI_COMMAND_COUNT_X(x) +1
+
+/// Number of command types.
+static constexpr uint32_t kCommandCount = 0 SLANG_RHI_COMMANDS(SLANG_RHI_COMMAND_COUNT_X);
+
+#undef SLANG_RHI_COMMAND_COUNT_X
+
+/// Returns the name of a command type.
+const char* getCommandName(CommandID id);
+
 namespace commands {
 
 struct CopyBuffer
@@ -385,18 +399,63 @@ struct ExecuteCallbackObjectRetainer
 /// - Allow use of unspecialized programs during command encoding, for which pipelines
 ///   are not yet created.
 ///
-/// Commands are written into consecutive memory pages and put into a linked list.
+/// Each command is written as a small header followed inline by its payload, in consecutive memory pages.
+/// Consecutive commands are therefore laid out back to back in memory. The headers are linked so that
+/// commands can be spliced in from child encoders and removed by optimization passes without copying.
 /// All resources referenced by the commands are retained until the command list is reset.
 ///
 class CommandList : public RefObject
 {
 public:
+    /// Command header. The command payload is stored directly after the header.
     struct CommandSlot
     {
         CommandID id;
+        /// Size of the payload in bytes.
+        uint32_t size;
         CommandSlot* next;
-        void* data;
+
+        void* getData() { return this + 1; }
+        const void* getData() const { return this + 1; }
+    };
+
+    /// Forward iterator over the commands of a command list.
+    template<typename Slot>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Slot*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Slot**;
+        using reference = Slot*;
+
+        Iterator() = default;
+        explicit Iterator(Slot* slot)
+            : m_slot(slot)
+        {
+        }
+
+        Slot* operator*() const { return m_slot; }
+        Iterator& operator++()
+        {
+            m_slot = m_slot->next;
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator it = *this;
+            m_slot = m_slot->next;
+            return it;
+        }
+        bool operator==(const Iterator& other) const { return m_slot == other.m_slot; }
+        bool operator!=(const Iterator& other) const { return m_slot != other.m_slot; }
+
+    private:
+        Slot* m_slot = nullptr;
     };
+    using iterator = Iterator<CommandSlot>;
+    using const_iterator = Iterator<const CommandSlot>;
 
     struct QueryWriteRange
     {
@@ -408,7 +467,7 @@ public:
 
     CommandList(
         ArenaAllocator& allocator,
-        std::set<RefPtr<RefObject>>& trackedObjects,
+        RefObjectSet& trackedObjects,
         std::vector<ExecuteCallbackObjectRetainer>& trackedExecuteCallbackObjects
     );
 
@@ -454,20 +513,42 @@ public:
     void write(commands::WriteTimestamp&& cmd);
     void write(commands::ExecuteCallback&& cmd);
 
+    CommandSlot* getCommands() { return m_commandSlots; }
     const CommandSlot* getCommands() const { return m_commandSlots; }
+
+    /// Replace the command sequence with `count` of its own command slots, in the given order.
+    /// Used by passes that remove commands after encoding.
+    void setCommands(CommandSlot* const* commands, size_t count);
+
+    CommandSlot* getLastCommand() { return m_lastCommandSlot; }
+
+    iterator begin() { return iterator(m_commandSlots); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(m_commandSlots); }
+    const_iterator end() const { return const_iterator(); }
+
+    /// Move all commands of `other` into this list, after `position` (or at the front if `position` is nullptr).
+    /// Command slots are relinked, not copied, so `other`'s allocator must outlive this list's use of them.
+    /// Query writes are merged. `other` is left empty.
+    void splice(CommandSlot* position, CommandList& other);
     const QueryWriteRangeList& getQueryWrites() const { return m_queryWrites; }
     bool writesTimestamp() const { return m_writesTimestamp; }
 
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+    /// Set the profiler to record encode times to (may be null).
+    void setProfiler(CommandProfiler* profiler) { m_profiler = profiler; }
+#endif
+
     template<typename T>
     T& getCommand(const CommandSlot* command)
     {
-        return *reinterpret_cast<T*>(command->data);
+        return *reinterpret_cast<T*>(const_cast<CommandSlot*>(command)->getData());
     }
 
     template<typename T>
     const T& getCommand(const CommandSlot* command) const
     {
-        return *reinterpret_cast<const T*>(command->data);
+        return *reinterpret_cast<const T*>(command->getData());
     }
 
     void retainResource(RefObject* resource)
@@ -499,22 +580,32 @@ public:
 
 private:
     ArenaAllocator& m_allocator;
-    std::set<RefPtr<RefObject>>& m_trackedObjects;
+    RefObjectSet& m_trackedObjects;
     std::vector<ExecuteCallbackObjectRetainer>& m_trackedExecuteCallbackObjects;
     CommandSlot* m_commandSlots = nullptr;
     CommandSlot* m_lastCommandSlot = nullptr;
     QueryWriteRangeList m_queryWrites;
     bool m_writesTimestamp = false;
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+    CommandProfiler* m_profiler = nullptr;
+#endif
 
     void trackQueryWrite(IQueryPool* queryPool, uint32_t index, uint32_t count);
 
     template<typename T>
     void writeCommand(T&& cmd)
     {
-        CommandSlot* slot = reinterpret_cast<CommandSlot*>(m_allocator.allocate(sizeof(CommandSlot)));
+        static_assert(alignof(T) <= alignof(CommandSlot), "Command payload must not need stricter alignment");
+        static_assert(sizeof(CommandSlot) % alignof(CommandSlot) == 0);
+
+        // Header and payload are written with a single allocation.
+        void* memory = m_allocator.allocate(sizeof(CommandSlot) + sizeof(T), alignof(CommandSlot));
+        CommandSlot* slot = reinterpret_cast<CommandSlot*>(memory);
         slot->id = commands::Traits<T>::id;
+        slot->size = uint32_t(sizeof(T));
         slot->next = nullptr;
-        slot->data = nullptr;
+        new (slot->getData()) T(std::forward<T>(cmd));
+
         if (m_lastCommandSlot)
         {
             m_lastCommandSlot->next = slot;
@@ -524,12 +615,6 @@ private:
             m_commandSlots = slot;
         }
         m_lastCommandSlot = slot;
-
-        if constexpr (sizeof(T) > 0)
-        {
-            slot->data = m_allocator.allocate(sizeof(T));
-            new (slot->data) T(std::forward<T>(cmd));
-        }
     }
 };
 
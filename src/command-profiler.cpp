@@ -0,0 +1,135 @@
+#include "command-profiler.h"
+
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+
+#include "reference.h"
+
+#include "core/blob.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace rhi {
+
+void CommandProfiler::record(Stage stage, CommandID id, TimePoint start, TimePoint end)
+{
+    Counter& counter = m_counters[size_t(stage)][size_t(id)];
+    counter.count.fetch_add(1, std::memory_order_relaxed);
+    counter.timeNS.fetch_add(end - start, std::memory_order_relaxed);
+
+    if (stage == Stage::Execute)
+    {
+        uint32_t threadId = uint32_t(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        std::lock_guard<std::mutex> lock(m_traceMutex);
+        TraceEvent event = {id, threadId, start, end};
+        if (m_traceEvents.size() < kMaxTraceEvents)
+            m_traceEvents.push_back(event);
+        else
+            m_traceEvents[m_nextTraceEvent] = event;
+        m_nextTraceEvent = (m_nextTraceEvent + 1) % kMaxTraceEvents;
+    }
+}
+
+void CommandProfiler::getEntries(CommandProfileEntry outEntries[kCommandCount]) const
+{
+    for (uint32_t i = 0; i < kCommandCount; ++i)
+    {
+        CommandProfileEntry& entry = outEntries[i];
+        const Counter& encode = m_counters[size_t(Stage::Encode)][i];
+        const Counter& execute = m_counters[size_t(Stage::Execute)][i];
+        entry.command = getCommandName(CommandID(i));
+        entry.encodeCount = encode.count.load(std::memory_order_relaxed);
+        entry.encodeTimeNS = encode.timeNS.load(std::memory_order_relaxed);
+        entry.executeCount = execute.count.load(std::memory_order_relaxed);
+        entry.executeTimeNS = execute.timeNS.load(std::memory_order_relaxed);
+    }
+}
+
+Result CommandProfiler::dump(CommandProfileFormat format, ISlangBlob** outBlob) const
+{
+    std::string str;
+    switch (format)
+    {
+    case CommandProfileFormat::JSON:
+    {
+        CommandProfileEntry entries[kCommandCount];
+        getEntries(entries);
+        str += "{\"commands\":[";
+        for (uint32_t i = 0; i < kCommandCount; ++i)
+        {
+            const CommandProfileEntry& entry = entries[i];
+            str += i > 0 ? ",\n" : "\n";
+            str += "{\"name\":\"";
+            str += entry.command;
+            str += "\",\"encodeCount\":" + std::to_string(entry.encodeCount);
+            str += ",\"encodeTimeNS\":" + std::to_string(entry.encodeTimeNS);
+            str += ",\"executeCount\":" + std::to_string(entry.executeCount);
+            str += ",\"executeTimeNS\":" + std::to_string(entry.executeTimeNS);
+            str += "}";
+        }
+        str += "\n]}\n";
+        break;
+    }
+    case CommandProfileFormat::ChromeTrace:
+    {
+        std::vector<TraceEvent> events;
+        {
+            std::lock_guard<std::mutex> lock(m_traceMutex);
+            events = m_traceEvents;
+        }
+        std::sort(
+            events.begin(),
+            events.end(),
+            [](const TraceEvent& a, const TraceEvent& b) { return a.start < b.start; }
+        );
+        TimePoint origin = events.empty() ? 0 : events.front().start;
+        str += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        char buffer[256];
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const TraceEvent& event = events[i];
+            snprintf(
+                buffer,
+                sizeof(buffer),
+                "%s{\"name\":\"%s\",\"cat\":\"execute\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u}",
+                i > 0 ? ",\n" : "\n",
+                getCommandName(event.id),
+                (event.start - origin) * 1e-3,
+                (event.end - event.start) * 1e-3,
+                event.threadId
+            );
+            str += buffer;
+        }
+        str += "\n]}\n";
+        break;
+    }
+    default:
+        return SLANG_E_INVALID_ARG;
+    }
+
+    ComPtr<ISlangBlob> blob = OwnedBlob::create(str.data(), str.size());
+    returnComPtr(outBlob, blob);
+    return SLANG_OK;
+}
+
+void CommandProfiler::reset()
+{
+    for (auto& counters : m_counters)
+    {
+        for (Counter& counter : counters)
+        {
+            counter.count.store(0, std::memory_order_relaxed);
+            counter.timeNS.store(0, std::memory_order_relaxed);
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+    m_traceEvents.clear();
+    m_nextTraceEvent = 0;
+}
+
+} // namespace rhi
+
+#endif // SLANG_RHI_ENABLE_COMMAND_PROFILING
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <slang-rhi.h>
+
+#include "command-list.h"
+
+#include "core/timer.h"
+
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace rhi {
+
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+
+/// Collects per command type counts and CPU times.
+///
+/// Encode times are measured in `CommandList::write` (including resource retention), execute times in the
+/// backend command loops. For D3D12, Vulkan, Metal and WebGPU this is the time to record native commands when
+/// the command encoder is finished, for CPU, CUDA and D3D11 the time to execute commands when submitted.
+///
+/// Counters are updated with relaxed atomics and can be sampled from any thread while commands are recorded.
+/// The most recent execute spans are kept in a bounded ring buffer for Chrome trace output.
+///
+/// Only available if slang-rhi is built with `SLANG_RHI_ENABLE_COMMAND_PROFILING`.
+class CommandProfiler
+{
+public:
+    enum class Stage
+    {
+        Encode,
+        Execute,
+    };
+
+    /// Maximum number of execute spans kept for Chrome trace output.
+    static constexpr size_t kMaxTraceEvents = 64 * 1024;
+
+    void record(Stage stage, CommandID id, TimePoint start, TimePoint end);
+
+    /// Fill one entry per command type.
+    void getEntries(CommandProfileEntry outEntries[kCommandCount]) const;
+
+    Result dump(CommandProfileFormat format, ISlangBlob** outBlob) const;
+
+    void reset();
+
+private:
+    struct Counter
+    {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> timeNS{0};
+    };
+
+    struct TraceEvent
+    {
+        CommandID id;
+        uint32_t threadId;
+        TimePoint start;
+        TimePoint end;
+    };
+
+    Counter m_counters[2][kCommandCount];
+
+    mutable std::mutex m_traceMutex;
+    std::vector<TraceEvent> m_traceEvents;
+    size_t m_nextTraceEvent = 0;
+};
+
+/// Records the time from construction to destruction to a profiler (if not null).
+class CommandProfileScope
+{
+public:
+    CommandProfileScope(CommandProfiler* profiler, CommandProfiler::Stage stage, CommandID id)
+        : m_profiler(profiler)
+        , m_stage(stage)
+        , m_id(id)
+    {
+        if (m_profiler)
+            m_start = Timer::now();
+    }
+
+    ~CommandProfileScope()
+    {
+        if (m_profiler)
+            m_profiler->record(m_stage, m_id, m_start, Timer::now());
+    }
+
+private:
+    CommandProfiler* m_profiler;
+    CommandProfiler::Stage m_stage;
+    CommandID m_id;
+    TimePoint m_start = 0;
+};
+
+#define SLANG_RHI_COMMAND_PROFILE_SCOPE(profiler, stage, id)                                                           \
+    ::rhi::CommandProfileScope _commandProfileScope(profiler, ::rhi::CommandProfiler::Stage::stage, id)
+
+#else // SLANG_RHI_ENABLE_COMMAND_PROFILING
+
+#define SLANG_RHI_COMMAND_PROFILE_SCOPE(profiler, stage, id)
+
+#endif // SLANG_RHI_ENABLE_COMMAND_PROFILING
+
+} // namespace rhi
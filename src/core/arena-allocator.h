@@ -6,21 +6,47 @@ namespace rhi {
 
 /// Simple arena allocator.
 /// Allocates memory in pages and allows reuse of memory by resetting the allocator.
-/// All pages are freed when the allocator is destroyed.
+/// Pages that were not used during the last `maxUnusedResets` resets are freed on reset, so a single
+/// exceptionally large workload does not inflate the allocator permanently.
+/// Allocations that do not fit into a page are allocated separately and freed on reset.
+/// All memory is freed when the allocator is destroyed.
 /// The allocator is not thread-safe.
 class ArenaAllocator
 {
 public:
     /// Default page size is 1MB.
     static constexpr size_t kDefaultPageSize = 1024 * 1024;
+    /// Default number of resets after which unused pages are freed.
+    static constexpr uint32_t kDefaultMaxUnusedResets = 8;
 
-    ArenaAllocator(size_t pageSize = kDefaultPageSize)
+    struct Stats
+    {
+        /// Number of bytes allocated since the last reset.
+        size_t usedBytes = 0;
+        /// Highest number of bytes allocated between two resets.
+        size_t peakUsedBytes = 0;
+        /// Number of bytes currently held by the allocator, including page headers.
+        size_t reservedBytes = 0;
+        /// Highest number of bytes held by the allocator.
+        size_t peakReservedBytes = 0;
+        /// Number of pages currently held by the allocator.
+        size_t pageCount = 0;
+        /// Number of separately allocated large allocations since the last reset.
+        size_t largeAllocationCount = 0;
+    };
+
+    ArenaAllocator(size_t pageSize = kDefaultPageSize, uint32_t maxUnusedResets = kDefaultMaxUnusedResets)
         : m_pageSize(pageSize)
+        , m_maxUnusedResets(maxUnusedResets)
     {
         SLANG_RHI_ASSERT(pageSize > sizeof(Page));
     }
 
-    ~ArenaAllocator() { freePages(); }
+    ~ArenaAllocator()
+    {
+        freeLargeAllocations();
+        freePages(m_pages);
+    }
 
     ArenaAllocator(const ArenaAllocator&) = delete;
     ArenaAllocator& operator=(const ArenaAllocator&) = delete;
@@ -32,26 +58,34 @@ public:
     /// Alignment must be a power of 2.
     void* allocate(size_t size, size_t alignment = 16)
     {
+        if (size + alignment + sizeof(Page) > m_pageSize)
+            return allocateLarge(size, alignment);
+
         m_pos = (m_pos + alignment - 1) & ~(alignment - 1);
         if (!m_page || m_pos + size > m_page->end())
         {
-            size_t requiredSize = max(size + alignment + sizeof(Page), m_pageSize);
-            Page* next = m_page ? m_page->next : nullptr;
-            if (!next || ((next->begin() + alignment - 1) & ~(alignment - 1)) + size > next->end())
+            // All pages have the same size, so the next page can always hold the allocation.
+            Page* next = m_page ? m_page->next : m_pages;
+            if (!next)
             {
-                Page* newPage = allocatePage(requiredSize);
-                newPage->next = next;
+                next = allocatePage(m_pageSize);
                 if (m_page)
-                    m_page->next = newPage;
+                {
+                    next->next = m_page->next;
+                    m_page->next = next;
+                }
                 else
-                    m_pages = newPage;
-                next = newPage;
+                {
+                    m_pages = next;
+                }
             }
             m_page = next;
+            m_page->unusedResets = 0;
             m_pos = (m_page->begin() + alignment - 1) & ~(alignment - 1);
         }
         void* result = (void*)m_pos;
         m_pos += size;
+        addUsedBytes(size);
         SLANG_RHI_ASSERT(result != nullptr);
         SLANG_RHI_ASSERT(((uintptr_t)result & (alignment - 1)) == 0);
         return result;
@@ -66,25 +100,107 @@ public:
     }
 
     /// Reset the allocator.
+    /// Large allocations are freed, and so are pages that were not used during the last `maxUnusedResets` resets.
     void reset()
     {
-        m_page = m_pages;
-        m_pos = m_page ? m_page->begin() : 0;
+        freeLargeAllocations();
+
+        // Pages are used in order, so pages after the current page were not used since the last reset,
+        // and the number of resets since their last use is increasing along the chain.
+        Page* last = m_page;
+        Page* page = m_page ? m_page->next : m_pages;
+        while (page && page->unusedResets < m_maxUnusedResets)
+        {
+            page->unusedResets++;
+            last = page;
+            page = page->next;
+        }
+        if (page)
+        {
+            if (last)
+                last->next = nullptr;
+            else
+                m_pages = nullptr;
+            freePages(page);
+        }
+
+        m_page = nullptr;
+        m_pos = 0;
+        m_stats.usedBytes = 0;
+        m_stats.largeAllocationCount = 0;
     }
 
+    /// Set the number of resets a page can stay unused before it is freed.
+    void setMaxUnusedResets(uint32_t maxUnusedResets) { m_maxUnusedResets = maxUnusedResets; }
+
+    const Stats& getStats() const { return m_stats; }
+
 private:
     struct Page
     {
         Page* next;
         size_t size;
+        /// Number of resets since the page was last used.
+        uint32_t unusedResets;
         uintptr_t begin() const { return reinterpret_cast<uintptr_t>(this) + sizeof(Page); }
         uintptr_t end() const { return begin() + size; }
     };
 
+    struct LargeAllocation
+    {
+        LargeAllocation* next;
+        size_t totalSize;
+    };
+
     size_t m_pageSize;
+    uint32_t m_maxUnusedResets;
     Page* m_pages = nullptr;
     Page* m_page = nullptr;
     uintptr_t m_pos = 0;
+    LargeAllocation* m_largeAllocations = nullptr;
+    Stats m_stats;
+
+    void addUsedBytes(size_t size)
+    {
+        m_stats.usedBytes += size;
+        m_stats.peakUsedBytes = max(m_stats.peakUsedBytes, m_stats.usedBytes);
+    }
+
+    void addReservedBytes(size_t size)
+    {
+        m_stats.reservedBytes += size;
+        m_stats.peakReservedBytes = max(m_stats.peakReservedBytes, m_stats.reservedBytes);
+    }
+
+    /// Allocate memory that does not fit into a page.
+    void* allocateLarge(size_t size, size_t alignment)
+    {
+        size_t totalSize = sizeof(LargeAllocation) + size + alignment;
+        LargeAllocation* allocation = reinterpret_cast<LargeAllocation*>(std::malloc(totalSize));
+        allocation->next = m_largeAllocations;
+        allocation->totalSize = totalSize;
+        m_largeAllocations = allocation;
+        m_stats.largeAllocationCount++;
+        addReservedBytes(totalSize);
+        addUsedBytes(size);
+        uintptr_t begin = reinterpret_cast<uintptr_t>(allocation) + sizeof(LargeAllocation);
+        void* result = (void*)((begin + alignment - 1) & ~(alignment - 1));
+        SLANG_RHI_ASSERT(((uintptr_t)result & (alignment - 1)) == 0);
+        return result;
+    }
+
+    void freeLargeAllocations()
+    {
+        LargeAllocation* allocation = m_largeAllocations;
+        while (allocation)
+        {
+            LargeAllocation* next = allocation->next;
+            m_stats.reservedBytes -= allocation->totalSize;
+            std::free(allocation);
+            allocation = next;
+        }
+        m_largeAllocations = nullptr;
+    }
 
     /// Allocate a page of the given total size (including the page header).
     Page* allocatePage(size_t totalSize)
@@ -93,19 +209,23 @@ private:
         Page* page = reinterpret_cast<Page*>(data);
         page->next = nullptr;
         page->size = totalSize - sizeof(Page);
+        page->unusedResets = 0;
+        m_stats.pageCount++;
+        addReservedBytes(totalSize);
         return page;
     }
 
-    void freePages()
+    /// Free a chain of pages.
+    void freePages(Page* page)
     {
-        Page* page = m_pages;
         while (page)
         {
             Page* next = page->next;
+            m_stats.pageCount--;
+            m_stats.reservedBytes -= page->size + sizeof(Page);
             std::free(page);
             page = next;
         }
-        m_pages = nullptr;
     }
 };
 
@@ -2,10 +2,19 @@
 
 #include "assert.h"
 
+#include <cstdio>
+
 #if SLANG_WINDOWS_FAMILY
 #include <windows.h>
 #elif SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
 #include <dlfcn.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#if SLANG_LINUX_FAMILY
+#include <sys/mman.h>
+#endif
 #if SLANG_LINUX_FAMILY
 #include <time.h>
 #endif
@@ -48,6 +57,104 @@ void unloadSharedLibrary(SharedLibraryHandle handle)
 #endif
 }
 
+Result loadSharedLibraryFromMemory(const void* data, size_t size, MemorySharedLibrary& outLibrary)
+{
+    outLibrary = {};
+#if SLANG_WINDOWS_FAMILY
+    char tempDir[MAX_PATH];
+    char tempPath[MAX_PATH];
+    if (!GetTempPathA(MAX_PATH, tempDir) || !GetTempFileNameA(tempDir, "srh", 0, tempPath))
+        return SLANG_FAIL;
+    HANDLE file = CreateFileA(tempPath, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        DeleteFileA(tempPath);
+        return SLANG_FAIL;
+    }
+    DWORD written = 0;
+    bool ok = WriteFile(file, data, DWORD(size), &written, nullptr) && written == size;
+    CloseHandle(file);
+    if (!ok || SLANG_FAILED(loadSharedLibrary(tempPath, outLibrary.handle)))
+    {
+        DeleteFileA(tempPath);
+        outLibrary.handle = nullptr;
+        return SLANG_FAIL;
+    }
+    // The file is locked while the library is loaded, it is deleted after unloading.
+    outLibrary.tempPath = tempPath;
+    return SLANG_OK;
+#elif SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
+    char path[PATH_MAX];
+    int fd = -1;
+    bool isTempFile = false;
+#if SLANG_LINUX_FAMILY && defined(MFD_CLOEXEC)
+    fd = memfd_create("slang-rhi-library", MFD_CLOEXEC);
+    if (fd >= 0)
+        snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+#endif
+    if (fd < 0)
+    {
+        const char* tempDir = getenv("TMPDIR");
+        if (!tempDir || !*tempDir)
+            tempDir = "/tmp";
+        snprintf(path, sizeof(path), "%s/slang-rhi-XXXXXX", tempDir);
+        fd = mkstemp(path);
+        if (fd < 0)
+            return SLANG_FAIL;
+        isTempFile = true;
+    }
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    size_t remaining = size;
+    while (remaining > 0)
+    {
+        ssize_t written = ::write(fd, src, remaining);
+        if (written <= 0)
+            break;
+        src += written;
+        remaining -= size_t(written);
+    }
+    Result result = remaining == 0 ? loadSharedLibrary(path, outLibrary.handle) : SLANG_FAIL;
+    if (SLANG_FAILED(result))
+    {
+        ::close(fd);
+        if (isTempFile)
+            ::unlink(path);
+        outLibrary.handle = nullptr;
+        return result;
+    }
+    // Keep the file open (memfd) or on disk (temporary file) while the library is loaded. This keeps its path
+    // unique: the loader matches libraries by path, so a reused fd number or file name would return this library.
+    if (isTempFile)
+    {
+        ::close(fd);
+        outLibrary.tempPath = path;
+    }
+    else
+    {
+        outLibrary.fd = fd;
+    }
+    return SLANG_OK;
+#else
+    SLANG_UNUSED(data);
+    SLANG_UNUSED(size);
+    SLANG_RHI_ASSERT_FAILURE("Not implemented");
+    return SLANG_E_NOT_IMPLEMENTED;
+#endif
+}
+
+void unloadSharedLibraryFromMemory(MemorySharedLibrary& library)
+{
+    if (library.handle)
+        unloadSharedLibrary(library.handle);
+#if SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
+    if (library.fd >= 0)
+        ::close(library.fd);
+#endif
+    if (!library.tempPath.empty())
+        std::remove(library.tempPath.c_str());
+    library = {};
+}
+
 void* findSymbolAddressByName(SharedLibraryHandle handle, const char* name)
 {
 #if SLANG_WINDOWS_FAMILY
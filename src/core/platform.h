@@ -2,6 +2,8 @@
 
 #include <slang-rhi.h>
 
+#include <string>
+
 namespace rhi {
 
 using SharedLibraryHandle = void*;
@@ -9,6 +11,26 @@ using SharedLibraryHandle = void*;
 Result loadSharedLibrary(const char* path, SharedLibraryHandle& handleOut);
 void unloadSharedLibrary(SharedLibraryHandle handle);
 
+/// Shared library loaded from an in-memory image, see `loadSharedLibraryFromMemory()`.
+struct MemorySharedLibrary
+{
+    SharedLibraryHandle handle = nullptr;
+    /// Anonymous memory file backing the library (Linux).
+    int fd = -1;
+    /// Temporary file backing the library.
+    std::string tempPath;
+};
+
+/// Load a shared library from an in-memory image.
+/// On Linux the image is backed by an anonymous memory file. Otherwise it is written to a temporary file.
+/// The backing file is kept until the library is unloaded with `unloadSharedLibraryFromMemory()`, so that
+/// every loaded image has a unique path. The dynamic loader returns the already loaded library when a
+/// path is opened again, so reusing the path of a released file would return the wrong library.
+Result loadSharedLibraryFromMemory(const void* data, size_t size, MemorySharedLibrary& outLibrary);
+
+/// Unload a library loaded with `loadSharedLibraryFromMemory()` and release its backing file.
+void unloadSharedLibraryFromMemory(MemorySharedLibrary& library);
+
 /// Given a shared library handle and a name, return the associated object.
 /// Return nullptr if object is not found.
 void* findSymbolAddressByName(SharedLibraryHandle handle, const char* name);
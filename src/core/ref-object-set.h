@@ -0,0 +1,128 @@
+#pragma once
+
+#include "common.h"
+#include "smart-pointer.h"
+
+#include <cstdlib>
+
+namespace rhi {
+
+/// Set holding strong references to ref objects.
+/// Uses open addressing with linear probing on a power of two sized table, so inserts are amortized O(1)
+/// and only allocate when the table grows. A reference is added once per unique object.
+/// The indices of occupied slots are tracked, so `clear()` is O(size) rather than O(capacity), and keeps the
+/// table for reuse.
+/// The set is not thread-safe.
+class RefObjectSet
+{
+public:
+    RefObjectSet() = default;
+
+    ~RefObjectSet()
+    {
+        clear();
+        std::free(m_slots);
+        std::free(m_occupied);
+    }
+
+    RefObjectSet(const RefObjectSet&) = delete;
+    RefObjectSet& operator=(const RefObjectSet&) = delete;
+
+    RefObjectSet(RefObjectSet&&) = delete;
+    RefObjectSet& operator=(RefObjectSet&&) = delete;
+
+    /// Insert an object and add a reference to it.
+    /// Returns true if the object was not in the set before.
+    bool insert(RefObject* object)
+    {
+        if (!object)
+            return false;
+        // Keep the load factor below 3/4.
+        if ((m_count + 1) * 4 > m_capacity * 3)
+            grow();
+        size_t mask = m_capacity - 1;
+        size_t index = hash(object) & mask;
+        while (RefObject* slot = m_slots[index])
+        {
+            if (slot == object)
+                return false;
+            index = (index + 1) & mask;
+        }
+        m_slots[index] = object;
+        m_occupied[m_count++] = index;
+        object->addReference();
+        return true;
+    }
+
+    /// Returns true if the object is in the set.
+    bool contains(RefObject* object) const
+    {
+        if (!object || m_count == 0)
+            return false;
+        size_t mask = m_capacity - 1;
+        size_t index = hash(object) & mask;
+        while (RefObject* slot = m_slots[index])
+        {
+            if (slot == object)
+                return true;
+            index = (index + 1) & mask;
+        }
+        return false;
+    }
+
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+    /// Release all references. The table is kept for reuse.
+    void clear()
+    {
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            RefObject* object = m_slots[m_occupied[i]];
+            m_slots[m_occupied[i]] = nullptr;
+            object->releaseReference();
+        }
+        m_count = 0;
+    }
+
+private:
+    static constexpr size_t kMinCapacity = 64;
+
+    RefObject** m_slots = nullptr;
+    /// Indices of the occupied slots, in insertion order.
+    size_t* m_occupied = nullptr;
+    size_t m_capacity = 0;
+    size_t m_count = 0;
+
+    static size_t hash(RefObject* object)
+    {
+        // Fibonacci hashing, folding the high bits into the low bits used for indexing.
+        uint64_t h = uint64_t(reinterpret_cast<uintptr_t>(object)) * 0x9E3779B97F4A7C15ull;
+        return size_t(h ^ (h >> 32));
+    }
+
+    void grow()
+    {
+        size_t newCapacity = max(m_capacity * 2, kMinCapacity);
+        RefObject** newSlots = reinterpret_cast<RefObject**>(std::calloc(newCapacity, sizeof(RefObject*)));
+        size_t* newOccupied = reinterpret_cast<size_t*>(std::malloc(newCapacity * sizeof(size_t)));
+        SLANG_RHI_ASSERT(newSlots && newOccupied);
+        size_t mask = newCapacity - 1;
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            RefObject* object = m_slots[m_occupied[i]];
+            size_t index = hash(object) & mask;
+            while (newSlots[index])
+                index = (index + 1) & mask;
+            newSlots[index] = object;
+            newOccupied[i] = index;
+        }
+        std::free(m_slots);
+        std::free(m_occupied);
+        m_slots = newSlots;
+        m_occupied = newOccupied;
+        m_capacity = newCapacity;
+    }
+};
+
+} // namespace rhi
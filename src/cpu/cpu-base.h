@@ -17,6 +17,7 @@ class BackendImpl;
 class BufferImpl;
 class TextureImpl;
 class TextureViewImpl;
+class SamplerImpl;
 class ShaderObjectLayoutImpl;
 class EntryPointLayoutImpl;
 class RootShaderObjectLayoutImpl;
@@ -26,6 +27,7 @@ class RootShaderObjectImpl;
 class ShaderProgramImpl;
 class ComputePipelineImpl;
 class QueryPoolImpl;
+class FenceImpl;
 class CommandQueueImpl;
 class CommandEncoderImpl;
 class CommandBufferImpl;
@@ -58,6 +58,8 @@ Result DeviceImpl::readBuffer(IBuffer* buffer, Offset offset, Size size, void* o
     {
         return SLANG_FAIL;
     }
+    // Make sure pending submits have finished writing the buffer.
+    m_queue->waitForIdle();
     std::memcpy(outData, bufferImpl->m_data + offset, size);
     return SLANG_OK;
 }
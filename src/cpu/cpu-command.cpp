@@ -2,7 +2,11 @@
 #include "cpu-query.h"
 #include "cpu-shader-program.h"
 #include "cpu-pipeline.h"
+#include "cpu-texture.h"
+#include "cpu-utils.h"
 #include "../command-list.h"
+#include "../format-conversion.h"
+#include "../resource-desc-utils.h"
 #include "../strings.h"
 
 #include "core/platform.h"
@@ -65,6 +69,9 @@ public:
     void cmdInsertDebugMarker(const commands::InsertDebugMarker& cmd);
     void cmdWriteTimestamp(const commands::WriteTimestamp& cmd);
     void cmdExecuteCallback(const commands::ExecuteCallback& cmd);
+
+    void dispatchCompute(uint32_t x, uint32_t y, uint32_t z);
+    void clearTexture(TextureImpl* texture, SubresourceRange subresourceRange, const void* clearValue);
 };
 
 Result CommandExecutor::execute(CommandBufferImpl* commandBuffer)
@@ -78,6 +85,7 @@ Result CommandExecutor::execute(CommandBufferImpl* commandBuffer)
         cmd##x(commandList.getCommand<commands::x>(command));                                                          \
         break;
 
+        SLANG_RHI_COMMAND_PROFILE_SCOPE(&m_device->m_commandProfiler, Execute, command->id);
         switch (command->id)
         {
             SLANG_RHI_COMMANDS(SLANG_RHI_COMMAND_EXECUTE_X);
@@ -102,14 +110,91 @@ void CommandExecutor::cmdCopyBuffer(const commands::CopyBuffer& cmd)
 
 void CommandExecutor::cmdCopyTexture(const commands::CopyTexture& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(ICommandEncoder, copyTexture);
+    TextureImpl* dst = checked_cast<TextureImpl*>(cmd.dst);
+    TextureImpl* src = checked_cast<TextureImpl*>(cmd.src);
+
+    SubresourceRange dstSubresource = cmd.dstSubresource;
+    const Offset3D& dstOffset = cmd.dstOffset;
+    SubresourceRange srcSubresource = cmd.srcSubresource;
+    const Offset3D& srcOffset = cmd.srcOffset;
+
+    // Fix up sub resource ranges if they are 0 (meaning use entire range)
+    if (srcSubresource.layerCount == 0)
+        srcSubresource.layerCount = src->m_desc.getLayerCount();
+    if (srcSubresource.mipCount == 0)
+        srcSubresource.mipCount = src->m_desc.mipCount;
+
+    // Copy each layer and mip level
+    for (uint32_t layerOffset = 0; layerOffset < srcSubresource.layerCount; layerOffset++)
+    {
+        uint32_t srcLayer = srcSubresource.layer + layerOffset;
+        uint32_t dstLayer = dstSubresource.layer + layerOffset;
+
+        for (uint32_t mipOffset = 0; mipOffset < srcSubresource.mipCount; mipOffset++)
+        {
+            uint32_t srcMip = srcSubresource.mip + mipOffset;
+            uint32_t dstMip = dstSubresource.mip + mipOffset;
+
+            // Calculate adjusted extents. Note it is required and enforced
+            // by debug layer that if 'remaining texture' is used, src and
+            // dst offsets are the same.
+            Extent3D srcMipSize = calcMipSize(src->m_desc.size, srcMip);
+            Extent3D extent = cmd.extent;
+            if (extent.width == kRemainingTextureSize)
+                extent.width = srcMipSize.width - srcOffset.x;
+            if (extent.height == kRemainingTextureSize)
+                extent.height = srcMipSize.height - srcOffset.y;
+            if (extent.depth == kRemainingTextureSize)
+                extent.depth = srcMipSize.depth - srcOffset.z;
+
+            const TextureImpl::MipLevel& dstLevel = dst->m_mipLevels[dstMip];
+            const TextureImpl::MipLevel& srcLevel = src->m_mipLevels[srcMip];
+            copyRegion(
+                dst->getTexelPtr(dstLayer, dstMip, dstOffset),
+                dstLevel.pitches[1],
+                dstLevel.pitches[2],
+                src->getTexelPtr(srcLayer, srcMip, srcOffset),
+                srcLevel.pitches[1],
+                srcLevel.pitches[2],
+                size_t(extent.width) * src->m_texelSize,
+                extent.height,
+                extent.depth,
+                m_device->m_singleThreaded
+            );
+        }
+    }
 }
 
 void CommandExecutor::cmdCopyTextureToBuffer(const commands::CopyTextureToBuffer& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(ICommandEncoder, copyTextureToBuffer);
+    BufferImpl* dst = checked_cast<BufferImpl*>(cmd.dst);
+    TextureImpl* src = checked_cast<TextureImpl*>(cmd.src);
+
+    const Offset3D& srcOffset = cmd.srcOffset;
+
+    // Calculate adjusted extents.
+    Extent3D srcMipSize = calcMipSize(src->m_desc.size, cmd.srcMip);
+    Extent3D extent = cmd.extent;
+    if (extent.width == kRemainingTextureSize)
+        extent.width = srcMipSize.width - srcOffset.x;
+    if (extent.height == kRemainingTextureSize)
+        extent.height = srcMipSize.height - srcOffset.y;
+    if (extent.depth == kRemainingTextureSize)
+        extent.depth = srcMipSize.depth - srcOffset.z;
+
+    const TextureImpl::MipLevel& srcLevel = src->m_mipLevels[cmd.srcMip];
+    copyRegion(
+        dst->m_data + cmd.dstOffset,
+        cmd.dstRowPitch,
+        cmd.dstRowPitch * extent.height,
+        src->getTexelPtr(cmd.srcLayer, cmd.srcMip, srcOffset),
+        srcLevel.pitches[1],
+        srcLevel.pitches[2],
+        size_t(extent.width) * src->m_texelSize,
+        extent.height,
+        extent.depth,
+        m_device->m_singleThreaded
+    );
 }
 
 void CommandExecutor::cmdClearBuffer(const commands::ClearBuffer& cmd)
@@ -120,26 +205,87 @@ void CommandExecutor::cmdClearBuffer(const commands::ClearBuffer& cmd)
 
 void CommandExecutor::cmdClearTextureDepthStencil(const commands::ClearTextureDepthStencil& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(ICommandEncoder, clearTextureDepthStencil);
+    TextureImpl* texture = checked_cast<TextureImpl*>(cmd.texture);
+    const FormatInfo& formatInfo = getFormatInfo(texture->m_desc.format);
+    PackFloatFunc packFloatFunc = getFormatConversionFuncs(texture->m_desc.format).packFloatFunc;
+    if (formatInfo.hasStencil || !packFloatFunc)
+    {
+        NOT_SUPPORTED(ICommandEncoder, clearTextureDepthStencil);
+        return;
+    }
+    if (!cmd.clearDepth)
+        return;
+
+    float depthValue[4] = {cmd.depthValue, 0.f, 0.f, 0.f};
+    uint32_t packedClearValue[4] = {};
+    packFloatFunc(depthValue, packedClearValue);
+    clearTexture(texture, cmd.subresourceRange, packedClearValue);
 }
 
 void CommandExecutor::cmdClearTextureFloat(const commands::ClearTextureFloat& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(ICommandEncoder, clearTextureFloat);
+    TextureImpl* texture = checked_cast<TextureImpl*>(cmd.texture);
+    PackFloatFunc packFloatFunc = getFormatConversionFuncs(texture->m_desc.format).packFloatFunc;
+    if (!packFloatFunc)
+    {
+        NOT_SUPPORTED(ICommandEncoder, clearTextureFloat);
+        return;
+    }
+    uint32_t packedClearValue[4] = {};
+    packFloatFunc(cmd.clearValue, packedClearValue);
+    clearTexture(texture, cmd.subresourceRange, packedClearValue);
 }
 
 void CommandExecutor::cmdClearTextureUint(const commands::ClearTextureUint& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(ICommandEncoder, clearTextureUint);
+    TextureImpl* texture = checked_cast<TextureImpl*>(cmd.texture);
+    PackIntFunc packIntFunc = getFormatConversionFuncs(texture->m_desc.format).packIntFunc;
+    if (!packIntFunc)
+    {
+        NOT_SUPPORTED(ICommandEncoder, clearTextureUint);
+        return;
+    }
+    uint32_t truncatedClearValue[4] = {};
+    truncateBySintFormat(texture->m_desc.format, cmd.clearValue, truncatedClearValue);
+    uint32_t packedClearValue[4] = {};
+    packIntFunc(truncatedClearValue, packedClearValue);
+    clearTexture(texture, cmd.subresourceRange, packedClearValue);
 }
 
 void CommandExecutor::cmdUploadTextureData(const commands::UploadTextureData& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(ICommandEncoder, uploadTextureData);
+    TextureImpl* dst = checked_cast<TextureImpl*>(cmd.dst);
+    BufferImpl* buffer = checked_cast<BufferImpl*>(cmd.srcBuffer);
+    SubresourceRange subresourceRange = cmd.subresourceRange;
+
+    SubresourceLayout* srLayout = cmd.layouts;
+    Offset bufferOffset = cmd.srcOffset;
+
+    for (uint32_t layerOffset = 0; layerOffset < subresourceRange.layerCount; layerOffset++)
+    {
+        uint32_t layer = subresourceRange.layer + layerOffset;
+        for (uint32_t mipOffset = 0; mipOffset < subresourceRange.mipCount; mipOffset++)
+        {
+            uint32_t mip = subresourceRange.mip + mipOffset;
+
+            const TextureImpl::MipLevel& dstLevel = dst->m_mipLevels[mip];
+            copyRegion(
+                dst->getTexelPtr(layer, mip, cmd.offset),
+                dstLevel.pitches[1],
+                dstLevel.pitches[2],
+                buffer->m_data + bufferOffset,
+                srLayout->rowPitch,
+                srLayout->slicePitch,
+                size_t(srLayout->size.width) * dst->m_texelSize,
+                srLayout->size.height,
+                srLayout->size.depth,
+                m_device->m_singleThreaded
+            );
+
+            bufferOffset += srLayout->sizeInBytes;
+            srLayout++;
+        }
+    }
 }
 
 void CommandExecutor::cmdResolveQuery(const commands::ResolveQuery& cmd)
@@ -217,21 +363,20 @@ void CommandExecutor::cmdDispatchCompute(const commands::DispatchCompute& cmd)
     if (!m_computeStateValid)
         return;
 
-    slang_prelude::ComputeVaryingInput varyingInput;
-    varyingInput.startGroupID.x = 0;
-    varyingInput.startGroupID.y = 0;
-    varyingInput.startGroupID.z = 0;
-    varyingInput.endGroupID.x = cmd.x;
-    varyingInput.endGroupID.y = cmd.y;
-    varyingInput.endGroupID.z = cmd.z;
-
-    m_computePipeline->m_func(&varyingInput, m_bindingData->entryPoints[0].data, m_bindingData->globalData);
+    dispatchCompute(cmd.x, cmd.y, cmd.z);
 }
 
 void CommandExecutor::cmdDispatchComputeIndirect(const commands::DispatchComputeIndirect& cmd)
 {
-    SLANG_UNUSED(cmd);
-    NOT_SUPPORTED(IComputePassEncoder, dispatchComputeIndirect);
+    if (!m_computeStateValid)
+        return;
+
+    // The arguments are read at execution time so that previously executed commands can write them.
+    BufferImpl* argBuffer = checked_cast<BufferImpl*>(cmd.argBuffer.buffer);
+    IndirectDispatchArguments args;
+    std::memcpy(&args, argBuffer->m_data + cmd.argBuffer.offset, sizeof(IndirectDispatchArguments));
+
+    dispatchCompute(args.threadGroupCountX, args.threadGroupCountY, args.threadGroupCountZ);
 }
 
 void CommandExecutor::cmdBeginRayTracingPass(const commands::BeginRayTracingPass& cmd)
@@ -329,6 +474,92 @@ void CommandExecutor::cmdExecuteCallback(const commands::ExecuteCallback& cmd)
     invokeExecuteCallback(cmd, {});
 }
 
+void CommandExecutor::dispatchCompute(uint32_t x, uint32_t y, uint32_t z)
+{
+    uint64_t groupCount = uint64_t(x) * y * z;
+    if (groupCount == 0)
+        return;
+
+    // Determine the number of groups executed by a single task.
+    uint64_t grainSize = m_device->m_computeGrainSize;
+    if (grainSize == 0)
+        grainSize = max(groupCount / getParallelChunkCount(), uint64_t(1));
+
+    // Split the dispatch into tiles of roughly grainSize groups, sliced along x first, then y, then z.
+    uint32_t tileX = x;
+    uint32_t tileY = y;
+    uint32_t tileZ = z;
+    if (x >= grainSize)
+    {
+        tileX = uint32_t(grainSize);
+        tileY = 1;
+        tileZ = 1;
+    }
+    else if (uint64_t(x) * y >= grainSize)
+    {
+        tileY = uint32_t(max(grainSize / x, uint64_t(1)));
+        tileZ = 1;
+    }
+    else
+    {
+        tileZ = uint32_t(max(grainSize / (uint64_t(x) * y), uint64_t(1)));
+    }
+
+    uint32_t tileCountX = (x + tileX - 1) / tileX;
+    uint32_t tileCountY = (y + tileY - 1) / tileY;
+    uint32_t tileCountZ = (z + tileZ - 1) / tileZ;
+    uint64_t tileCount = uint64_t(tileCountX) * tileCountY * tileCountZ;
+
+    slang_prelude::ComputeFunc func = m_computePipeline->m_func;
+    void* entryPointData = m_bindingData->entryPoints[0].data;
+    void* globalData = m_bindingData->globalData;
+
+    parallelFor(
+        tileCount,
+        1,
+        m_device->m_singleThreaded,
+        [&](uint64_t begin, uint64_t end)
+        {
+            for (uint64_t tileIndex = begin; tileIndex < end; ++tileIndex)
+            {
+                uint32_t tx = uint32_t(tileIndex % tileCountX);
+                uint32_t ty = uint32_t((tileIndex / tileCountX) % tileCountY);
+                uint32_t tz = uint32_t(tileIndex / (uint64_t(tileCountX) * tileCountY));
+
+                slang_prelude::ComputeVaryingInput varyingInput;
+                varyingInput.startGroupID.x = tx * tileX;
+                varyingInput.startGroupID.y = ty * tileY;
+                varyingInput.startGroupID.z = tz * tileZ;
+                varyingInput.endGroupID.x = min(varyingInput.startGroupID.x + tileX, x);
+                varyingInput.endGroupID.y = min(varyingInput.startGroupID.y + tileY, y);
+                varyingInput.endGroupID.z = min(varyingInput.startGroupID.z + tileZ, z);
+
+                func(&varyingInput, entryPointData, globalData);
+            }
+        }
+    );
+}
+
+void CommandExecutor::clearTexture(TextureImpl* texture, SubresourceRange subresourceRange, const void* clearValue)
+{
+    // Each subresource is stored contiguously and can be filled in a single pass.
+    for (uint32_t layerOffset = 0; layerOffset < subresourceRange.layerCount; layerOffset++)
+    {
+        uint32_t layer = subresourceRange.layer + layerOffset;
+        for (uint32_t mipOffset = 0; mipOffset < subresourceRange.mipCount; mipOffset++)
+        {
+            uint32_t mip = subresourceRange.mip + mipOffset;
+            fillPattern(
+                texture->getTexelPtr(layer, mip, {0, 0, 0}),
+                size_t(texture->m_mipLevels[mip].pitches[3]),
+                clearValue,
+                texture->m_texelSize,
+                m_device->m_singleThreaded
+            );
+        }
+    }
+}
+
 // CommandQueueImpl
 
 CommandQueueImpl::CommandQueueImpl(Device* device, QueueType type)
@@ -336,6 +567,104 @@ CommandQueueImpl::CommandQueueImpl(Device* device, QueueType type)
 {
 }
 
+CommandQueueImpl::~CommandQueueImpl()
+{
+    stopThread();
+}
+
+void CommandQueueImpl::startThread()
+{
+    SLANG_RHI_ASSERT(!m_thread.joinable());
+    m_threadStop = false;
+    m_thread = std::thread(
+        [this]()
+        {
+            threadFunc();
+        }
+    );
+}
+
+void CommandQueueImpl::stopThread()
+{
+    if (!m_thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threadStop = true;
+    }
+    m_submitCondition.notify_one();
+    m_thread.join();
+}
+
+void CommandQueueImpl::threadFunc()
+{
+    while (true)
+    {
+        Submission submission;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_submitCondition.wait(
+                lock,
+                [&]()
+                {
+                    return m_threadStop || !m_submissions.empty();
+                }
+            );
+            // Pending submissions are drained before the thread exits.
+            if (m_submissions.empty())
+                return;
+            submission = std::move(m_submissions.front());
+            m_submissions.pop_front();
+        }
+
+        Result result = executeSubmission(submission);
+        if (SLANG_FAILED(result))
+            getDevice<DeviceImpl>()->printError(
+                "Failed to execute submission %llu",
+                (unsigned long long)submission.submissionID
+            );
+
+        // Release the command buffers before reporting completion.
+        submission.commandBuffers.clear();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_lastFinishedID = submission.submissionID;
+            if (SLANG_FAILED(result) && SLANG_SUCCEEDED(m_executionError))
+                m_executionError = result;
+        }
+        m_finishCondition.notify_all();
+    }
+}
+
+Result CommandQueueImpl::executeSubmission(const Submission& submission)
+{
+    // Wait for fences. This only blocks the queue thread.
+    for (const auto& [fence, value] : submission.waitFences)
+    {
+        fence->waitForValue(value);
+    }
+
+    // Execute command buffers.
+    Result result = SLANG_OK;
+    for (const auto& commandBuffer : submission.commandBuffers)
+    {
+        CommandExecutor executor(getDevice<DeviceImpl>(), submission.submissionID);
+        result = executor.execute(commandBuffer);
+        if (SLANG_FAILED(result))
+            break;
+    }
+
+    // Signal fences even if execution failed, otherwise threads waiting on them would hang forever.
+    for (const auto& [fence, value] : submission.signalFences)
+    {
+        Result signalResult = fence->setCurrentValue(value);
+        if (SLANG_SUCCEEDED(result))
+            result = signalResult;
+    }
+
+    return result;
+}
+
 Result CommandQueueImpl::createCommandEncoder(const CommandEncoderDesc& desc, ICommandEncoder** outEncoder)
 {
     RefPtr<CommandEncoderImpl> encoder = new CommandEncoderImpl(m_device, desc);
@@ -346,39 +675,100 @@ Result CommandQueueImpl::createCommandEncoder(const CommandEncoderDesc& desc, IC
 
 Result CommandQueueImpl::submit(const SubmitDesc& desc)
 {
+    if (m_thread.joinable())
+    {
+        Submission submission;
+        submission.commandBuffers.reserve(desc.commandBufferCount);
+        for (uint32_t i = 0; i < desc.commandBufferCount; i++)
+        {
+            submission.commandBuffers.push_back(checked_cast<CommandBufferImpl*>(desc.commandBuffers[i]));
+        }
+        for (uint32_t i = 0; i < desc.waitFenceCount; ++i)
+        {
+            submission.waitFences.push_back({checked_cast<FenceImpl*>(desc.waitFences[i]), desc.waitFenceValues[i]});
+        }
+        for (uint32_t i = 0; i < desc.signalFenceCount; ++i)
+        {
+            submission.signalFences.push_back(
+                {checked_cast<FenceImpl*>(desc.signalFences[i]), desc.signalFenceValues[i]}
+            );
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            submission.submissionID = ++m_lastSubmittedID;
+            m_submissions.push_back(std::move(submission));
+        }
+        m_submitCondition.notify_one();
+        return SLANG_OK;
+    }
+
     // Wait for fences.
     for (uint32_t i = 0; i < desc.waitFenceCount; ++i)
     {
-        // TODO: wait for fence
         uint64_t fenceValue;
         SLANG_RETURN_ON_FAIL(desc.waitFences[i]->getCurrentValue(&fenceValue));
         if (fenceValue < desc.waitFenceValues[i])
         {
+            // Waiting would block the submitting thread forever.
             return SLANG_FAIL;
         }
     }
 
-    ++m_lastSubmittedID;
+    uint64_t submissionID;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        submissionID = ++m_lastSubmittedID;
+    }
 
     // Execute command buffers.
-    for (uint32_t i = 0; i < desc.commandBufferCount; i++)
+    Result result = SLANG_OK;
+    for (uint32_t i = 0; i < desc.commandBufferCount && SLANG_SUCCEEDED(result); i++)
     {
-        CommandExecutor executor(getDevice<DeviceImpl>(), m_lastSubmittedID);
-        SLANG_RETURN_ON_FAIL(executor.execute(checked_cast<CommandBufferImpl*>(desc.commandBuffers[i])));
+        CommandExecutor executor(getDevice<DeviceImpl>(), submissionID);
+        result = executor.execute(checked_cast<CommandBufferImpl*>(desc.commandBuffers[i]));
     }
 
-    // Signal fences.
+    // Signal fences even if execution failed, otherwise threads waiting on them would hang forever.
     for (uint32_t i = 0; i < desc.signalFenceCount; ++i)
     {
-        SLANG_RETURN_ON_FAIL(desc.signalFences[i]->setCurrentValue(desc.signalFenceValues[i]));
+        Result signalResult = desc.signalFences[i]->setCurrentValue(desc.signalFenceValues[i]);
+        if (SLANG_SUCCEEDED(result))
+            result = signalResult;
     }
 
-    return SLANG_OK;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastFinishedID = submissionID;
+    }
+
+    return result;
+}
+
+void CommandQueueImpl::waitForIdle()
+{
+    // Submits execute synchronously when no queue thread is running.
+    if (!m_thread.joinable())
+        return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finishCondition.wait(
+        lock,
+        [&]()
+        {
+            return m_lastFinishedID >= m_lastSubmittedID;
+        }
+    );
 }
 
 Result CommandQueueImpl::waitOnHost()
 {
-    return SLANG_OK;
+    waitForIdle();
+
+    // Report the first failed submission since the last wait.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Result result = m_executionError;
+    m_executionError = SLANG_OK;
+    return result;
 }
 
 Result CommandQueueImpl::getNativeHandle(NativeHandle* outHandle)
@@ -416,11 +806,12 @@ CommandEncoderImpl::CommandEncoderImpl(Device* device, const CommandEncoderDesc&
 
 Result CommandEncoderImpl::getBindingData(RootShaderObject* rootObject, BindingData*& outBindingData)
 {
-    rootObject->trackResources(m_commandBuffer->m_trackedObjects);
     BindingDataBuilder builder;
     builder.m_device = getDevice<DeviceImpl>();
     builder.m_bindingCache = &m_commandBuffer->m_bindingCache;
     builder.m_allocator = &m_commandBuffer->m_allocator;
+    builder.m_trackedObjects = &m_commandBuffer->m_trackedObjects;
+    builder.m_bindingDataReuseCount = &m_commandBuffer->m_bindingDataReuseCount;
     ShaderObjectLayout* specializedLayout = nullptr;
     SLANG_RETURN_ON_FAIL(rootObject->getSpecializedLayout(specializedLayout));
     return builder.bindAsRoot(
@@ -437,10 +828,27 @@ Result CommandEncoderImpl::init()
     return SLANG_OK;
 }
 
+Result CommandEncoderImpl::createChildEncoderImpl(CommandEncoder** outEncoder)
+{
+    RefPtr<CommandEncoderImpl> encoder = new CommandEncoderImpl(m_device, m_desc);
+    SLANG_RETURN_ON_FAIL(encoder->init());
+    returnRefPtr(outEncoder, encoder);
+    return SLANG_OK;
+}
+
+Result CommandEncoderImpl::detachCommandBuffer(CommandBuffer** outCommandBuffer)
+{
+    returnRefPtrMove(outCommandBuffer, m_commandBuffer);
+    m_commandList = nullptr;
+    return SLANG_OK;
+}
+
 Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer** outCommandBuffer)
 {
+    SLANG_RETURN_ON_FAIL(finishChildEncoders(m_commandBuffer));
     m_commandBuffer->setDesc(desc);
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
+    m_commandBuffer->optimizeCommands();
     returnComPtr(outCommandBuffer, m_commandBuffer);
     m_commandBuffer = nullptr;
     m_commandList = nullptr;
@@ -460,6 +868,12 @@ CommandBufferImpl::CommandBufferImpl(Device* device)
 {
 }
 
+Result CommandBufferImpl::reset()
+{
+    m_bindingCache.reset();
+    return CommandBuffer::reset();
+}
+
 Result CommandBufferImpl::getNativeHandle(NativeHandle* outHandle)
 {
     *outHandle = {};
@@ -2,16 +2,58 @@
 
 #include "cpu-base.h"
 #include "cpu-device.h"
+#include "cpu-fence.h"
 #include "cpu-shader-object.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 namespace rhi::cpu {
 
 class CommandQueueImpl : public CommandQueue
 {
 public:
+    /// A submit recorded for execution on the queue thread.
+    struct Submission
+    {
+        uint64_t submissionID;
+        std::vector<RefPtr<CommandBufferImpl>> commandBuffers;
+        std::vector<std::pair<RefPtr<FenceImpl>, uint64_t>> waitFences;
+        std::vector<std::pair<RefPtr<FenceImpl>, uint64_t>> signalFences;
+    };
+
     uint64_t m_lastSubmittedID = 0;
+    uint64_t m_lastFinishedID = 0;
+    /// First error of a submission executed on the queue thread, returned by the next `waitOnHost()`.
+    Result m_executionError = SLANG_OK;
+
+    /// Queue thread, only running in asynchronous mode.
+    std::thread m_thread;
+    bool m_threadStop = false;
+    std::deque<Submission> m_submissions;
+    /// Guards m_lastSubmittedID, m_lastFinishedID, m_executionError, m_threadStop and m_submissions.
+    std::mutex m_mutex;
+    /// Notified when a submission is pushed or the thread is stopped.
+    std::condition_variable m_submitCondition;
+    /// Notified when a submission has finished executing.
+    std::condition_variable m_finishCondition;
 
     CommandQueueImpl(Device* device, QueueType type);
+    ~CommandQueueImpl();
+
+    /// Start executing submits asynchronously on a dedicated queue thread.
+    void startThread();
+    /// Drain all pending submits and stop the queue thread.
+    void stopThread();
+
+    void threadFunc();
+    Result executeSubmission(const Submission& submission);
+
+    /// Wait until all submits have finished executing.
+    /// Unlike `waitOnHost()`, this leaves `m_executionError` to be reported to the application.
+    void waitForIdle();
 
     // ICommandQueue implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL createCommandEncoder(
@@ -34,6 +76,8 @@ public:
     Result init();
 
     virtual Result getBindingData(RootShaderObject* rootObject, BindingData*& outBindingData) override;
+    virtual Result createChildEncoderImpl(CommandEncoder** outEncoder) override;
+    virtual Result detachCommandBuffer(CommandBuffer** outCommandBuffer) override;
 
     // ICommandEncoder implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(
@@ -50,6 +94,8 @@ public:
 
     CommandBufferImpl(Device* device);
 
+    virtual Result reset() override;
+
     // ICommandBuffer implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
 };
@@ -9,12 +9,38 @@
 
 namespace rhi::cpu {
 
-DeviceImpl::~DeviceImpl() {}
+DeviceImpl::~DeviceImpl()
+{
+    // Finish all pending work while the device is still fully alive.
+    if (m_queue)
+        m_queue->stopThread();
+}
 
 Result DeviceImpl::initialize(const DeviceDesc& desc, BackendImpl* backend)
 {
     SLANG_RETURN_ON_FAIL(Device::initialize(desc));
 
+    // Process chained descs
+    for (const DescStructHeader* header = static_cast<const DescStructHeader*>(desc.next); header;
+         header = header->next)
+    {
+        switch (header->type)
+        {
+        case StructType::CPUDeviceExtendedDesc:
+        {
+            auto extendedDesc = reinterpret_cast<const CPUDeviceExtendedDesc*>(header);
+            m_computeGrainSize = extendedDesc->computeGrainSize;
+            m_singleThreaded = extendedDesc->singleThreaded;
+            m_asyncQueue = extendedDesc->asyncQueue;
+            m_fenceSpinCount = extendedDesc->fenceSpinCount;
+            m_heapHugePages = extendedDesc->heapHugePages;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
     // Initialize device info
     {
         m_info.deviceType = DeviceType::CPU;
@@ -30,6 +56,7 @@ Result DeviceImpl::initialize(const DeviceDesc& desc, BackendImpl* backend)
     addFeature(Feature::TimestampQuery);
     addFeature(Feature::TimestampCalibration);
     addFeature(Feature::Pointer);
+    addFeature(Feature::CustomBorderColor);
 
     addCapability(Capability::cpp);
 
@@ -63,6 +90,8 @@ Result DeviceImpl::initialize(const DeviceDesc& desc, BackendImpl* backend)
 
     m_queue = new CommandQueueImpl(this, QueueType::Graphics);
     m_queue->setInternalReferenceCount(1);
+    if (m_asyncQueue)
+        m_queue->startThread();
 
     SLANG_RETURN_ON_FAIL(checkRequiredFeatures(desc));
 
@@ -121,13 +150,6 @@ Result DeviceImpl::createShaderProgram(
     return SLANG_OK;
 }
 
-Result DeviceImpl::createSampler(const SamplerDesc& desc, ISampler** outSampler)
-{
-    SLANG_UNUSED(desc);
-    *outSampler = nullptr;
-    return SLANG_OK;
-}
-
 Result DeviceImpl::getQueue(QueueType type, ICommandQueue** outQueue)
 {
     if (type != QueueType::Graphics)
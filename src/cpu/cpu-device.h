@@ -12,6 +12,12 @@ class DeviceImpl : public Device
 public:
     using Device::readBuffer;
 
+    virtual bool canCreatePipelineOnTaskPool(const Pipeline* pipeline) const override
+    {
+        SLANG_UNUSED(pipeline);
+        return true;
+    }
+
     ~DeviceImpl();
 
     Result initialize(const DeviceDesc& desc, BackendImpl* backend);
@@ -86,6 +92,8 @@ public:
 
     virtual SLANG_NO_THROW Result SLANG_MCALL createFence(const FenceDesc& desc, IFence** outFence) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL createHeap(const HeapDesc& desc, IHeap** outHeap) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL waitForFences(
         uint32_t fenceCount,
         IFence** fences,
@@ -96,6 +104,20 @@ public:
 
     void customizeShaderObject(ShaderObject* shaderObject) override;
 
+    CommandQueueImpl* getQueueImpl() const { return m_queue; }
+
+public:
+    /// Number of thread groups per task for compute dispatches (0 = automatic).
+    uint32_t m_computeGrainSize = 0;
+    /// Execute all work on the submitting thread.
+    bool m_singleThreaded = false;
+    /// Execute submits on a dedicated queue thread.
+    bool m_asyncQueue = false;
+    /// Number of polling iterations before a fence wait sleeps.
+    uint32_t m_fenceSpinCount = 64;
+    /// Request huge pages for heap page memory.
+    bool m_heapHugePages = false;
+
 private:
     RefPtr<CommandQueueImpl> m_queue;
 };
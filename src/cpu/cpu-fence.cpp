@@ -24,9 +24,46 @@ Result FenceImpl::setCurrentValue(uint64_t value)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_currentValue = value;
+    // Waiters are notified while holding the fence lock so they cannot unregister concurrently.
+    for (FenceWaiter* waiter : m_waiters)
+    {
+        waiter->notify();
+    }
     return SLANG_OK;
 }
 
+uint64_t FenceImpl::getValue()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_currentValue;
+}
+
+void FenceImpl::addWaiter(FenceWaiter* waiter)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_waiters.push_back(waiter);
+}
+
+void FenceImpl::removeWaiter(FenceWaiter* waiter)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < m_waiters.size(); ++i)
+    {
+        if (m_waiters[i] == waiter)
+        {
+            m_waiters[i] = m_waiters.back();
+            m_waiters.pop_back();
+            break;
+        }
+    }
+}
+
+void FenceImpl::waitForValue(uint64_t value)
+{
+    FenceImpl* fence = this;
+    waitForFenceValues(1, &fence, &value, true, kTimeoutInfinite, getDevice<DeviceImpl>()->m_fenceSpinCount);
+}
+
 Result FenceImpl::getNativeHandle(NativeHandle* outHandle)
 {
     return SLANG_E_NOT_AVAILABLE;
@@ -45,52 +82,122 @@ Result DeviceImpl::createFence(const FenceDesc& desc, IFence** outFence)
     return SLANG_OK;
 }
 
-Result DeviceImpl::waitForFences(
+void FenceWaiter::notify()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        notified = true;
+    }
+    condition.notify_one();
+}
+
+static bool isWaitSatisfied(
     uint32_t fenceCount,
-    IFence** fences,
+    FenceImpl* const* fences,
+    const uint64_t* fenceValues,
+    bool waitForAll
+)
+{
+    uint32_t reachedCount = 0;
+    for (uint32_t i = 0; i < fenceCount; ++i)
+    {
+        if (fences[i]->getValue() >= fenceValues[i])
+            reachedCount++;
+    }
+    return waitForAll ? reachedCount == fenceCount : reachedCount > 0;
+}
+
+Result waitForFenceValues(
+    uint32_t fenceCount,
+    FenceImpl* const* fences,
     const uint64_t* fenceValues,
     bool waitForAll,
-    uint64_t timeout
+    uint64_t timeout,
+    uint32_t spinCount
 )
 {
-    // List of fences we still wait on.
-    short_vector<FenceImpl*> waitFences;
-    waitFences.resize(fenceCount);
+    if (fenceCount == 0)
+        return SLANG_OK;
+
+    // Return immediately if wait condition is already met.
+    if (isWaitSatisfied(fenceCount, fences, fenceValues, waitForAll))
+        return SLANG_OK;
+    if (timeout == 0)
+        return SLANG_E_TIME_OUT;
+
+    bool infinite = timeout == kTimeoutInfinite;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(infinite ? 0 : timeout);
+
+    // Spin for a short while, fence waits are often satisfied quickly.
+    for (uint32_t i = 0; i < spinCount; ++i)
+    {
+        std::this_thread::yield();
+        if (isWaitSatisfied(fenceCount, fences, fenceValues, waitForAll))
+            return SLANG_OK;
+        if (!infinite && std::chrono::steady_clock::now() >= deadline)
+            return SLANG_E_TIME_OUT;
+    }
+
+    // Sleep until one of the fences changes or the timeout expires.
+    FenceWaiter waiter;
     for (uint32_t i = 0; i < fenceCount; ++i)
     {
-        waitFences[i] = checked_cast<FenceImpl*>(fences[i]);
+        fences[i]->addWaiter(&waiter);
     }
 
-    // Wait for all fences to be signaled.
-    size_t waitCount = waitFences.size();
-    auto startTime = std::chrono::high_resolution_clock::now();
-    auto endTime = startTime + std::chrono::nanoseconds(timeout);
-    auto currentTime = startTime;
-    while (currentTime <= endTime || timeout == kTimeoutInfinite)
+    Result result = SLANG_OK;
+    while (true)
     {
-        for (uint32_t i = 0; i < fenceCount && waitFences[i]; ++i)
+        // Reset the notification before checking the fences to not miss a concurrent update.
         {
-            FenceImpl* fence = waitFences[i];
-            uint64_t value;
-            SLANG_RETURN_ON_FAIL(fence->getCurrentValue(&value));
-            if (value >= fenceValues[i])
-            {
-                waitFences[i] = nullptr;
-                waitCount--;
-            }
+            std::lock_guard<std::mutex> lock(waiter.mutex);
+            waiter.notified = false;
         }
+        if (isWaitSatisfied(fenceCount, fences, fenceValues, waitForAll))
+            break;
 
-        // Return immediately if wait condition is already met.
-        if (waitCount == 0 || (!waitForAll && waitCount < fenceCount))
+        std::unique_lock<std::mutex> lock(waiter.mutex);
+        auto predicate = [&]()
         {
-            return SLANG_OK;
+            return waiter.notified;
+        };
+        if (infinite)
+        {
+            waiter.condition.wait(lock, predicate);
         }
+        else if (!waiter.condition.wait_until(lock, deadline, predicate))
+        {
+            lock.unlock();
+            if (!isWaitSatisfied(fenceCount, fences, fenceValues, waitForAll))
+                result = SLANG_E_TIME_OUT;
+            break;
+        }
+    }
 
-        std::this_thread::yield();
-        currentTime = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < fenceCount; ++i)
+    {
+        fences[i]->removeWaiter(&waiter);
+    }
+
+    return result;
+}
+
+Result DeviceImpl::waitForFences(
+    uint32_t fenceCount,
+    IFence** fences,
+    const uint64_t* fenceValues,
+    bool waitForAll,
+    uint64_t timeout
+)
+{
+    short_vector<FenceImpl*> waitFences;
+    waitFences.resize(fenceCount);
+    for (uint32_t i = 0; i < fenceCount; ++i)
+    {
+        waitFences[i] = checked_cast<FenceImpl*>(fences[i]);
     }
 
-    return SLANG_E_TIME_OUT;
+    return waitForFenceValues(fenceCount, waitFences.data(), fenceValues, waitForAll, timeout, m_fenceSpinCount);
 }
 
 } // namespace rhi::cpu
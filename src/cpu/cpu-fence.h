@@ -2,19 +2,41 @@
 
 #include "cpu-base.h"
 
+#include <condition_variable>
 #include <mutex>
 
 namespace rhi::cpu {
 
+/// A thread blocked on one or more fences.
+/// Registered with each fence it waits on and notified whenever one of their values changes.
+struct FenceWaiter
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool notified = false;
+
+    void notify();
+};
+
 class FenceImpl : public Fence
 {
 public:
     uint64_t m_currentValue;
     std::mutex m_mutex;
+    /// Threads currently sleeping on this fence (guarded by m_mutex).
+    short_vector<FenceWaiter*> m_waiters;
 
     FenceImpl(Device* device, const FenceDesc& desc);
     ~FenceImpl();
 
+    uint64_t getValue();
+
+    void addWaiter(FenceWaiter* waiter);
+    void removeWaiter(FenceWaiter* waiter);
+
+    /// Block the calling thread until the fence has reached the given value.
+    void waitForValue(uint64_t value);
+
     // IFence implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL getCurrentValue(uint64_t* outValue) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL setCurrentValue(uint64_t value) override;
@@ -22,4 +44,16 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL getSharedHandle(NativeHandle* outHandle) override;
 };
 
+/// Wait for a set of fences to reach the given values.
+/// Polls the fences `spinCount` times before putting the calling thread to sleep.
+/// Returns SLANG_E_TIME_OUT if the wait condition is not met within `timeout` nanoseconds.
+Result waitForFenceValues(
+    uint32_t fenceCount,
+    FenceImpl* const* fences,
+    const uint64_t* fenceValues,
+    bool waitForAll,
+    uint64_t timeout,
+    uint32_t spinCount
+);
+
 } // namespace rhi::cpu
@@ -0,0 +1,201 @@
+#include "cpu-heap.h"
+#include "cpu-device.h"
+#include "cpu-command.h"
+
+#include "core/common.h"
+
+#if SLANG_WINDOWS_FAMILY
+#include <windows.h>
+#elif SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
+#include <sys/mman.h>
+#endif
+
+#include <cstdlib>
+
+namespace rhi::cpu {
+
+// Size of the pages used to back heap memory when huge pages are requested.
+static const Size kHugePageSize = 2 * 1024 * 1024;
+
+// Allocate zero-initialized, page aligned host memory for a heap page.
+// Memory is allocated from the OS directly, so physical pages are only assigned on first touch.
+// On Windows the whole page is committed up front and counts against the commit limit.
+static uint8_t* allocateHostPage(Size size, bool hugePages, bool& outIsMapped)
+{
+    outIsMapped = true;
+#if SLANG_WINDOWS_FAMILY
+    SLANG_UNUSED(hugePages);
+    void* data = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (data)
+        return static_cast<uint8_t*>(data);
+#elif SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data != MAP_FAILED)
+    {
+#if SLANG_LINUX_FAMILY && defined(MADV_HUGEPAGE)
+        // Transparent huge pages are only a hint, failure is not an error.
+        if (hugePages && size >= kHugePageSize)
+            madvise(data, size, MADV_HUGEPAGE);
+#else
+        SLANG_UNUSED(hugePages);
+#endif
+        return static_cast<uint8_t*>(data);
+    }
+#else
+    SLANG_UNUSED(hugePages);
+#endif
+    // Fall back to the C allocator.
+    outIsMapped = false;
+    return static_cast<uint8_t*>(std::calloc(1, size));
+}
+
+static void freeHostPage(uint8_t* data, Size size, bool isMapped)
+{
+    if (!isMapped)
+    {
+        std::free(data);
+        return;
+    }
+#if SLANG_WINDOWS_FAMILY
+    SLANG_UNUSED(size);
+    VirtualFree(data, 0, MEM_RELEASE);
+#elif SLANG_LINUX_FAMILY || SLANG_APPLE_FAMILY
+    munmap(data, size);
+#else
+    SLANG_UNUSED(size);
+#endif
+}
+
+HeapImpl::PageImpl::PageImpl(Heap* heap, const PageDesc& desc, uint8_t* data, bool isMapped)
+    : Heap::Page(heap, desc)
+    , m_data(data)
+    , m_isMapped(isMapped)
+{
+}
+
+HeapImpl::PageImpl::~PageImpl()
+{
+    freeHostPage(m_data, m_desc.size, m_isMapped);
+}
+
+HeapImpl::HeapImpl(Device* device, const HeapDesc& desc)
+    : Heap(device, desc)
+{
+}
+
+HeapImpl::~HeapImpl()
+{
+    // Pages are still referenced by work in flight, wait for it before the base class frees them.
+    if (!m_pendingFrees.empty())
+    {
+        DeviceImpl* deviceImpl = static_cast<DeviceImpl*>(getDevice());
+        deviceImpl->getQueueImpl()->waitForIdle();
+    }
+}
+
+Result HeapImpl::free(HeapAlloc allocation)
+{
+    DeviceImpl* deviceImpl = static_cast<DeviceImpl*>(getDevice());
+    CommandQueueImpl* queue = deviceImpl->getQueueImpl();
+
+    uint64_t lastSubmittedID;
+    uint64_t lastFinishedID;
+    {
+        std::lock_guard<std::mutex> lock(queue->m_mutex);
+        lastSubmittedID = queue->m_lastSubmittedID;
+        lastFinishedID = queue->m_lastFinishedID;
+    }
+
+    // Submits execute synchronously unless the queue runs asynchronously,
+    // so in the common case the queue is idle and the allocation can be retired immediately.
+    if (lastFinishedID >= lastSubmittedID)
+    {
+        return retire(allocation);
+    }
+
+    // Queue is busy, defer until the pending submissions have finished.
+    PendingFree pendingFree;
+    pendingFree.allocation = allocation;
+    pendingFree.submitIndex = lastSubmittedID;
+    m_pendingFrees.push_back(pendingFree);
+    return SLANG_OK;
+}
+
+Result HeapImpl::flush()
+{
+    DeviceImpl* deviceImpl = static_cast<DeviceImpl*>(getDevice());
+    CommandQueueImpl* queue = deviceImpl->getQueueImpl();
+
+    uint64_t lastFinishedID;
+    {
+        std::lock_guard<std::mutex> lock(queue->m_mutex);
+        lastFinishedID = queue->m_lastFinishedID;
+    }
+
+    for (auto it = m_pendingFrees.begin(); it != m_pendingFrees.end();)
+    {
+        if (it->submitIndex <= lastFinishedID)
+        {
+            SLANG_RETURN_ON_FAIL(retire(it->allocation));
+            it = m_pendingFrees.erase(it);
+        }
+        else
+        {
+            // List is ordered by submission, so we can break early
+            // when we hit the first unfinished submission
+            break;
+        }
+    }
+    return SLANG_OK;
+}
+
+Result HeapImpl::allocatePage(const PageDesc& desc, Page** outPage)
+{
+    DeviceImpl* deviceImpl = static_cast<DeviceImpl*>(getDevice());
+
+    bool isMapped = false;
+    uint8_t* data = allocateHostPage(desc.size, deviceImpl->m_heapHugePages, isMapped);
+    if (!data)
+        return SLANG_E_OUT_OF_MEMORY;
+
+    // OS pages are at least 4KB aligned, the C allocator fallback only guarantees the default alignment.
+    if (uintptr_t(data) % desc.alignment != 0)
+    {
+        freeHostPage(data, desc.size, isMapped);
+        return SLANG_E_INVALID_ARG;
+    }
+
+    *outPage = new PageImpl(this, desc, data, isMapped);
+    return SLANG_OK;
+}
+
+Result HeapImpl::freePage(Page* page)
+{
+    // PageImpl destructor releases the host memory.
+    delete page;
+    return SLANG_OK;
+}
+
+Result HeapImpl::fixUpAllocDesc(HeapAllocDesc& desc)
+{
+    if (desc.alignment == 0)
+        desc.alignment = kAlignment;
+
+    if (!math::isPowerOf2(desc.alignment))
+        return SLANG_E_INVALID_ARG;
+
+    // Host-callable kernels may use vector loads, keep allocations at least 16 byte aligned.
+    if (desc.alignment < kAlignment)
+        desc.alignment = kAlignment;
+
+    return SLANG_OK;
+}
+
+Result DeviceImpl::createHeap(const HeapDesc& desc, IHeap** outHeap)
+{
+    RefPtr<HeapImpl> heap = new HeapImpl(this, desc);
+    returnComPtr(outHeap, heap);
+    return SLANG_OK;
+}
+
+} // namespace rhi::cpu
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "cpu-base.h"
+#include "../heap.h"
+
+#include <list>
+
+namespace rhi::cpu {
+
+class HeapImpl : public Heap
+{
+public:
+    /// Minimum alignment of heap allocations, matches the alignment of CPU buffers.
+    static const Size kAlignment = 16;
+
+    struct PendingFree
+    {
+        HeapAlloc allocation;
+        uint64_t submitIndex;
+    };
+
+    class PageImpl : public Heap::Page
+    {
+    public:
+        PageImpl(Heap* heap, const PageDesc& desc, uint8_t* data, bool isMapped);
+        ~PageImpl();
+
+        /// Host pointers are used directly as device addresses by host-callable kernels.
+        DeviceAddress offsetToAddress(Size offset) override { return DeviceAddress(m_data + offset); }
+
+        uint8_t* m_data;
+        /// True if the memory was allocated with mmap/VirtualAlloc rather than the C allocator.
+        bool m_isMapped;
+    };
+
+    HeapImpl(Device* device, const HeapDesc& desc);
+    ~HeapImpl();
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL free(HeapAlloc allocation) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL flush() override;
+
+    virtual Result allocatePage(const PageDesc& desc, Page** outPage) override;
+    virtual Result freePage(Page* page) override;
+
+    // Alignments
+    virtual Result fixUpAllocDesc(HeapAllocDesc& desc) override;
+
+    std::list<PendingFree> m_pendingFrees;
+};
+
+} // namespace rhi::cpu
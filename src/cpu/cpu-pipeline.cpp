@@ -2,6 +2,10 @@
 #include "cpu-device.h"
 #include "cpu-shader-program.h"
 
+#include "core/blob.h"
+
+#include <cstdio>
+
 namespace rhi::cpu {
 
 ComputePipelineImpl::ComputePipelineImpl(Device* device, const ComputePipelineDesc& desc)
@@ -9,6 +13,11 @@ ComputePipelineImpl::ComputePipelineImpl(Device* device, const ComputePipelineDe
 {
 }
 
+ComputePipelineImpl::~ComputePipelineImpl()
+{
+    unloadSharedLibraryFromMemory(m_cachedLibrary);
+}
+
 Result ComputePipelineImpl::getNativeHandle(NativeHandle* outHandle)
 {
     *outHandle = {};
@@ -23,28 +32,109 @@ Result DeviceImpl::createComputePipeline2(const ComputePipelineDesc& desc, IComp
     uint32_t entryPointIndex = 0;
 
     auto program = checked_cast<ShaderProgramImpl*>(desc.program);
-    auto entryPointLayout = program->linkedProgram->getLayout()->getEntryPointByIndex(entryPointIndex);
-    auto entryPointName = entryPointLayout->getNameOverride();
+
+    // Layout and hash queries go through the device's Slang session.
+    // Host-callable code generation is target code compilation and runs outside of the front-end lock.
+    std::string entryPointName;
+    ComPtr<ISlangBlob> hashBlob;
+    {
+        std::lock_guard<std::mutex> frontEndLock(m_slangFrontEndMutex);
+        auto entryPointLayout = program->linkedProgram->getLayout()->getEntryPointByIndex(entryPointIndex);
+        entryPointName = entryPointLayout->getNameOverride();
+        if (m_persistentShaderCache)
+            program->linkedProgram->getEntryPointHash(entryPointIndex, targetIndex, hashBlob.writeRef());
+    }
+
+    // The persistent shader cache stores the compiled shared library.
+    // The key is the entry point hash with a suffix, so it never aliases the code cached for GPU targets.
+    ComPtr<ISlangBlob> cacheKey;
+    if (m_persistentShaderCache)
+    {
+        if (hashBlob)
+        {
+            static const char kSuffix[] = "cpu-host-callable";
+            size_t hashSize = hashBlob->getBufferSize();
+            cacheKey = OwnedBlob::create(hashSize + sizeof(kSuffix));
+            uint8_t* keyData = (uint8_t*)cacheKey->getBufferPointer();
+            ::memcpy(keyData, hashBlob->getBufferPointer(), hashSize);
+            ::memcpy(keyData + hashSize, kSuffix, sizeof(kSuffix));
+        }
+    }
 
     ComPtr<ISlangSharedLibrary> sharedLibrary;
-    ComPtr<ISlangBlob> diagnostics;
-    auto compileResult =
-        program->linkedProgram
-            ->getEntryPointHostCallable(entryPointIndex, targetIndex, sharedLibrary.writeRef(), diagnostics.writeRef());
-    if (diagnostics)
+    MemorySharedLibrary cachedLibrary;
+    slang_prelude::ComputeFunc func = nullptr;
+    size_t cacheSize = 0;
+
+    // Try loading the library from the persistent cache.
+    if (cacheKey)
     {
-        handleMessage(
-            compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-            DebugMessageSource::Slang,
-            (char*)diagnostics->getBufferPointer()
-        );
+        ComPtr<ISlangBlob> libraryBlob;
+        if (SLANG_SUCCEEDED(m_persistentShaderCache->queryCache(cacheKey, libraryBlob.writeRef())) &&
+            SLANG_SUCCEEDED(loadSharedLibraryFromMemory(
+                libraryBlob->getBufferPointer(),
+                libraryBlob->getBufferSize(),
+                cachedLibrary
+            )))
+        {
+            func = (slang_prelude::ComputeFunc)findSymbolAddressByName(cachedLibrary.handle, entryPointName.c_str());
+            if (func)
+            {
+                cacheSize = libraryBlob->getBufferSize();
+            }
+            else
+            {
+                // Stale or corrupted entry, fall back to compiling.
+                unloadSharedLibraryFromMemory(cachedLibrary);
+            }
+        }
     }
-    SLANG_RETURN_ON_FAIL(compileResult);
 
-    auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
     if (!func)
     {
-        return SLANG_FAIL;
+        ComPtr<ISlangBlob> diagnostics;
+        auto compileResult = program->linkedProgram->getEntryPointHostCallable(
+            entryPointIndex,
+            targetIndex,
+            sharedLibrary.writeRef(),
+            diagnostics.writeRef()
+        );
+        if (diagnostics)
+        {
+            handleMessage(
+                compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+                DebugMessageSource::Slang,
+                (char*)diagnostics->getBufferPointer()
+            );
+        }
+        SLANG_RETURN_ON_FAIL(compileResult);
+
+        func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName.c_str());
+        if (!func)
+        {
+            return SLANG_FAIL;
+        }
+
+        // Store the library image in the persistent cache.
+        // The image is requested separately from the host-callable library. If it is not available,
+        // the pipeline still works but is not cached.
+        if (cacheKey)
+        {
+            ComPtr<ISlangBlob> libraryBlob;
+            Result codeResult =
+                program->linkedProgram->getEntryPointCode(entryPointIndex, targetIndex, libraryBlob.writeRef());
+            if (SLANG_SUCCEEDED(codeResult) && libraryBlob && libraryBlob->getBufferSize() > 0)
+            {
+                m_persistentShaderCache->writeCache(cacheKey, libraryBlob);
+            }
+            else
+            {
+                printWarning(
+                    "No shared library image available for entry point '%s', the pipeline is not cached.",
+                    entryPointName.c_str()
+                );
+            }
+        }
     }
 
     // Report the pipeline creation time.
@@ -55,14 +145,15 @@ Result DeviceImpl::createComputePipeline2(const ComputePipelineDesc& desc, IComp
             ShaderCompilationReporter::PipelineType::Compute,
             startTime,
             Timer::now(),
-            false,
-            0
+            cachedLibrary.handle != nullptr,
+            cacheSize
         );
     }
 
     RefPtr<ComputePipelineImpl> pipeline = new ComputePipelineImpl(this, desc);
     pipeline->m_program = checked_cast<ShaderProgram*>(desc.program);
     pipeline->m_sharedLibrary = sharedLibrary;
+    pipeline->m_cachedLibrary = std::move(cachedLibrary);
     pipeline->m_func = func;
     returnComPtr(outPipeline, pipeline);
     return SLANG_OK;
@@ -2,15 +2,22 @@
 
 #include "cpu-base.h"
 
+#include "core/platform.h"
+
+#include <string>
+
 namespace rhi::cpu {
 
 class ComputePipelineImpl : public ComputePipeline
 {
 public:
     ComPtr<ISlangSharedLibrary> m_sharedLibrary;
+    /// Library loaded from the persistent shader cache (used instead of `m_sharedLibrary`).
+    MemorySharedLibrary m_cachedLibrary;
     slang_prelude::ComputeFunc m_func;
 
     ComputePipelineImpl(Device* device, const ComputePipelineDesc& desc);
+    ~ComputePipelineImpl();
 
     // IComputePipeline implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
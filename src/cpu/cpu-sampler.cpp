@@ -0,0 +1,20 @@
+#include "cpu-sampler.h"
+#include "cpu-device.h"
+
+namespace rhi::cpu {
+
+SamplerImpl::SamplerImpl(Device* device, const SamplerDesc& desc)
+    : Sampler(device, desc)
+{
+}
+
+SamplerImpl::~SamplerImpl() {}
+
+Result DeviceImpl::createSampler(const SamplerDesc& desc, ISampler** outSampler)
+{
+    RefPtr<SamplerImpl> sampler = new SamplerImpl(this, desc);
+    returnComPtr(outSampler, sampler);
+    return SLANG_OK;
+}
+
+} // namespace rhi::cpu
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "cpu-base.h"
+
+namespace rhi::cpu {
+
+class SamplerImpl : public Sampler
+{
+public:
+    SamplerImpl(Device* device, const SamplerDesc& desc);
+    ~SamplerImpl();
+};
+
+} // namespace rhi::cpu
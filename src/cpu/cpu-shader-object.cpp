@@ -2,10 +2,23 @@
 #include "cpu-device.h"
 #include "cpu-buffer.h"
 #include "cpu-texture.h"
+#include "cpu-sampler.h"
 #include "cpu-shader-object-layout.h"
 
 namespace rhi::cpu {
 
+// Combined texture-samplers hold a texture handle followed by a sampler state.
+// Returns the offset of the sampler state within the combined texture-sampler bound at `offset`.
+static size_t getCombinedSamplerOffset(ShaderObject* shaderObject, const ShaderOffset& offset)
+{
+    slang::TypeLayoutReflection* typeLayout =
+        shaderObject->m_layout->getElementTypeLayout()->getBindingRangeLeafTypeLayout(offset.bindingRangeIndex);
+    if (typeLayout->getFieldCount() >= 2)
+        return typeLayout->getFieldByIndex(1)->getOffset();
+    // Without fields in the layout, the sampler state is the trailing member.
+    return typeLayout->getSize() - sizeof(slang_prelude::SamplerState);
+}
+
 void shaderObjectSetBinding(
     ShaderObject* shaderObject,
     const ShaderOffset& offset,
@@ -39,6 +52,24 @@ void shaderObjectSetBinding(
         memcpy(dst + offset.uniformOffset, &handle, sizeof(handle));
         break;
     }
+    case slang::BindingType::Sampler:
+    {
+        // The prelude's `SamplerState` is an opaque pointer that is handed back to the texture on sampling.
+        SamplerImpl* sampler = checked_cast<SamplerImpl*>(slot.resource.get());
+        slang_prelude::SamplerState state = {sampler};
+        memcpy(dst + offset.uniformOffset, &state, sizeof(state));
+        break;
+    }
+    case slang::BindingType::CombinedTextureSampler:
+    {
+        TextureViewImpl* textureView = checked_cast<TextureViewImpl*>(slot.resource.get());
+        SamplerImpl* sampler = checked_cast<SamplerImpl*>(slot.resource2.get());
+        slang_prelude::IRWTexture* handle = textureView;
+        slang_prelude::SamplerState state = {sampler};
+        memcpy(dst + offset.uniformOffset, &handle, sizeof(handle));
+        memcpy(dst + offset.uniformOffset + getCombinedSamplerOffset(shaderObject, offset), &state, sizeof(state));
+        break;
+    }
     default:
         break;
     }
@@ -50,9 +81,26 @@ Result BindingDataBuilder::bindAsRoot(
     BindingDataImpl*& outBindingData
 )
 {
+    // Reuse the binding data if it was already built for the same, unmodified objects.
+    std::vector<ShaderObjectVersion>& objects = m_bindingCache->objects;
+    objects.clear();
+    collectObjectVersions(shaderObject, specializedLayout, objects);
+    for (size_t i = 0; i < shaderObject->m_entryPoints.size(); ++i)
+    {
+        collectObjectVersions(shaderObject->m_entryPoints[i], specializedLayout->getEntryPoint(i).layout, objects);
+    }
+    size_t objectsHash = BindingCache::hashObjects(specializedLayout, objects);
+    if (BindingDataImpl* cached = m_bindingCache->find(objectsHash, specializedLayout, objects))
+    {
+        (*m_bindingDataReuseCount)++;
+        outBindingData = cached;
+        return SLANG_OK;
+    }
+
+    // The resources only need to be tracked once, they are unchanged on a cache hit.
+    shaderObject->trackResources(*m_trackedObjects);
+
     // Create a new set of binding data to populate.
-    // TODO: In the future we should lookup the cache for existing
-    // binding data and reuse that if possible.
     m_bindingData = m_allocator->allocate<BindingDataImpl>();
 
     // Write global parameters
@@ -78,6 +126,11 @@ Result BindingDataBuilder::bindAsRoot(
         entryPointData.data = data.data;
     }
 
+    // Retain the cached objects, so that their addresses identify them while the entry exists.
+    for (const ShaderObjectVersion& object : objects)
+        m_trackedObjects->insert(object.object);
+    m_bindingCache->add(objectsHash, specializedLayout, objects, m_bindingData, m_allocator);
+
     outBindingData = m_bindingData;
 
     return SLANG_OK;
@@ -181,6 +234,83 @@ Result BindingDataBuilder::writeObjectData(
     return SLANG_OK;
 }
 
-void BindingCache::reset() {}
+void collectObjectVersions(
+    ShaderObject* shaderObject,
+    ShaderObjectLayoutImpl* specializedLayout,
+    std::vector<ShaderObjectVersion>& outVersions
+)
+{
+    outVersions.push_back({shaderObject, shaderObject->m_version});
+
+    for (const auto& subObjectRange : specializedLayout->m_subObjectRanges)
+    {
+        const auto& bindingRange = specializedLayout->m_bindingRanges[subObjectRange.bindingRangeIndex];
+        switch (bindingRange.bindingType)
+        {
+        case slang::BindingType::ConstantBuffer:
+        case slang::BindingType::ParameterBlock:
+            for (uint32_t i = 0; i < bindingRange.count; ++i)
+            {
+                ShaderObject* subObject = shaderObject->m_objects[bindingRange.subObjectIndex + i];
+                collectObjectVersions(subObject, subObjectRange.layout, outVersions);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+size_t BindingCache::hashObjects(RootShaderObjectLayoutImpl* layout, const std::vector<ShaderObjectVersion>& objects)
+{
+    size_t hash = std::hash<RootShaderObjectLayoutImpl*>()(layout);
+    for (const ShaderObjectVersion& object : objects)
+    {
+        hash_combine(hash, object.object);
+        hash_combine(hash, object.version);
+    }
+    return hash;
+}
+
+BindingDataImpl* BindingCache::find(
+    size_t hash,
+    RootShaderObjectLayoutImpl* layout,
+    const std::vector<ShaderObjectVersion>& objects
+) const
+{
+    auto it = entries.find(hash);
+    if (it == entries.end())
+        return nullptr;
+    const Entry& entry = it->second;
+    if (entry.layout != layout || entry.objectCount != objects.size())
+        return nullptr;
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        if (entry.objects[i].object != objects[i].object || entry.objects[i].version != objects[i].version)
+            return nullptr;
+    }
+    return entry.bindingData;
+}
+
+void BindingCache::add(
+    size_t hash,
+    RootShaderObjectLayoutImpl* layout,
+    const std::vector<ShaderObjectVersion>& objects,
+    BindingDataImpl* bindingData,
+    ArenaAllocator* allocator
+)
+{
+    Entry& entry = entries[hash];
+    entry.objects = allocator->allocate<ShaderObjectVersion>(objects.size());
+    ::memcpy(entry.objects, objects.data(), objects.size() * sizeof(ShaderObjectVersion));
+    entry.objectCount = objects.size();
+    entry.layout = layout;
+    entry.bindingData = bindingData;
+}
+
+void BindingCache::reset()
+{
+    entries.clear();
+}
 
 } // namespace rhi::cpu
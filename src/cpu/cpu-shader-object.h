@@ -4,6 +4,12 @@
 #include "cpu-shader-object-layout.h"
 #include "cpu-buffer.h"
 
+#include "core/ref-object-set.h"
+#include "core/short_vector.h"
+
+#include <unordered_map>
+#include <vector>
+
 namespace rhi::cpu {
 
 void shaderObjectSetBinding(
@@ -19,6 +25,8 @@ struct BindingDataBuilder
     BindingCache* m_bindingCache;
     BindingDataImpl* m_bindingData;
     ArenaAllocator* m_allocator;
+    RefObjectSet* m_trackedObjects;
+    uint32_t* m_bindingDataReuseCount;
 
     /// Bind this object as a root shader object
     Result bindAsRoot(
@@ -36,6 +44,20 @@ struct BindingDataBuilder
     Result writeObjectData(ShaderObject* shaderObject, ShaderObjectLayoutImpl* specializedLayout, ObjectData& outData);
 };
 
+/// Identity and version of a shader object, see `collectObjectVersions()`.
+struct ShaderObjectVersion
+{
+    ShaderObject* object;
+    uint32_t version;
+};
+
+/// Collect the identity and version of a shader object and all of its sub-objects, in the order they are written.
+void collectObjectVersions(
+    ShaderObject* shaderObject,
+    ShaderObjectLayoutImpl* specializedLayout,
+    std::vector<ShaderObjectVersion>& outVersions
+);
+
 struct BindingDataImpl : BindingData
 {
     void* globalData;
@@ -47,8 +69,42 @@ struct BindingDataImpl : BindingData
     uint32_t entryPointCount;
 };
 
+/// Caches binding data built within a command buffer.
+/// Binding data is looked up by the specialized layout and the identity and version of the root object, its entry
+/// points and all of its sub-objects, so repeated dispatches with unchanged objects reuse the same binding data.
+/// Cached objects are retained by the command buffer, so their addresses are not reused while they are cached.
 struct BindingCache
 {
+    struct Entry
+    {
+        RootShaderObjectLayoutImpl* layout;
+        ShaderObjectVersion* objects;
+        size_t objectCount;
+        BindingDataImpl* bindingData;
+    };
+
+    /// Cached entries, keyed by the hash of the layout and the object versions.
+    std::unordered_map<size_t, Entry> entries;
+
+    /// Scratch storage for the object versions of the root object being bound.
+    std::vector<ShaderObjectVersion> objects;
+
+    static size_t hashObjects(RootShaderObjectLayoutImpl* layout, const std::vector<ShaderObjectVersion>& objects);
+
+    BindingDataImpl* find(
+        size_t hash,
+        RootShaderObjectLayoutImpl* layout,
+        const std::vector<ShaderObjectVersion>& objects
+    ) const;
+
+    void add(
+        size_t hash,
+        RootShaderObjectLayoutImpl* layout,
+        const std::vector<ShaderObjectVersion>& objects,
+        BindingDataImpl* bindingData,
+        ArenaAllocator* allocator
+    );
+
     void reset();
 };
 
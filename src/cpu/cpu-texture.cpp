@@ -1,7 +1,10 @@
 #include "cpu-texture.h"
 #include "cpu-device.h"
+#include "cpu-sampler.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 
 namespace rhi::cpu {
 
@@ -148,6 +151,7 @@ Result TextureImpl::init(const SubresourceData* initData)
     const FormatInfo& texelInfo = getFormatInfo(format);
     uint32_t texelSize = uint32_t(texelInfo.blockSizeInBytes / texelInfo.pixelsPerBlock);
     m_texelSize = texelSize;
+    m_isIntegerFormat = texelInfo.kind == FormatKind::Integer;
 
     auto baseShapeInfo = _getBaseShapeInfo(desc.type);
     m_baseShape = baseShapeInfo;
@@ -257,6 +261,17 @@ Result TextureImpl::init(const SubresourceData* initData)
     return SLANG_OK;
 }
 
+uint8_t* TextureImpl::getTexelPtr(uint32_t layer, uint32_t mip, const Offset3D& offset)
+{
+    const MipLevel& level = m_mipLevels[mip];
+    int64_t texelOffset = level.offset;
+    texelOffset += layer * level.pitches[3];
+    texelOffset += offset.z * level.pitches[2];
+    texelOffset += offset.y * level.pitches[1];
+    texelOffset += offset.x * level.pitches[0];
+    return (uint8_t*)m_data + texelOffset;
+}
+
 Result TextureImpl::getDefaultView(ITextureView** outTextureView)
 {
     if (!m_defaultView)
@@ -314,6 +329,199 @@ void TextureViewImpl::Sample(
     SampleLevel(samplerState, coords, 0.0f, outData, dataSize);
 }
 
+/// Maps a (possibly out of range) texel coordinate into the texture using the given address mode.
+/// Returns -1 if the texel lies outside the texture and the border color should be used instead.
+inline int32_t applyAddressMode(TextureAddressingMode mode, int32_t coord, int32_t extent)
+{
+    switch (mode)
+    {
+    case TextureAddressingMode::Wrap:
+        coord %= extent;
+        return coord < 0 ? coord + extent : coord;
+    case TextureAddressingMode::ClampToEdge:
+        return coord < 0 ? 0 : (coord >= extent ? extent - 1 : coord);
+    case TextureAddressingMode::ClampToBorder:
+        return (coord < 0 || coord >= extent) ? -1 : coord;
+    case TextureAddressingMode::MirrorRepeat:
+    {
+        int32_t period = 2 * extent;
+        coord %= period;
+        if (coord < 0)
+            coord += period;
+        return coord >= extent ? period - 1 - coord : coord;
+    }
+    case TextureAddressingMode::MirrorOnce:
+        if (coord < 0)
+            coord = -1 - coord;
+        return coord >= extent ? extent - 1 : coord;
+    }
+    return 0;
+}
+
+/// Selects the cube face for a direction vector and returns the face coordinates in [0, 1].
+inline uint32_t selectCubeFace(const float* dir, float* outCoords)
+{
+    float ax = std::fabs(dir[0]);
+    float ay = std::fabs(dir[1]);
+    float az = std::fabs(dir[2]);
+    uint32_t face;
+    float ma, sc, tc;
+    if (ax >= ay && ax >= az)
+    {
+        face = dir[0] >= 0.f ? 0 : 1;
+        ma = ax;
+        sc = dir[0] >= 0.f ? -dir[2] : dir[2];
+        tc = -dir[1];
+    }
+    else if (ay >= az)
+    {
+        face = dir[1] >= 0.f ? 2 : 3;
+        ma = ay;
+        sc = dir[0];
+        tc = dir[1] >= 0.f ? dir[2] : -dir[2];
+    }
+    else
+    {
+        face = dir[2] >= 0.f ? 4 : 5;
+        ma = az;
+        sc = dir[2] >= 0.f ? dir[0] : -dir[0];
+        tc = -dir[1];
+    }
+    float invMa = ma > 0.f ? 0.5f / ma : 0.f;
+    outCoords[0] = sc * invMa + 0.5f;
+    outCoords[1] = tc * invMa + 0.5f;
+    return face;
+}
+
+inline uint32_t selectArrayIndex(float coord, uint32_t count)
+{
+    float index = std::floor(coord + 0.5f);
+    if (!(index > 0.f))
+        return 0;
+    return index >= float(count) ? count - 1 : uint32_t(index);
+}
+
+struct SampleParams
+{
+    const SamplerDesc* samplerDesc;
+    TextureAddressingMode addressModes[3];
+    int32_t rank;
+    bool linear;
+};
+
+/// Filters a single mip level of a texture subresource.
+/// Linear filtering blends the 2, 4 or 8 texels around the sample position (1D, 2D, 3D).
+/// The per-texel work is a plain float4 multiply-add so the compiler can vectorize it.
+static void sampleMipLevel(
+    TextureImpl* texture,
+    const SampleParams& params,
+    uint32_t layer,
+    uint32_t mip,
+    const float* coords,
+    float outValue[4]
+)
+{
+    const TextureImpl::MipLevel& mipLevel = texture->m_mipLevels[mip];
+    const uint8_t* base = (const uint8_t*)texture->m_data + mipLevel.offset + layer * mipLevel.pitches[3];
+    const SamplerDesc& samplerDesc = *params.samplerDesc;
+
+    // Compute the texel offsets and weights of the footprint along each axis.
+    // An offset of -1 denotes a texel that is replaced by the border color.
+    int64_t offsets[3][2] = {};
+    float weights[3][2] = {{1.f, 0.f}, {1.f, 0.f}, {1.f, 0.f}};
+    int32_t tapCounts[3] = {1, 1, 1};
+    for (int32_t axis = 0; axis < params.rank; ++axis)
+    {
+        int32_t extent = mipLevel.extents[axis];
+        int64_t pitch = mipLevel.pitches[axis];
+        float u = coords[axis] * float(extent);
+        if (params.linear)
+        {
+            u -= 0.5f;
+            float fu = std::floor(u);
+            int32_t i = int32_t(fu);
+            float frac = u - fu;
+            int32_t i0 = applyAddressMode(params.addressModes[axis], i, extent);
+            int32_t i1 = applyAddressMode(params.addressModes[axis], i + 1, extent);
+            offsets[axis][0] = i0 < 0 ? -1 : i0 * pitch;
+            offsets[axis][1] = i1 < 0 ? -1 : i1 * pitch;
+            weights[axis][0] = 1.f - frac;
+            weights[axis][1] = frac;
+            tapCounts[axis] = 2;
+        }
+        else
+        {
+            int32_t i = applyAddressMode(params.addressModes[axis], int32_t(std::floor(u)), extent);
+            offsets[axis][0] = i < 0 ? -1 : i * pitch;
+        }
+    }
+
+    // Integer formats are never filtered, copy the raw texel (or border color).
+    if (texture->m_isIntegerFormat)
+    {
+        if (offsets[0][0] < 0 || offsets[1][0] < 0 || offsets[2][0] < 0)
+        {
+            uint32_t border[4];
+            for (int i = 0; i < 4; ++i)
+                border[i] = uint32_t(samplerDesc.borderColor[i]);
+            ::memcpy(outValue, border, sizeof(border));
+        }
+        else
+        {
+            texture->m_formatInfo->unpackFunc(
+                base + offsets[0][0] + offsets[1][0] + offsets[2][0],
+                outValue,
+                4 * sizeof(float)
+            );
+        }
+        return;
+    }
+
+    float result[4] = {0.f, 0.f, 0.f, 0.f};
+    bool first = true;
+    for (int32_t z = 0; z < tapCounts[2]; ++z)
+    {
+        for (int32_t y = 0; y < tapCounts[1]; ++y)
+        {
+            for (int32_t x = 0; x < tapCounts[0]; ++x)
+            {
+                float weight = weights[0][x] * weights[1][y] * weights[2][z];
+                if (weight == 0.f)
+                    continue;
+
+                float texel[4];
+                if (offsets[0][x] < 0 || offsets[1][y] < 0 || offsets[2][z] < 0)
+                    ::memcpy(texel, samplerDesc.borderColor, sizeof(texel));
+                else
+                    texture->m_formatInfo->unpackFunc(
+                        base + offsets[0][x] + offsets[1][y] + offsets[2][z],
+                        texel,
+                        sizeof(texel)
+                    );
+
+                switch (samplerDesc.reductionOp)
+                {
+                case TextureReductionOp::Minimum:
+                    for (int i = 0; i < 4; ++i)
+                        result[i] = first ? texel[i] : std::min(result[i], texel[i]);
+                    break;
+                case TextureReductionOp::Maximum:
+                    for (int i = 0; i < 4; ++i)
+                        result[i] = first ? texel[i] : std::max(result[i], texel[i]);
+                    break;
+                default:
+                    for (int i = 0; i < 4; ++i)
+                        result[i] += weight * texel[i];
+                    break;
+                }
+                first = false;
+            }
+        }
+    }
+
+    ::memcpy(outValue, result, sizeof(result));
+}
+
 void TextureViewImpl::SampleLevel(
     slang_prelude::SamplerState samplerState,
     const float* coords,
@@ -322,56 +530,83 @@ void TextureViewImpl::SampleLevel(
     size_t dataSize
 )
 {
-    TextureImpl* texture = m_texture;
-    auto baseShape = texture->m_baseShape;
-    auto& desc = texture->m_desc;
-    int32_t rank = baseShape->rank;
-    int32_t baseCoordCount = baseShape->baseCoordCount;
+    static const SamplerDesc kDefaultSamplerDesc = {};
 
-    int32_t integerMipLevel = int32_t(level + 0.5f);
-    if (integerMipLevel >= desc.mipCount)
-        integerMipLevel = desc.mipCount - 1;
-    if (integerMipLevel < 0)
-        integerMipLevel = 0;
-
-    auto& mipLevelInfo = texture->m_mipLevels[integerMipLevel];
-
-    bool isArray = (desc.arrayLength > 1) || (desc.type == rhi::TextureType::TextureCube);
-    int32_t effectiveArrayElementCount = texture->m_effectiveArrayElementCount;
-    int32_t coordIndex = baseCoordCount;
-    int32_t elementIndex = 0;
-    if (isArray)
-        elementIndex = int32_t(coords[coordIndex++] + 0.5f);
-    if (elementIndex >= effectiveArrayElementCount)
-        elementIndex = effectiveArrayElementCount - 1;
-    if (elementIndex < 0)
-        elementIndex = 0;
-
-    // Note: for now we are just going to do nearest-neighbor sampling
-    //
-    int64_t texelOffset = mipLevelInfo.offset;
-    texelOffset += elementIndex * mipLevelInfo.pitches[3];
-    for (int32_t axis = 0; axis < rank; ++axis)
+    TextureImpl* texture = m_texture;
+    const TextureDesc& desc = texture->m_desc;
+    const SubresourceRange& range = m_desc.subresourceRange;
+    const SamplerDesc& samplerDesc =
+        samplerState.state ? static_cast<SamplerImpl*>(samplerState.state)->m_desc : kDefaultSamplerDesc;
+
+    SampleParams params = {};
+    params.samplerDesc = &samplerDesc;
+    params.addressModes[0] = samplerDesc.addressU;
+    params.addressModes[1] = samplerDesc.addressV;
+    params.addressModes[2] = samplerDesc.addressW;
+    params.rank = texture->m_baseShape->rank;
+
+    // Resolve the layer and the coordinates within that layer.
+    float baseCoords[3] = {};
+    uint32_t layer = range.layer;
+    switch (desc.type)
     {
-        int32_t extent = mipLevelInfo.extents[axis];
-
-        float coord = coords[axis];
-
-        // TODO: deal with wrap/clamp/repeat if `coord < 0` or `coord > 1`
+    case TextureType::TextureCube:
+    case TextureType::TextureCubeArray:
+    {
+        uint32_t face = selectCubeFace(coords, baseCoords);
+        uint32_t cubeIndex =
+            desc.type == TextureType::TextureCubeArray ? selectArrayIndex(coords[3], range.layerCount / 6) : 0;
+        layer += cubeIndex * 6 + face;
+        // Filtering across cube faces is not supported, clamp to the face instead.
+        params.addressModes[0] = TextureAddressingMode::ClampToEdge;
+        params.addressModes[1] = TextureAddressingMode::ClampToEdge;
+        break;
+    }
+    case TextureType::Texture1DArray:
+    case TextureType::Texture2DArray:
+    case TextureType::Texture2DMSArray:
+        for (int32_t axis = 0; axis < params.rank; ++axis)
+            baseCoords[axis] = coords[axis];
+        layer += selectArrayIndex(coords[params.rank], range.layerCount);
+        break;
+    default:
+        for (int32_t axis = 0; axis < params.rank; ++axis)
+            baseCoords[axis] = coords[axis];
+        break;
+    }
 
-        int32_t integerCoord = int32_t(coord * (extent - 1) + 0.5f);
+    // Compute the level of detail relative to the first mip of the view.
+    float maxLevel = float(range.mipCount - 1);
+    float lod = level + samplerDesc.mipLODBias;
+    lod = std::max(lod, samplerDesc.minLOD);
+    lod = std::min(lod, samplerDesc.maxLOD);
+    lod = std::max(lod, 0.f);
+    lod = std::min(lod, maxLevel);
 
-        if (integerCoord >= extent)
-            integerCoord = extent - 1;
-        if (integerCoord < 0)
-            integerCoord = 0;
+    TextureFilteringMode filter = lod > 0.f ? samplerDesc.minFilter : samplerDesc.magFilter;
+    params.linear = filter == TextureFilteringMode::Linear && !texture->m_isIntegerFormat;
 
-        texelOffset += integerCoord * mipLevelInfo.pitches[axis];
+    float result[4];
+    if (samplerDesc.mipFilter == TextureFilteringMode::Linear && !texture->m_isIntegerFormat)
+    {
+        uint32_t mip = uint32_t(lod);
+        float frac = lod - float(mip);
+        sampleMipLevel(texture, params, layer, range.mip + mip, baseCoords, result);
+        if (frac > 0.f)
+        {
+            float next[4];
+            sampleMipLevel(texture, params, layer, range.mip + mip + 1, baseCoords, next);
+            for (int i = 0; i < 4; ++i)
+                result[i] += frac * (next[i] - result[i]);
+        }
+    }
+    else
+    {
+        uint32_t mip = uint32_t(lod + 0.5f);
+        sampleMipLevel(texture, params, layer, range.mip + mip, baseCoords, result);
     }
 
-    auto texelPtr = (const char*)texture->m_data + texelOffset;
-
-    m_texture->m_formatInfo->unpackFunc(texelPtr, outData, dataSize);
+    ::memcpy(outData, result, std::min(dataSize, sizeof(result)));
 }
 
 void* TextureViewImpl::refAt(const uint32_t* texelCoords)
@@ -459,6 +694,9 @@ Result DeviceImpl::readTexture(
 {
     auto textureImpl = checked_cast<TextureImpl*>(texture);
 
+    // Make sure pending submits have finished writing the texture.
+    m_queue->waitForIdle();
+
     // Get src + dest buffers.
     uint8_t* srcBuffer = (uint8_t*)textureImpl->m_data;
     uint8_t* dstBuffer = (uint8_t*)outData;
@@ -472,8 +710,8 @@ Result DeviceImpl::readTexture(
     SLANG_RHI_ASSERT(mipLevelInfo.pitches[1] == layout.rowPitch);
     SLANG_RHI_ASSERT(mipLevelInfo.pitches[2] == layout.slicePitch);
 
-    // Step forward to the mip data in the texture.
-    srcBuffer += mipLevelInfo.offset;
+    // Step forward to the layer and mip data in the texture.
+    srcBuffer += mipLevelInfo.offset + layer * mipLevelInfo.pitches[3];
 
     // Copy a row at a time.
     for (int z = 0; z < layout.size.depth; z++)
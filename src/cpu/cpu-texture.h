@@ -74,10 +74,14 @@ public:
     Format getFormat() { return m_desc.format; }
     int32_t getRank() { return m_baseShape->rank; }
 
+    /// Returns a pointer to the texel at the given offset within a subresource.
+    uint8_t* getTexelPtr(uint32_t layer, uint32_t mip, const Offset3D& offset);
+
     const CPUTextureBaseShapeInfo* m_baseShape;
     const CPUTextureFormatInfo* m_formatInfo;
     int32_t m_effectiveArrayElementCount = 0;
     uint32_t m_texelSize = 0;
+    bool m_isIntegerFormat = false;
 
     struct MipLevel
     {
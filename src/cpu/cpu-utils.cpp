@@ -0,0 +1,193 @@
+#include "cpu-utils.h"
+
+#include "core/short_vector.h"
+#include "core/task-pool.h"
+
+#include <cstring>
+#include <thread>
+
+namespace rhi::cpu {
+
+// Number of bytes copied by a single task when splitting copies and fills across the task pool.
+static constexpr size_t kCopyGrainSize = 256 * 1024;
+
+// Size of the block that is replicated when filling memory with a pattern.
+static constexpr size_t kFillBlockSize = 4096;
+
+uint64_t getParallelChunkCount()
+{
+    // Oversubscribe the workers to balance uneven chunk costs.
+    static const uint64_t chunkCount = max(uint64_t(std::thread::hardware_concurrency()), uint64_t(1)) * 4;
+    return chunkCount;
+}
+
+void parallelFor(uint64_t count, uint64_t grainSize, bool singleThreaded, ParallelForFunc func, void* context)
+{
+    if (count == 0)
+        return;
+
+    grainSize = max(grainSize, uint64_t(1));
+    uint64_t chunkCount = min((count + grainSize - 1) / grainSize, getParallelChunkCount());
+    if (singleThreaded || chunkCount <= 1)
+    {
+        func(context, 0, count);
+        return;
+    }
+
+    struct Chunk
+    {
+        ParallelForFunc func;
+        void* context;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    short_vector<Chunk, 64> chunks(chunkCount);
+    for (uint64_t i = 0; i < chunkCount; ++i)
+    {
+        chunks[i] = {func, context, count * i / chunkCount, count * (i + 1) / chunkCount};
+    }
+
+    // Submit all but the last chunk to the task pool and execute the last one on the calling thread.
+    ITaskPool* taskPool = globalTaskPool();
+    ITaskPool::TaskGroupHandle group = taskPool->createTaskGroup();
+    for (uint64_t i = 0; i + 1 < chunkCount; ++i)
+    {
+        ITaskPool::TaskHandle handle = taskPool->submitTask(
+            [](void* payload)
+            {
+                Chunk* chunk = static_cast<Chunk*>(payload);
+                chunk->func(chunk->context, chunk->begin, chunk->end);
+            },
+            &chunks[i],
+            nullptr,
+            group
+        );
+        taskPool->releaseTask(handle);
+    }
+    const Chunk& last = chunks[chunkCount - 1];
+    last.func(last.context, last.begin, last.end);
+    taskPool->waitAndReleaseTaskGroup(group);
+}
+
+void copyRegion(
+    uint8_t* dst,
+    size_t dstRowPitch,
+    size_t dstSlicePitch,
+    const uint8_t* src,
+    size_t srcRowPitch,
+    size_t srcSlicePitch,
+    size_t rowSize,
+    uint32_t rowCount,
+    uint32_t sliceCount,
+    bool singleThreaded
+)
+{
+    if (rowSize == 0 || rowCount == 0 || sliceCount == 0)
+        return;
+
+    // Merge tightly packed rows into a single row per slice.
+    if (dstRowPitch == rowSize && srcRowPitch == rowSize)
+    {
+        rowSize *= rowCount;
+        rowCount = 1;
+    }
+
+    // Merge tightly packed slices into a single span.
+    if (rowCount == 1 && dstSlicePitch == rowSize && srcSlicePitch == rowSize)
+    {
+        size_t size = rowSize * sliceCount;
+        uint64_t chunkCount = (size + kCopyGrainSize - 1) / kCopyGrainSize;
+        parallelFor(
+            chunkCount,
+            1,
+            singleThreaded,
+            [&](uint64_t begin, uint64_t end)
+            {
+                size_t offset = begin * kCopyGrainSize;
+                size_t endOffset = min(size_t(end * kCopyGrainSize), size);
+                std::memcpy(dst + offset, src + offset, endOffset - offset);
+            }
+        );
+        return;
+    }
+
+    // Copy row by row.
+    parallelFor(
+        uint64_t(rowCount) * sliceCount,
+        max(kCopyGrainSize / rowSize, size_t(1)),
+        singleThreaded,
+        [&](uint64_t begin, uint64_t end)
+        {
+            for (uint64_t i = begin; i < end; ++i)
+            {
+                size_t slice = size_t(i / rowCount);
+                size_t row = size_t(i % rowCount);
+                std::memcpy(
+                    dst + slice * dstSlicePitch + row * dstRowPitch,
+                    src + slice * srcSlicePitch + row * srcRowPitch,
+                    rowSize
+                );
+            }
+        }
+    );
+}
+
+void fillPattern(void* dst, size_t size, const void* pattern, size_t patternSize, bool singleThreaded)
+{
+    SLANG_RHI_ASSERT(patternSize > 0 && size % patternSize == 0);
+    if (size == 0)
+        return;
+
+    uint8_t* dstBytes = static_cast<uint8_t*>(dst);
+    uint64_t chunkCount = (size + kCopyGrainSize - 1) / kCopyGrainSize;
+
+    // Use memset if the pattern is a single repeated byte.
+    const uint8_t* patternBytes = static_cast<const uint8_t*>(pattern);
+    bool isByte = true;
+    for (size_t i = 1; i < patternSize && isByte; ++i)
+        isByte = patternBytes[i] == patternBytes[0];
+    if (isByte)
+    {
+        parallelFor(
+            chunkCount,
+            1,
+            singleThreaded,
+            [&](uint64_t begin, uint64_t end)
+            {
+                size_t offset = begin * kCopyGrainSize;
+                size_t endOffset = min(size_t(end * kCopyGrainSize), size);
+                std::memset(dstBytes + offset, patternBytes[0], endOffset - offset);
+            }
+        );
+        return;
+    }
+
+    // Build a block holding a whole number of patterns by repeatedly doubling the filled range.
+    size_t blockSize = min(size, max(kFillBlockSize / patternSize, size_t(1)) * patternSize);
+    std::memcpy(dstBytes, pattern, patternSize);
+    for (size_t filled = patternSize; filled < blockSize;)
+    {
+        size_t count = min(filled, blockSize - filled);
+        std::memcpy(dstBytes + filled, dstBytes, count);
+        filled += count;
+    }
+
+    // Replicate the block over the remaining memory.
+    uint64_t blockCount = (size + blockSize - 1) / blockSize;
+    parallelFor(
+        blockCount - 1,
+        max(kCopyGrainSize / blockSize, size_t(1)),
+        singleThreaded,
+        [&](uint64_t begin, uint64_t end)
+        {
+            for (uint64_t i = begin; i < end; ++i)
+            {
+                size_t offset = size_t(i + 1) * blockSize;
+                std::memcpy(dstBytes + offset, dstBytes, min(blockSize, size - offset));
+            }
+        }
+    );
+}
+
+} // namespace rhi::cpu
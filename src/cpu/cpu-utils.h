@@ -0,0 +1,57 @@
+#pragma once
+
+#include "cpu-base.h"
+
+#include <type_traits>
+
+namespace rhi::cpu {
+
+/// Callback executing the work items in the range [begin, end).
+using ParallelForFunc = void (*)(void* context, uint64_t begin, uint64_t end);
+
+/// Execute the work items in the range [0, count) on the global task pool.
+/// The range is split into contiguous chunks of at least `grainSize` items, and the calling thread
+/// participates in the work until all chunks have completed.
+/// If `singleThreaded` is set or the range fits into a single chunk, `func` is called directly.
+void parallelFor(uint64_t count, uint64_t grainSize, bool singleThreaded, ParallelForFunc func, void* context);
+
+template<typename F>
+void parallelFor(uint64_t count, uint64_t grainSize, bool singleThreaded, F&& func)
+{
+    using FuncType = std::remove_reference_t<F>;
+    parallelFor(
+        count,
+        grainSize,
+        singleThreaded,
+        [](void* context, uint64_t begin, uint64_t end)
+        {
+            (*static_cast<FuncType*>(context))(begin, end);
+        },
+        (void*)&func
+    );
+}
+
+/// Returns the number of chunks work is split into to keep all task pool workers busy.
+uint64_t getParallelChunkCount();
+
+/// Copy `sliceCount` slices of `rowCount` rows of `rowSize` bytes between two strided memory regions.
+/// Contiguous rows and slices are merged into bulk copies and large copies are split across the
+/// global task pool.
+void copyRegion(
+    uint8_t* dst,
+    size_t dstRowPitch,
+    size_t dstSlicePitch,
+    const uint8_t* src,
+    size_t srcRowPitch,
+    size_t srcSlicePitch,
+    size_t rowSize,
+    uint32_t rowCount,
+    uint32_t sliceCount,
+    bool singleThreaded
+);
+
+/// Fill `size` bytes of memory with a repeated pattern of `patternSize` bytes.
+/// `size` must be a multiple of `patternSize`. Large fills are split across the global task pool.
+void fillPattern(void* dst, size_t size, const void* pattern, size_t patternSize, bool singleThreaded);
+
+} // namespace rhi::cpu
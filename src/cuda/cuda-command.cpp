@@ -291,6 +291,10 @@ Result CommandExecutor::execute(CommandBufferImpl* commandBuffer)
 
     // Upload constant buffer data
     commandBuffer->m_constantBufferPool.upload(m_stream);
+    for (CommandBuffer* childCommandBuffer : commandBuffer->m_childCommandBuffers)
+    {
+        checked_cast<CommandBufferImpl*>(childCommandBuffer)->m_constantBufferPool.upload(m_stream);
+    }
 
     const CommandList& commandList = commandBuffer->m_commandList;
     auto command = commandList.getCommands();
@@ -301,6 +305,7 @@ Result CommandExecutor::execute(CommandBufferImpl* commandBuffer)
         cmd##x(commandList.getCommand<commands::x>(command));                                                          \
         break;
 
+        SLANG_RHI_COMMAND_PROFILE_SCOPE(&m_device->m_commandProfiler, Execute, command->id);
         switch (command->id)
         {
             SLANG_RHI_COMMANDS(SLANG_RHI_COMMAND_EXECUTE_X);
@@ -995,6 +1000,10 @@ Result CommandQueueImpl::getOrCreateCommandBuffer(CommandBufferImpl** outCommand
 
 void CommandQueueImpl::retireCommandBuffer(CommandBufferImpl* commandBuffer)
 {
+    for (CommandBuffer* childCommandBuffer : commandBuffer->m_childCommandBuffers)
+    {
+        retireCommandBuffer(checked_cast<CommandBufferImpl*>(childCommandBuffer));
+    }
     commandBuffer->reset();
     {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -1006,6 +1015,10 @@ void CommandQueueImpl::retireCommandBuffer(CommandBufferImpl* commandBuffer)
 void CommandQueueImpl::retireCommandBufferLocked(CommandBufferImpl* commandBuffer)
 {
     // NOTE: Caller must hold m_mutex!
+    for (CommandBuffer* childCommandBuffer : commandBuffer->m_childCommandBuffers)
+    {
+        retireCommandBufferLocked(checked_cast<CommandBufferImpl*>(childCommandBuffer));
+    }
     commandBuffer->reset();
     m_commandBuffersPool.push_back(commandBuffer);
     commandBuffer->setInternalReferenceCount(1);
@@ -1056,7 +1069,9 @@ Result CommandQueueImpl::retireCommandBuffersLocked()
             break;
 
         SLANG_RETURN_ON_FAIL(resolveTimestampQueries(commandBuffer));
-        retireCommandBufferLocked(commandBuffer);
+        // Reusable command buffers keep their command list and are released with their last reference.
+        if (!commandBuffer->isReusable())
+            retireCommandBufferLocked(commandBuffer);
         cbIt = m_commandBuffersInFlight.erase(cbIt);
     }
 
@@ -1357,10 +1372,14 @@ Result CommandEncoderImpl::init()
     return SLANG_OK;
 }
 
-/// Track resources for CUDA backend, skipping device-local buffers.
+/// Track resources for CUDA backend, keeping device-local buffers separate.
 /// Device-local buffers rely on CUDA stream FIFO ordering for safe reuse.
 /// We still track textures, upload/readback buffers, and other resources.
-static void trackResourcesForCUDA(ShaderObject* shaderObject, std::set<RefPtr<RefObject>>& resources)
+static void trackResourcesForCUDA(
+    ShaderObject* shaderObject,
+    RefObjectSet& resources,
+    RefObjectSet& deviceLocalResources
+)
 {
     // Track slot resources, but skip device-local buffers
     for (const auto& slot : shaderObject->m_slots)
@@ -1374,7 +1393,8 @@ static void trackResourcesForCUDA(ShaderObject* shaderObject, std::set<RefPtr<Re
                 // Keep tracking Upload/ReadBack buffers as CPU may access them
                 if (buffer->m_desc.memoryType == MemoryType::DeviceLocal)
                 {
-                    continue; // Skip tracking - CUDA stream ordering provides safety
+                    deviceLocalResources.insert(buffer);
+                    continue;
                 }
             }
             resources.insert(slot.resource);
@@ -1391,27 +1411,32 @@ static void trackResourcesForCUDA(ShaderObject* shaderObject, std::set<RefPtr<Re
     {
         if (object)
         {
-            trackResourcesForCUDA(object, resources);
+            trackResourcesForCUDA(object, resources, deviceLocalResources);
         }
     }
 }
 
-static void trackResourcesForCUDARoot(RootShaderObject* rootObject, std::set<RefPtr<RefObject>>& resources)
+static void trackResourcesForCUDARoot(
+    RootShaderObject* rootObject,
+    RefObjectSet& resources,
+    RefObjectSet& deviceLocalResources
+)
 {
-    trackResourcesForCUDA(rootObject, resources);
+    trackResourcesForCUDA(rootObject, resources, deviceLocalResources);
     for (const auto& entryPoint : rootObject->m_entryPoints)
     {
         if (entryPoint)
         {
-            trackResourcesForCUDA(entryPoint, resources);
+            trackResourcesForCUDA(entryPoint, resources, deviceLocalResources);
         }
     }
 }
 
 Result CommandEncoderImpl::getBindingData(RootShaderObject* rootObject, BindingData*& outBindingData)
 {
-    // Skip tracking device-local buffers - CUDA stream ordering guarantees safety
-    trackResourcesForCUDARoot(rootObject, m_commandBuffer->m_trackedObjects);
+    // Device-local buffers are tracked separately - CUDA stream ordering guarantees safety
+    // unless the command buffer is reused.
+    trackResourcesForCUDARoot(rootObject, m_commandBuffer->m_trackedObjects, m_commandBuffer->m_deviceLocalObjects);
 
     BindingDataBuilder builder;
     builder.m_device = getDevice<DeviceImpl>();
@@ -1427,10 +1452,37 @@ Result CommandEncoderImpl::getBindingData(RootShaderObject* rootObject, BindingD
     );
 }
 
+Result CommandEncoderImpl::createChildEncoderImpl(CommandEncoder** outEncoder)
+{
+    RefPtr<CommandEncoderImpl> encoder = new CommandEncoderImpl(m_device, m_queue, m_desc);
+    SLANG_RETURN_ON_FAIL(encoder->init());
+    returnRefPtr(outEncoder, encoder);
+    return SLANG_OK;
+}
+
+Result CommandEncoderImpl::detachCommandBuffer(CommandBuffer** outCommandBuffer)
+{
+    returnRefPtrMove(outCommandBuffer, m_commandBuffer);
+    m_commandList = nullptr;
+    return SLANG_OK;
+}
+
 Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer** outCommandBuffer)
 {
+    SLANG_RETURN_ON_FAIL(finishChildEncoders(m_commandBuffer));
     m_commandBuffer->setDesc(desc);
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
+    m_commandBuffer->optimizeCommands();
+    // A reusable command buffer can be submitted after the user released a device-local buffer,
+    // so stream ordering alone is not enough to keep the buffer alive.
+    if (!m_commandBuffer->isReusable())
+    {
+        m_commandBuffer->m_deviceLocalObjects.clear();
+        for (CommandBuffer* childCommandBuffer : m_commandBuffer->m_childCommandBuffers)
+        {
+            checked_cast<CommandBufferImpl*>(childCommandBuffer)->m_deviceLocalObjects.clear();
+        }
+    }
     returnComPtr(outCommandBuffer, m_commandBuffer);
     m_commandBuffer = nullptr;
     m_commandList = nullptr;
@@ -1455,6 +1507,7 @@ Result CommandBufferImpl::reset()
 {
     m_bindingCache.reset();
     m_constantBufferPool.reset();
+    m_deviceLocalObjects.clear();
     m_submissionID = 0;
     m_timestampAnchorGeneration = kInvalidTimestampAnchorGeneration;
     return CommandBuffer::reset();
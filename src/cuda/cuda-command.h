@@ -101,6 +101,8 @@ public:
     Result init();
 
     virtual Result getBindingData(RootShaderObject* rootObject, BindingData*& outBindingData) override;
+    virtual Result createChildEncoderImpl(CommandEncoder** outEncoder) override;
+    virtual Result detachCommandBuffer(CommandBuffer** outCommandBuffer) override;
 
     // ICommandEncoder implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(
@@ -115,6 +117,9 @@ class CommandBufferImpl : public CommandBuffer
 public:
     BindingCache m_bindingCache;
     ConstantBufferPool m_constantBufferPool;
+    /// Device-local buffers referenced by bindings.
+    /// These are only retained while encoding, unless the command buffer is reusable.
+    RefObjectSet m_deviceLocalObjects;
     uint64_t m_submissionID = 0;
     uint64_t m_timestampAnchorGeneration = kInvalidTimestampAnchorGeneration;
 
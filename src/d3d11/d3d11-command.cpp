@@ -123,6 +123,7 @@ Result CommandExecutor::execute(CommandBufferImpl* commandBuffer)
         cmd##x(commandList.getCommand<commands::x>(command));                                                          \
         break;
 
+        SLANG_RHI_COMMAND_PROFILE_SCOPE(&m_device->m_commandProfiler, Execute, command->id);
         switch (command->id)
         {
             SLANG_RHI_COMMANDS(SLANG_RHI_COMMAND_EXECUTE_X);
@@ -1084,10 +1085,28 @@ Result CommandEncoderImpl::getBindingData(RootShaderObject* rootObject, BindingD
     );
 }
 
+Result CommandEncoderImpl::createChildEncoderImpl(CommandEncoder** outEncoder)
+{
+    RefPtr<CommandEncoderImpl> encoder = new CommandEncoderImpl(m_device, m_desc);
+    SLANG_RETURN_ON_FAIL(encoder->init());
+    returnRefPtr(outEncoder, encoder);
+    return SLANG_OK;
+}
+
+Result CommandEncoderImpl::detachCommandBuffer(CommandBuffer** outCommandBuffer)
+{
+    m_commandBuffer->m_constantBufferPool.finish();
+    returnRefPtrMove(outCommandBuffer, m_commandBuffer);
+    m_commandList = nullptr;
+    return SLANG_OK;
+}
+
 Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer** outCommandBuffer)
 {
+    SLANG_RETURN_ON_FAIL(finishChildEncoders(m_commandBuffer));
     m_commandBuffer->setDesc(desc);
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
+    m_commandBuffer->optimizeCommands();
     m_commandBuffer->m_constantBufferPool.finish();
     if (m_commandBuffer->m_commandList.writesTimestamp() && !m_commandBuffer->m_disjointQuery)
     {
@@ -170,6 +170,7 @@ Result CommandRecorder::record(CommandBufferImpl* commandBuffer)
         cmd##x(commandList.getCommand<commands::x>(slot));                                                             \
         break;
 
+        SLANG_RHI_COMMAND_PROFILE_SCOPE(&m_device->m_commandProfiler, Execute, slot->id);
         switch (slot->id)
         {
             SLANG_RHI_COMMANDS(SLANG_RHI_COMMAND_EXECUTE_X);
@@ -1959,6 +1960,10 @@ Result CommandQueueImpl::getOrCreateCommandBuffer(CommandBufferImpl** outCommand
 
 void CommandQueueImpl::retireCommandBuffer(CommandBufferImpl* commandBuffer)
 {
+    for (CommandBuffer* childCommandBuffer : commandBuffer->m_childCommandBuffers)
+    {
+        retireCommandBuffer(checked_cast<CommandBufferImpl*>(childCommandBuffer));
+    }
     commandBuffer->reset();
     {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -1977,7 +1982,9 @@ void CommandQueueImpl::retireCommandBuffers()
     {
         if (commandBuffer->m_submissionID <= lastFinishedID)
         {
-            retireCommandBuffer(commandBuffer);
+            // Reusable command buffers keep their recording and are released with their last reference.
+            if (!commandBuffer->isReusable())
+                retireCommandBuffer(commandBuffer);
         }
         else
         {
@@ -2186,8 +2193,26 @@ Result CommandEncoderImpl::getBindingData(RootShaderObject* rootObject, BindingD
     );
 }
 
+Result CommandEncoderImpl::createChildEncoderImpl(CommandEncoder** outEncoder)
+{
+    RefPtr<CommandEncoderImpl> encoder = new CommandEncoderImpl(m_device, m_queue, m_desc);
+    SLANG_RETURN_ON_FAIL(encoder->init());
+    returnRefPtr(outEncoder, encoder);
+    return SLANG_OK;
+}
+
+Result CommandEncoderImpl::detachCommandBuffer(CommandBuffer** outCommandBuffer)
+{
+    // Commands are recorded into the parent's d3d12 command list, close the unused one.
+    m_commandBuffer->m_d3dCommandList->Close();
+    returnRefPtrMove(outCommandBuffer, m_commandBuffer);
+    m_commandList = nullptr;
+    return SLANG_OK;
+}
+
 Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer** outCommandBuffer)
 {
+    SLANG_RETURN_ON_FAIL(finishChildEncoders(m_commandBuffer));
     bool hadLabel = m_commandBuffer->m_desc.label != nullptr;
     m_commandBuffer->setDesc(desc);
     if (hadLabel)
@@ -2195,6 +2220,7 @@ Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer*
         m_commandBuffer->m_d3dCommandList->SetName(m_desc.label ? string::to_wstring(m_desc.label).c_str() : nullptr);
     }
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
+    m_commandBuffer->optimizeCommands();
     CommandRecorder recorder(getDevice<DeviceImpl>());
     SLANG_RETURN_ON_FAIL(recorder.record(m_commandBuffer));
     returnComPtr(outCommandBuffer, m_commandBuffer);
@@ -81,6 +81,8 @@ public:
     Result init();
 
     virtual Result getBindingData(RootShaderObject* rootObject, BindingData*& outBindingData) override;
+    virtual Result createChildEncoderImpl(CommandEncoder** outEncoder) override;
+    virtual Result detachCommandBuffer(CommandBuffer** outCommandBuffer) override;
 
     // ICommandEncoder implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(
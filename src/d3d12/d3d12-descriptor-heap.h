@@ -4,6 +4,8 @@
 
 #include "core/offset-allocator.h"
 
+#include <set>
+
 namespace rhi::d3d12 {
 
 /// A plain D3D12 descriptor heap.
@@ -21,4 +21,30 @@ Result DebugCommandBuffer::getNativeHandle(NativeHandle* outHandle)
     return baseObject->getNativeHandle(outHandle);
 }
 
+Result DebugCommandBuffer::getStats(CommandBufferStats* outStats)
+{
+    SLANG_RHI_DEBUG_API(ICommandBuffer, getStats);
+
+    if (!outStats)
+    {
+        RHI_VALIDATION_ERROR("'outStats' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+
+    return baseObject->getStats(outStats);
+}
+
+Result DebugCommandBuffer::captureTransfers(ISlangBlob** outBlob)
+{
+    SLANG_RHI_DEBUG_API(ICommandBuffer, captureTransfers);
+
+    if (!outBlob)
+    {
+        RHI_VALIDATION_ERROR("'outBlob' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+
+    return baseObject->captureTransfers(outBlob);
+}
+
 } // namespace rhi::debug
@@ -12,9 +12,15 @@ public:
 
     SLANG_RHI_DEBUG_OBJECT_CONSTRUCTOR(DebugCommandBuffer);
 
+public:
+    /// Set once the command buffer has been submitted.
+    bool m_submitted = false;
+
 public:
     virtual SLANG_NO_THROW const CommandBufferDesc& SLANG_MCALL getDesc() override;
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getStats(CommandBufferStats* outStats) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL captureTransfers(ISlangBlob** outBlob) override;
 };
 
 } // namespace rhi::debug
@@ -1930,6 +1930,33 @@ void DebugCommandEncoder::executeCallback(const ExecuteCallbackDesc& desc)
     baseObject->executeCallback(desc);
 }
 
+Result DebugCommandEncoder::createChildEncoder(ICommandEncoder** outEncoder)
+{
+    SLANG_RHI_DEBUG_API(ICommandEncoder, createChildEncoder);
+
+    requireOpen();
+    requireNoPass();
+
+    if (m_isChildEncoder)
+    {
+        RHI_VALIDATION_ERROR("Child encoders cannot create child encoders.");
+        return SLANG_E_INVALID_ARG;
+    }
+    if (!outEncoder)
+    {
+        RHI_VALIDATION_ERROR("'outEncoder' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+
+    RefPtr<DebugCommandEncoder> encoder = new DebugCommandEncoder(ctx);
+    SLANG_RETURN_ON_FAIL(baseObject->createChildEncoder(encoder->baseObject.writeRef()));
+    encoder->m_isChildEncoder = true;
+    m_childEncoders.push_back(encoder);
+
+    returnComPtr(outEncoder, encoder);
+    return SLANG_OK;
+}
+
 Result DebugCommandEncoder::finish(const CommandBufferDesc& desc, ICommandBuffer** outCommandBuffer)
 {
     SLANG_RHI_DEBUG_API(ICommandEncoder, finish);
@@ -1937,6 +1964,22 @@ Result DebugCommandEncoder::finish(const CommandBufferDesc& desc, ICommandBuffer
     requireOpen();
     requireNoPass();
 
+    if (m_isChildEncoder)
+    {
+        RHI_VALIDATION_ERROR("Child encoders are finished together with their parent encoder.");
+        return SLANG_E_INVALID_ARG;
+    }
+    for (const auto& childEncoder : m_childEncoders)
+    {
+        if (childEncoder->m_passState != PassState::NoPass)
+        {
+            RHI_VALIDATION_ERROR("All passes of child encoders must be ended before finishing the parent encoder.");
+            return SLANG_E_INVALID_ARG;
+        }
+        childEncoder->m_state = EncoderState::Finished;
+    }
+    m_childEncoders.clear();
+
     if (!outCommandBuffer)
     {
         RHI_VALIDATION_ERROR("'outCommandBuffer' must not be null.");
@@ -294,6 +294,8 @@ public:
 
     virtual SLANG_NO_THROW void SLANG_MCALL executeCallback(const ExecuteCallbackDesc& desc) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL createChildEncoder(ICommandEncoder** outEncoder) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(
         const CommandBufferDesc& desc,
         ICommandBuffer** outCommandBuffer
@@ -324,6 +326,9 @@ public:
     EncoderState m_state = EncoderState::Open;
     PassState m_passState = PassState::NoPass;
 
+    bool m_isChildEncoder = false;
+    std::vector<RefPtr<DebugCommandEncoder>> m_childEncoders;
+
     DebugRenderPassEncoder m_renderPassEncoder;
     DebugComputePassEncoder m_computePassEncoder;
     DebugRayTracingPassEncoder m_rayTracingPassEncoder;
@@ -71,6 +71,16 @@ Result DebugCommandQueue::submit(const SubmitDesc& desc)
             RHI_VALIDATION_ERROR_FORMAT("'desc.commandBuffers[%u]' must not be null.", i);
             return SLANG_E_INVALID_ARG;
         }
+        DebugCommandBuffer* commandBuffer = getDebugObj(desc.commandBuffers[i]);
+        if (commandBuffer->m_submitted && !commandBuffer->getDesc().reusable)
+        {
+            RHI_VALIDATION_ERROR_FORMAT(
+                "'desc.commandBuffers[%u]' was already submitted and was not created with 'reusable'.",
+                i
+            );
+            return SLANG_E_INVALID_ARG;
+        }
+        commandBuffer->m_submitted = true;
         innerCommandBuffers.push_back(getInnerObj(desc.commandBuffers[i]));
     }
     for (uint32_t i = 0; i < desc.waitFenceCount; ++i)
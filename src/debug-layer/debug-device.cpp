@@ -980,17 +980,8 @@ Result DebugDevice::createShaderProgram(
     return baseObject->createShaderProgram(patchedDesc, outProgram, outDiagnostics);
 }
 
-Result DebugDevice::createRenderPipeline(const RenderPipelineDesc& desc, IRenderPipeline** outPipeline)
+Result DebugDevice::validatePipelineDesc(const RenderPipelineDesc& desc)
 {
-    SLANG_RHI_DEBUG_API(IDevice, createRenderPipeline);
-
-    validateCudaContext();
-
-    if (!outPipeline)
-    {
-        RHI_VALIDATION_ERROR("'outPipeline' must not be null.");
-        return SLANG_E_INVALID_ARG;
-    }
     if (desc.program == nullptr)
     {
         RHI_VALIDATION_ERROR("Program must be specified.");
@@ -1006,6 +997,41 @@ Result DebugDevice::createRenderPipeline(const RenderPipelineDesc& desc, IRender
         RHI_VALIDATION_ERROR("Metal does not support PatchList topology.");
         return SLANG_E_INVALID_ARG;
     }
+    return SLANG_OK;
+}
+
+Result DebugDevice::validatePipelineDesc(const ComputePipelineDesc& desc)
+{
+    if (desc.program == nullptr)
+    {
+        RHI_VALIDATION_ERROR("Program must be specified.");
+        return SLANG_E_INVALID_ARG;
+    }
+    return SLANG_OK;
+}
+
+Result DebugDevice::validatePipelineDesc(const RayTracingPipelineDesc& desc)
+{
+    if (desc.program == nullptr)
+    {
+        RHI_VALIDATION_ERROR("Program must be specified.");
+        return SLANG_E_INVALID_ARG;
+    }
+    return SLANG_OK;
+}
+
+Result DebugDevice::createRenderPipeline(const RenderPipelineDesc& desc, IRenderPipeline** outPipeline)
+{
+    SLANG_RHI_DEBUG_API(IDevice, createRenderPipeline);
+
+    validateCudaContext();
+
+    if (!outPipeline)
+    {
+        RHI_VALIDATION_ERROR("'outPipeline' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+    SLANG_RETURN_ON_FAIL(validatePipelineDesc(desc));
 
     RenderPipelineDesc patchedDesc = desc;
     std::string label;
@@ -1029,11 +1055,7 @@ Result DebugDevice::createComputePipeline(const ComputePipelineDesc& desc, IComp
         RHI_VALIDATION_ERROR("'outPipeline' must not be null.");
         return SLANG_E_INVALID_ARG;
     }
-    if (desc.program == nullptr)
-    {
-        RHI_VALIDATION_ERROR("Program must be specified.");
-        return SLANG_E_INVALID_ARG;
-    }
+    SLANG_RETURN_ON_FAIL(validatePipelineDesc(desc));
 
     ComputePipelineDesc patchedDesc = desc;
     std::string label;
@@ -1057,11 +1079,94 @@ Result DebugDevice::createRayTracingPipeline(const RayTracingPipelineDesc& desc,
         RHI_VALIDATION_ERROR("'outPipeline' must not be null.");
         return SLANG_E_INVALID_ARG;
     }
-    if (desc.program == nullptr)
+    SLANG_RETURN_ON_FAIL(validatePipelineDesc(desc));
+
+    RayTracingPipelineDesc patchedDesc = desc;
+    std::string label;
+    if (!patchedDesc.label)
     {
-        RHI_VALIDATION_ERROR("Program must be specified.");
+        label = createRayTracingPipelineLabel(patchedDesc);
+        patchedDesc.label = label.c_str();
+    }
+
+    return baseObject->createRayTracingPipeline(patchedDesc, outPipeline);
+}
+
+Result DebugDevice::createRenderPipelineAsync(
+    const RenderPipelineDesc& desc,
+    IRenderPipeline* fallback,
+    IRenderPipeline** outPipeline,
+    IPipelineCreationTask** outTask
+)
+{
+    SLANG_RHI_DEBUG_API(IDevice, createRenderPipelineAsync);
+
+    validateCudaContext();
+
+    if (!outPipeline)
+    {
+        RHI_VALIDATION_ERROR("'outPipeline' must not be null.");
         return SLANG_E_INVALID_ARG;
     }
+    SLANG_RETURN_ON_FAIL(validatePipelineDesc(desc));
+
+    RenderPipelineDesc patchedDesc = desc;
+    std::string label;
+    if (!patchedDesc.label)
+    {
+        label = createRenderPipelineLabel(patchedDesc);
+        patchedDesc.label = label.c_str();
+    }
+
+    return baseObject->createRenderPipelineAsync(patchedDesc, fallback, outPipeline, outTask);
+}
+
+Result DebugDevice::createComputePipelineAsync(
+    const ComputePipelineDesc& desc,
+    IComputePipeline* fallback,
+    IComputePipeline** outPipeline,
+    IPipelineCreationTask** outTask
+)
+{
+    SLANG_RHI_DEBUG_API(IDevice, createComputePipelineAsync);
+
+    validateCudaContext();
+
+    if (!outPipeline)
+    {
+        RHI_VALIDATION_ERROR("'outPipeline' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+    SLANG_RETURN_ON_FAIL(validatePipelineDesc(desc));
+
+    ComputePipelineDesc patchedDesc = desc;
+    std::string label;
+    if (!patchedDesc.label)
+    {
+        label = createComputePipelineLabel(patchedDesc);
+        patchedDesc.label = label.c_str();
+    }
+
+    return baseObject->createComputePipelineAsync(patchedDesc, fallback, outPipeline, outTask);
+}
+
+Result DebugDevice::createRayTracingPipelineAsync(
+    const RayTracingPipelineDesc& desc,
+    IRayTracingPipeline* fallback,
+    IRayTracingPipeline** outPipeline,
+    IPipelineCreationTask** outTask
+)
+{
+    SLANG_RHI_DEBUG_API(IDevice, createRayTracingPipelineAsync);
+
+    validateCudaContext();
+
+    if (!outPipeline)
+    {
+        RHI_VALIDATION_ERROR("'outPipeline' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+    SLANG_RETURN_ON_FAIL(validatePipelineDesc(desc));
 
     RayTracingPipelineDesc patchedDesc = desc;
     std::string label;
@@ -1071,7 +1176,7 @@ Result DebugDevice::createRayTracingPipeline(const RayTracingPipelineDesc& desc,
         patchedDesc.label = label.c_str();
     }
 
-    return baseObject->createRayTracingPipeline(patchedDesc, outPipeline);
+    return baseObject->createRayTracingPipelineAsync(patchedDesc, fallback, outPipeline, outTask);
 }
 
 Result DebugDevice::getCompilationReportList(ISlangBlob** outReportListBlob)
@@ -1087,6 +1192,58 @@ Result DebugDevice::getCompilationReportList(ISlangBlob** outReportListBlob)
     return baseObject->getCompilationReportList(outReportListBlob);
 }
 
+Result DebugDevice::getPipelineManifest(ISlangBlob** outManifest)
+{
+    SLANG_RHI_DEBUG_API(IDevice, getPipelineManifest);
+
+    if (!outManifest)
+    {
+        RHI_VALIDATION_ERROR("'outManifest' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+
+    return baseObject->getPipelineManifest(outManifest);
+}
+
+Result DebugDevice::precompilePipelines(IPipeline** pipelines, uint32_t pipelineCount, ISlangBlob* manifest)
+{
+    SLANG_RHI_DEBUG_API(IDevice, precompilePipelines);
+
+    if (pipelineCount > 0 && !pipelines)
+    {
+        RHI_VALIDATION_ERROR("'pipelines' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+    for (uint32_t i = 0; i < pipelineCount; ++i)
+    {
+        if (!pipelines[i])
+        {
+            RHI_VALIDATION_ERROR("'pipelines' must not contain null pointers.");
+            return SLANG_E_INVALID_ARG;
+        }
+    }
+    if (!manifest)
+    {
+        RHI_VALIDATION_ERROR("'manifest' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+
+    return baseObject->precompilePipelines(pipelines, pipelineCount, manifest);
+}
+
+Result DebugDevice::getSpecializedPipelineCacheStats(SpecializedPipelineCacheStats* outStats)
+{
+    SLANG_RHI_DEBUG_API(IDevice, getSpecializedPipelineCacheStats);
+
+    if (!outStats)
+    {
+        RHI_VALIDATION_ERROR("'outStats' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+
+    return baseObject->getSpecializedPipelineCacheStats(outStats);
+}
+
 Result DebugDevice::readTexture(
     ITexture* texture,
     uint32_t layer,
@@ -1585,6 +1742,39 @@ Result DebugDevice::reportHeaps(HeapReport* heapReports, uint32_t* heapCount)
     return baseObject->reportHeaps(heapReports, heapCount);
 }
 
+Result DebugDevice::getCommandProfile(CommandProfileEntry* entries, uint32_t* entryCount)
+{
+    SLANG_RHI_DEBUG_API(IDevice, getCommandProfile);
+
+    if (!entryCount)
+    {
+        RHI_VALIDATION_ERROR("'entryCount' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+
+    return baseObject->getCommandProfile(entries, entryCount);
+}
+
+Result DebugDevice::dumpCommandProfile(CommandProfileFormat format, ISlangBlob** outBlob)
+{
+    SLANG_RHI_DEBUG_API(IDevice, dumpCommandProfile);
+
+    if (!outBlob)
+    {
+        RHI_VALIDATION_ERROR("'outBlob' must not be null.");
+        return SLANG_E_INVALID_ARG;
+    }
+
+    return baseObject->dumpCommandProfile(format, outBlob);
+}
+
+Result DebugDevice::resetCommandProfile()
+{
+    SLANG_RHI_DEBUG_API(IDevice, resetCommandProfile);
+
+    return baseObject->resetCommandProfile();
+}
+
 Result DebugDevice::setCudaContextCurrent()
 {
     SLANG_RHI_DEBUG_API(IDevice, setCudaContextCurrent);
@@ -125,7 +125,34 @@ public:
         const RayTracingPipelineDesc& desc,
         IRayTracingPipeline** outPipeline
     ) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL createRenderPipelineAsync(
+        const RenderPipelineDesc& desc,
+        IRenderPipeline* fallback,
+        IRenderPipeline** outPipeline,
+        IPipelineCreationTask** outTask
+    ) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL createComputePipelineAsync(
+        const ComputePipelineDesc& desc,
+        IComputePipeline* fallback,
+        IComputePipeline** outPipeline,
+        IPipelineCreationTask** outTask
+    ) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL createRayTracingPipelineAsync(
+        const RayTracingPipelineDesc& desc,
+        IRayTracingPipeline* fallback,
+        IRayTracingPipeline** outPipeline,
+        IPipelineCreationTask** outTask
+    ) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL getCompilationReportList(ISlangBlob** outReportListBlob) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getPipelineManifest(ISlangBlob** outManifest) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL precompilePipelines(
+        IPipeline** pipelines,
+        uint32_t pipelineCount,
+        ISlangBlob* manifest
+    ) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getSpecializedPipelineCacheStats(
+        SpecializedPipelineCacheStats* outStats
+    ) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL readTexture(
         ITexture* texture,
         uint32_t layer,
@@ -199,6 +226,11 @@ public:
         IShaderTable** outTable
     ) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL reportHeaps(HeapReport* heapReports, uint32_t* heapCount) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getCommandProfile(CommandProfileEntry* entries, uint32_t* entryCount)
+        override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL dumpCommandProfile(CommandProfileFormat format, ISlangBlob** outBlob)
+        override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL resetCommandProfile() override;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL setCudaContextCurrent() override;
     virtual SLANG_NO_THROW Result SLANG_MCALL pushCudaContext() override;
@@ -216,6 +248,11 @@ public:
 #endif
 
 private:
+    /// Validate the arguments shared by the synchronous and asynchronous pipeline creation methods.
+    Result validatePipelineDesc(const RenderPipelineDesc& desc);
+    Result validatePipelineDesc(const ComputePipelineDesc& desc);
+    Result validatePipelineDesc(const RayTracingPipelineDesc& desc);
+
     DebugContext m_ctx;
 };
 
@@ -3,8 +3,12 @@
 #include "rhi-shared.h"
 #include "shader.h"
 #include "heap.h"
+#include "pipeline-resolver.h"
 #include "debug-layer/debug-device.h"
 
+#include "core/sha1.h"
+#include "core/task-pool.h"
+
 #include <algorithm>
 #include <cstdarg>
 
@@ -82,35 +86,258 @@ ShaderComponentID ShaderCache::getComponentId(std::string_view name)
 
 ShaderComponentID ShaderCache::getComponentId(ComponentKey key)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = componentIds.find(key);
-    if (it != componentIds.end())
+    Shard& shard = m_shards[getShardIndex(key.hash)];
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.componentIds.find(key);
+        if (it != shard.componentIds.end())
+            return it->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.componentIds.find(key);
+    if (it != shard.componentIds.end())
         return it->second;
-    ShaderComponentID resultId = static_cast<ShaderComponentID>(componentIds.size());
-    componentIds.emplace(key, resultId);
+    ShaderComponentID resultId;
+    {
+        std::lock_guard<std::mutex> namesLock(m_componentNamesMutex);
+        resultId = static_cast<ShaderComponentID>(componentNames.size());
+        componentNames.push_back(key.typeName);
+    }
+    shard.componentIds.emplace(std::move(key), resultId);
+    return resultId;
+}
+
+ShaderComponentID ShaderCache::getSessionTypeComponentId(slang::TypeReflection* type)
+{
+    Shard& shard = m_shards[getShardIndex(std::hash<void*>()(type))];
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.typeComponentIds.find(type);
+        if (it != shard.typeComponentIds.end())
+            return it->second;
+    }
+    // Build the key without holding the lock, the IDs of equal keys are the same anyway.
+    ShaderComponentID resultId = getComponentId(type);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.typeComponentIds.emplace(type, resultId);
     return resultId;
 }
 
+std::string ShaderCache::getComponentName(ShaderComponentID id)
+{
+    std::lock_guard<std::mutex> lock(m_componentNamesMutex);
+    return id < componentNames.size() ? componentNames[id] : std::string();
+}
+
+void ShaderCache::Shard::linkFront(SpecializedPipelineEntry& entry, uint64_t now)
+{
+    entry.lastUse.store(now, std::memory_order_relaxed);
+    entry.prev = nullptr;
+    entry.next = lruHead;
+    if (lruHead)
+        lruHead->prev = &entry;
+    else
+        lruTail = &entry;
+    lruHead = &entry;
+}
+
+void ShaderCache::Shard::unlink(SpecializedPipelineEntry& entry)
+{
+    (entry.prev ? entry.prev->next : lruHead) = entry.next;
+    (entry.next ? entry.next->prev : lruTail) = entry.prev;
+    entry.prev = nullptr;
+    entry.next = nullptr;
+}
+
 RefPtr<Pipeline> ShaderCache::getSpecializedPipeline(PipelineKey programKey)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = specializedPipelines.find(programKey);
-    if (it != specializedPipelines.end())
-        return it->second;
+    Shard& shard = m_shards[getShardIndex(programKey.hash)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.specializedPipelines.find(programKey);
+    if (it != shard.specializedPipelines.end())
+    {
+        // Only the first use after an addition reorders the LRU list.
+        SpecializedPipelineEntry& entry = it->second;
+        if (entry.lastUse.load(std::memory_order_relaxed) != m_useClock.load(std::memory_order_relaxed))
+        {
+            // The clock is read under the lock, so the list stays ordered by `lastUse`.
+            std::lock_guard<std::mutex> lruLock(shard.lruMutex);
+            shard.unlink(entry);
+            shard.linkFront(entry, m_useClock.load(std::memory_order_relaxed));
+        }
+        shard.hitCount.fetch_add(1, std::memory_order_relaxed);
+        return entry.pipeline;
+    }
+    shard.missCount.fetch_add(1, std::memory_order_relaxed);
     return nullptr;
 }
 
+RefPtr<Pipeline> ShaderCache::findSpecializedPipeline(const PipelineKey& key)
+{
+    Shard& shard = m_shards[getShardIndex(key.hash)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.specializedPipelines.find(key);
+    return it != shard.specializedPipelines.end() ? it->second.pipeline : nullptr;
+}
+
 void ShaderCache::addSpecializedPipeline(PipelineKey key, RefPtr<Pipeline> specializedPipeline)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    specializedPipelines[key] = specializedPipeline;
+    Shard& shard = m_shards[getShardIndex(key.hash)];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto [it, inserted] = shard.specializedPipelines.try_emplace(key);
+    SpecializedPipelineEntry& entry = it->second;
+    entry.pipeline = specializedPipeline;
+    m_useClock.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lruLock(shard.lruMutex);
+    if (inserted)
+    {
+        entry.key = &it->first;
+        m_specializedPipelineCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        shard.unlink(entry);
+    }
+    shard.linkFront(entry, m_useClock.load(std::memory_order_relaxed));
+}
+
+void ShaderCache::evictSpecializedPipelines(const PipelineKey& keep, std::vector<EvictedPipeline>& outEvicted)
+{
+    if (m_maxSpecializedPipelineCount == 0)
+        return;
+
+    // Returns the least recently used entry of a shard, other than `keep`. Requires the shard's `lruMutex`.
+    auto getLruEntry = [&keep](Shard& shard)
+    {
+        SpecializedPipelineEntry* entry = shard.lruTail;
+        if (entry && *entry->key == keep)
+            entry = entry->prev;
+        return entry;
+    };
+
+    std::lock_guard<std::mutex> evictionLock(m_evictionMutex);
+    while (m_specializedPipelineCount.load(std::memory_order_relaxed) > m_maxSpecializedPipelineCount)
+    {
+        // The least recently used entry is the oldest of the shards' least recently used entries.
+        Shard* lruShard = nullptr;
+        uint64_t lruLastUse = UINT64_MAX;
+        for (Shard& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lruLock(shard.lruMutex);
+            SpecializedPipelineEntry* entry = getLruEntry(shard);
+            if (entry && entry->lastUse.load(std::memory_order_relaxed) < lruLastUse)
+            {
+                lruShard = &shard;
+                lruLastUse = entry->lastUse.load(std::memory_order_relaxed);
+            }
+        }
+        if (!lruShard)
+            break;
+
+        // The shard may have changed since, in which case its current least recently used entry is evicted.
+        std::unique_lock<std::shared_mutex> lock(lruShard->mutex);
+        SpecializedPipelineEntry* entry;
+        {
+            std::lock_guard<std::mutex> lruLock(lruShard->lruMutex);
+            entry = getLruEntry(*lruShard);
+            if (!entry)
+                continue;
+            lruShard->unlink(*entry);
+        }
+        auto it = lruShard->specializedPipelines.find(*entry->key);
+
+        // The virtual pipeline is alive while it has entries in the cache, see `removeSpecializedPipelines()`.
+        EvictedPipeline evicted;
+        evicted.program = it->first.pipeline->m_program;
+        evicted.specializationArgs = it->first.specializationArgs;
+        evicted.pipeline = std::move(it->second.pipeline);
+        lruShard->specializedPipelines.erase(it);
+        m_specializedPipelineCount.fetch_sub(1, std::memory_order_relaxed);
+        m_evictionCount.fetch_add(1, std::memory_order_relaxed);
+        outEvicted.push_back(std::move(evicted));
+    }
+}
+
+void ShaderCache::removeSpecializedPipelines(Pipeline* pipeline)
+{
+    // Release the pipelines after unlocking the shards.
+    std::vector<RefPtr<Pipeline>> removedPipelines;
+    for (Shard& shard : m_shards)
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        std::lock_guard<std::mutex> lruLock(shard.lruMutex);
+        for (auto it = shard.specializedPipelines.begin(); it != shard.specializedPipelines.end();)
+        {
+            if (it->first.pipeline == pipeline)
+            {
+                shard.unlink(it->second);
+                removedPipelines.push_back(std::move(it->second.pipeline));
+                it = shard.specializedPipelines.erase(it);
+                m_specializedPipelineCount.fetch_sub(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+size_t ShaderCache::getSpecializedPipelineCount()
+{
+    return m_specializedPipelineCount.load(std::memory_order_relaxed);
+}
+
+void ShaderCache::getSpecializedPipelineCacheStats(SpecializedPipelineCacheStats& outStats)
+{
+    outStats = {};
+    outStats.entryCount = static_cast<uint32_t>(m_specializedPipelineCount.load(std::memory_order_relaxed));
+    for (Shard& shard : m_shards)
+    {
+        outStats.hitCount += shard.hitCount.load(std::memory_order_relaxed);
+        outStats.missCount += shard.missCount.load(std::memory_order_relaxed);
+    }
+    outStats.evictionCount = m_evictionCount.load(std::memory_order_relaxed);
 }
 
 void ShaderCache::free()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    componentIds = decltype(componentIds)();
-    specializedPipelines = decltype(specializedPipelines)();
+    for (Shard& shard : m_shards)
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.componentIds = decltype(shard.componentIds)();
+        shard.typeComponentIds = decltype(shard.typeComponentIds)();
+        shard.specializedPipelines = decltype(shard.specializedPipelines)();
+        std::lock_guard<std::mutex> lruLock(shard.lruMutex);
+        shard.lruHead = nullptr;
+        shard.lruTail = nullptr;
+    }
+    m_specializedPipelineCount = 0;
+    std::lock_guard<std::mutex> lock(m_componentNamesMutex);
+    componentNames = decltype(componentNames)();
+}
+
+// ----------------------------------------------------------------------------
+// PendingPipeline
+// ----------------------------------------------------------------------------
+
+Result PendingPipeline::wait(RefPtr<Pipeline>& outPipeline)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return m_done; });
+    outPipeline = m_pipeline;
+    return m_result;
+}
+
+void PendingPipeline::publish(Result result, Pipeline* pipeline)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+        m_result = result;
+        m_pipeline = pipeline;
+    }
+    m_condition.notify_all();
 }
 
 // ----------------------------------------------------------------------------
@@ -184,7 +411,10 @@ Result Device::getSpecializedProgram(
     else
     {
         RefPtr<ShaderProgram> specializedProgram;
-        SLANG_RETURN_ON_FAIL(specializeProgram(program, specializationArgs, specializedProgram.writeRef()));
+        {
+            std::lock_guard<std::mutex> frontEndLock(m_slangFrontEndMutex);
+            SLANG_RETURN_ON_FAIL(specializeProgram(program, specializationArgs, specializedProgram.writeRef()));
+        }
         program->m_specializedPrograms[key] = specializedProgram;
         // Program is owned by the cache (which is owned by the device).
         specializedProgram->breakStrongReferenceToDevice();
@@ -193,6 +423,11 @@ Result Device::getSpecializedProgram(
     }
 }
 
+slang::TypeReflection* Device::getSlangDynamicType()
+{
+    std::lock_guard<std::mutex> frontEndLock(m_slangFrontEndMutex);
+    return m_slangContext.session->getDynamicType();
+}
 
 Result Device::specializeProgram(
     ShaderProgram* program,
@@ -238,7 +473,7 @@ Result Device::specializeProgram(
 Result Device::getConcretePipeline(
     Pipeline* pipeline,
     ExtendedShaderObjectTypeList* specializationArgs,
-    Pipeline*& outPipeline
+    RefPtr<Pipeline>& outPipeline
 )
 {
     // Virtual pipelines are created due to 2 reasons:
@@ -264,18 +499,18 @@ Result Device::getConcretePipeline(
         return SLANG_OK;
     }
 
-    // Return early if we previously created a concrete pipeline for this virtual pipeline.
-    outPipeline = pipeline->getConcretePipeline();
-    if (outPipeline)
-    {
-        return SLANG_OK;
-    }
-
     // Check if program is specializable (if it has specialization arguments).
     bool isSpecializable = pipeline->m_program->isSpecializable();
 
-    // If the pipeline is specializable, collect specialization arguments from bound shader objects
-    // and lookup the cache.
+    // Return early if the deferred pipeline was already created, this does not need any locks.
+    if (!isSpecializable)
+    {
+        outPipeline = pipeline->getConcretePipeline();
+        if (outPipeline)
+            return SLANG_OK;
+    }
+
+    // If the pipeline is specializable, collect specialization arguments from bound shader objects.
     PipelineKey pipelineKey;
     pipelineKey.pipeline = pipeline;
     if (isSpecializable)
@@ -288,47 +523,149 @@ Result Device::getConcretePipeline(
         {
             pipelineKey.specializationArgs.push_back(componentID);
         }
-        pipelineKey.updateHash();
+    }
+    pipelineKey.updateHash();
+
+    // Return early if we previously created a specialized pipeline for this key.
+    // The cache is sharded, so concurrent lookups do not serialize.
+    if (isSpecializable)
+    {
         outPipeline = m_shaderCache.getSpecializedPipeline(pipelineKey);
         if (outPipeline)
-        {
             return SLANG_OK;
-        }
     }
 
-    // At this point we need to create a new concrete pipeline.
-    RefPtr<ShaderProgram> program = pipeline->m_program;
-    if (isSpecializable)
+    // On a miss, check again under the pending pipelines lock.
+    // If another thread is creating the pipeline, wait for it instead of creating it again.
+    RefPtr<PendingPipeline> pending;
+    bool isCreator = false;
+    RefPtr<Pipeline> concretePipeline = findOrBeginConcretePipeline(pipelineKey, pending, isCreator);
+    if (!concretePipeline && !isCreator)
     {
-        RefPtr<ShaderProgram> specializedProgram;
-        SLANG_RETURN_ON_FAIL(getSpecializedProgram(program, *specializationArgs, specializedProgram.writeRef()));
-        program = specializedProgram;
+        SLANG_RETURN_ON_FAIL(pending->wait(concretePipeline));
+    }
+    if (concretePipeline)
+    {
+        outPipeline = concretePipeline;
+        return SLANG_OK;
     }
 
-    // Ensure sure shaders are compiled.
-    SLANG_RETURN_ON_FAIL(program->compileShaders(this));
+    // At this point we need to create a new concrete pipeline.
+    auto createPipeline = [&]() -> Result
+    {
+        RefPtr<ShaderProgram> program = pipeline->m_program;
+        if (isSpecializable)
+        {
+            RefPtr<ShaderProgram> specializedProgram;
+            SLANG_RETURN_ON_FAIL(getSpecializedProgram(program, *specializationArgs, specializedProgram.writeRef()));
+            program = specializedProgram;
+        }
 
-    // Create a new concrete pipeline.
-    RefPtr<Pipeline> concretePipeline;
-    SLANG_RETURN_ON_FAIL(createConcretePipeline(pipeline, program, concretePipeline));
+        // Ensure sure shaders are compiled.
+        SLANG_RETURN_ON_FAIL(program->compileShaders(this));
 
-    if (isSpecializable)
+        // Create a new concrete pipeline.
+        return createConcretePipeline(pipeline, program, concretePipeline);
+    };
+    Result result = createPipeline();
+
+    // Cache the concrete pipeline and wake up threads waiting for it.
+    publishConcretePipeline(pipelineKey, pending, result, concretePipeline);
+    SLANG_RETURN_ON_FAIL(result);
+
+    outPipeline = concretePipeline;
+    return SLANG_OK;
+}
+
+RefPtr<Pipeline> Device::findOrBeginConcretePipeline(
+    const PipelineKey& key,
+    RefPtr<PendingPipeline>& outPending,
+    bool& outIsCreator
+)
+{
+    std::lock_guard<std::mutex> lock(m_pendingPipelinesMutex);
+
+    // The caller already missed the lookup, so this does not count as another one.
+    RefPtr<Pipeline> concretePipeline = key.pipeline->m_program->isSpecializable()
+                                            ? m_shaderCache.findSpecializedPipeline(key)
+                                            : RefPtr<Pipeline>(key.pipeline->getConcretePipeline());
+    if (concretePipeline)
     {
-        // Cache the specialized pipeline for later use.
-        m_shaderCache.addSpecializedPipeline(pipelineKey, concretePipeline);
-        // Pipeline is owned by the cache.
-        concretePipeline->breakStrongReferenceToDevice();
-        // Program is owned by the specialized pipeline (which is owned by the cache).
-        concretePipeline->m_program->breakStrongReferenceToDevice();
+        return concretePipeline;
+    }
+
+    auto it = m_pendingPipelines.find(key);
+    if (it != m_pendingPipelines.end())
+    {
+        outPending = it->second;
+        outIsCreator = false;
     }
     else
     {
-        // Store the concrete pipeline in the virtual one.
-        pipeline->setConcretePipeline(concretePipeline);
+        outPending = new PendingPipeline();
+        m_pendingPipelines.emplace(key, outPending);
+        outIsCreator = true;
     }
+    return nullptr;
+}
 
-    outPipeline = concretePipeline;
-    return SLANG_OK;
+void Device::publishConcretePipeline(
+    const PipelineKey& key,
+    PendingPipeline* pending,
+    Result result,
+    Pipeline* concretePipeline
+)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pendingPipelinesMutex);
+        if (SLANG_SUCCEEDED(result))
+        {
+            if (key.pipeline->m_program->isSpecializable())
+            {
+                // Cache the specialized pipeline for later use.
+                m_shaderCache.addSpecializedPipeline(key, concretePipeline);
+                // Pipeline is owned by the cache.
+                concretePipeline->breakStrongReferenceToDevice();
+                // Program is owned by the specialized pipeline (which is owned by the cache).
+                concretePipeline->m_program->breakStrongReferenceToDevice();
+            }
+            else
+            {
+                // Store the concrete pipeline in the virtual one.
+                key.pipeline->setConcretePipeline(concretePipeline);
+            }
+        }
+        // On failure the entry is removed as well, so that a later resolve can try again.
+        m_pendingPipelines.erase(key);
+    }
+    pending->publish(result, concretePipeline);
+
+    // Evict after unlocking, so that eviction does not block other threads looking up or creating pipelines.
+    if (SLANG_SUCCEEDED(result) && key.pipeline->m_program->isSpecializable())
+    {
+        std::vector<ShaderCache::EvictedPipeline> evicted;
+        m_shaderCache.evictSpecializedPipelines(key, evicted);
+        releaseEvictedPipelines(evicted);
+    }
+
+    if (m_recordPipelineManifest && SLANG_SUCCEEDED(result) && key.pipeline->m_program->isSpecializable())
+    {
+        recordPipelineManifestEntry(key);
+    }
+}
+
+void Device::releaseEvictedPipelines(std::vector<ShaderCache::EvictedPipeline>& evicted)
+{
+    for (ShaderCache::EvictedPipeline& entry : evicted)
+    {
+        // Drop the specialized program as well, unless it was replaced since the pipeline was created.
+        std::lock_guard<std::mutex> lock(entry.program->m_specializedProgramsMutex);
+        auto it = entry.program->m_specializedPrograms.find(SpecializationKey(entry.specializationArgs));
+        if (it != entry.program->m_specializedPrograms.end() && it->second.get() == entry.pipeline->m_program.get())
+            entry.program->m_specializedPrograms.erase(it);
+    }
+    // Pipelines still referenced by command buffers are destroyed when those are released.
+    evicted.clear();
 }
 
 Result Device::createConcretePipeline(Pipeline* pipeline, ShaderProgram* program, RefPtr<Pipeline>& outPipeline)
@@ -498,6 +835,8 @@ Result Device::initialize(const DeviceDesc& desc)
     }
 
     m_pipelineCompilationMode = desc.pipelineCompilationMode;
+    m_recordPipelineManifest = desc.recordPipelineManifest;
+    m_shaderCache.setMaxSpecializedPipelineCount(desc.maxSpecializedPipelineCount);
 
     m_persistentShaderCache = desc.persistentShaderCache;
     m_persistentPipelineCache = desc.persistentPipelineCache;
@@ -786,6 +1125,118 @@ Result Device::createRayTracingPipeline(const RayTracingPipelineDesc& desc, IRay
     }
 }
 
+Result Device::createRenderPipelineAsync(
+    const RenderPipelineDesc& desc,
+    IRenderPipeline* fallback,
+    IRenderPipeline** outPipeline,
+    IPipelineCreationTask** outTask
+)
+{
+    RefPtr<VirtualRenderPipeline> pipeline = new VirtualRenderPipeline(this, desc);
+    SLANG_RETURN_ON_FAIL(createPipelineAsync(pipeline, fallback, outTask));
+    returnComPtr(outPipeline, pipeline);
+    return SLANG_OK;
+}
+
+Result Device::createComputePipelineAsync(
+    const ComputePipelineDesc& desc,
+    IComputePipeline* fallback,
+    IComputePipeline** outPipeline,
+    IPipelineCreationTask** outTask
+)
+{
+    RefPtr<VirtualComputePipeline> pipeline = new VirtualComputePipeline(this, desc);
+    SLANG_RETURN_ON_FAIL(createPipelineAsync(pipeline, fallback, outTask));
+    returnComPtr(outPipeline, pipeline);
+    return SLANG_OK;
+}
+
+Result Device::createRayTracingPipelineAsync(
+    const RayTracingPipelineDesc& desc,
+    IRayTracingPipeline* fallback,
+    IRayTracingPipeline** outPipeline,
+    IPipelineCreationTask** outTask
+)
+{
+    RefPtr<VirtualRayTracingPipeline> pipeline = new VirtualRayTracingPipeline(this, desc);
+    SLANG_RETURN_ON_FAIL(createPipelineAsync(pipeline, fallback, outTask));
+    returnComPtr(outPipeline, pipeline);
+    return SLANG_OK;
+}
+
+Result Device::createPipelineAsync(Pipeline* pipeline, IPipeline* fallback, IPipelineCreationTask** outTask)
+{
+    RefPtr<PipelineCreationTask> task = new PipelineCreationTask();
+
+    // Pipelines that require specialization are specialized when used, there is nothing to create ahead of time.
+    if (pipeline->m_program->isSpecializable())
+    {
+        task->complete(SLANG_OK);
+        if (outTask)
+            returnComPtr(outTask, task);
+        return SLANG_OK;
+    }
+
+    if (fallback)
+    {
+        Pipeline* fallbackPipeline = dynamic_cast<Pipeline*>(fallback);
+        if (!fallbackPipeline || fallbackPipeline->m_program->isSpecializable())
+            return SLANG_E_INVALID_ARG;
+        pipeline->m_asyncFallback = fallbackPipeline;
+    }
+    pipeline->m_isCreatingAsync.store(true, std::memory_order_release);
+
+    // The payload holds a strong reference to the device, so the device outlives the task even if the
+    // application releases the device and the pipeline while it is running.
+    struct Payload
+    {
+        RefPtr<Device> device;
+        RefPtr<Pipeline> pipeline;
+        RefPtr<PipelineCreationTask> task;
+    };
+    auto createPipeline = [](void* data)
+    {
+        auto* payload = static_cast<Payload*>(data);
+        // Creation goes through the pipeline resolver, which compiles entry points in parallel
+        // and publishes the concrete pipeline so that command encoders waiting for it wake up.
+        // The resolver takes the device's Slang front-end lock for the front-end work it does on this thread.
+        Result result = payload->device->pushCudaContext();
+        if (SLANG_SUCCEEDED(result))
+        {
+            PipelineSpecialization specialization = {payload->pipeline, nullptr};
+            result = precompileSpecializedPipelines(payload->device, {&specialization, 1});
+            Result popResult = payload->device->popCudaContext();
+            if (SLANG_SUCCEEDED(result))
+                result = popResult;
+        }
+        payload->pipeline->m_isCreatingAsync.store(false, std::memory_order_release);
+        payload->task->complete(result);
+    };
+    auto deletePayload = [](void* data)
+    {
+        delete static_cast<Payload*>(data);
+    };
+
+    auto* payload = new Payload{this, pipeline, task};
+    ITaskPool::TaskHandle handle = nullptr;
+    if (canCreatePipelineOnTaskPool(pipeline))
+        handle = globalTaskPool()->submitTask(createPipeline, payload, deletePayload);
+    if (handle)
+    {
+        globalTaskPool()->releaseTask(handle);
+    }
+    else
+    {
+        // Backends that cannot create pipelines on the task pool create them right away.
+        createPipeline(payload);
+        deletePayload(payload);
+    }
+
+    if (outTask)
+        returnComPtr(outTask, task);
+    return SLANG_OK;
+}
+
 Result Device::getCompilationReportList(ISlangBlob** outReportListBlob)
 {
     if (!m_shaderCompilationReporter)
@@ -795,6 +1246,181 @@ Result Device::getCompilationReportList(ISlangBlob** outReportListBlob)
     return m_shaderCompilationReporter->getCompilationReportList(outReportListBlob);
 }
 
+// Pipeline manifests are text files. The first line is a header, followed by one line per specialized pipeline,
+// holding the program key and the type names of the specialization arguments, separated by tabs.
+static const char kPipelineManifestHeader[] = "slang-rhi-pipeline-manifest 2";
+
+// The program key is a hash of the program's label, entry points and specialization parameters, and of the code
+// hashes of its entry points. Code hashes cover the source of all modules the program depends on, so programs
+// with the same label and signature but different modules have different keys.
+const std::string& Device::getPipelineManifestProgramKey(ShaderProgram* program)
+{
+    std::lock_guard<std::mutex> frontEndLock(m_slangFrontEndMutex);
+    if (!program->m_pipelineManifestKey.empty())
+        return program->m_pipelineManifestKey;
+
+    std::string str = string::from_cstr(program->m_desc.label);
+    auto addEntryPoints = [&](slang::IComponentType* componentType)
+    {
+        slang::ProgramLayout* layout = componentType->getLayout();
+        for (SlangUInt i = 0; i < layout->getEntryPointCount(); ++i)
+        {
+            slang::EntryPointReflection* entryPoint = layout->getEntryPointByIndex(i);
+            str += '|';
+            str += string::from_cstr(entryPoint->getName());
+            str += ':';
+            str += std::to_string(int(entryPoint->getStage()));
+            ComPtr<slang::IBlob> hash;
+            componentType->getEntryPointHash(i, 0, hash.writeRef());
+            if (hash)
+            {
+                str += ':';
+                str += SHA1(hash->getBufferPointer(), hash->getBufferSize()).getHexDigest();
+            }
+        }
+    };
+    addEntryPoints(program->linkedProgram);
+    for (const auto& linkedEntryPoint : program->linkedEntryPoints)
+        addEntryPoints(linkedEntryPoint);
+    slang::ProgramLayout* layout = program->linkedProgram->getLayout();
+    for (unsigned i = 0; i < layout->getTypeParameterCount(); ++i)
+    {
+        str += '|';
+        str += string::from_cstr(layout->getTypeParameterByIndex(i)->getName());
+    }
+    // Existential parameters are not type parameters, but are specialized all the same.
+    str += '|';
+    str += std::to_string(program->linkedProgram->getSpecializationParamCount());
+    program->m_pipelineManifestKey = SHA1(str).getHexDigest();
+    return program->m_pipelineManifestKey;
+}
+
+void Device::recordPipelineManifestEntry(const PipelineKey& key)
+{
+    std::string entry = getPipelineManifestProgramKey(key.pipeline->m_program);
+    for (ShaderComponentID componentID : key.specializationArgs)
+    {
+        entry += '\t';
+        entry += m_shaderCache.getComponentName(componentID);
+    }
+    std::lock_guard<std::mutex> lock(m_pipelineManifestMutex);
+    m_pipelineManifest.insert(std::move(entry));
+}
+
+Result Device::getPipelineManifest(ISlangBlob** outManifest)
+{
+    if (!m_recordPipelineManifest)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    std::string str = kPipelineManifestHeader;
+    str += '\n';
+    {
+        std::lock_guard<std::mutex> lock(m_pipelineManifestMutex);
+        for (const std::string& entry : m_pipelineManifest)
+        {
+            str += entry;
+            str += '\n';
+        }
+    }
+    auto blob = OwnedBlob::create(str.data(), str.size());
+    returnComPtr(outManifest, blob);
+    return SLANG_OK;
+}
+
+Result Device::precompilePipelines(IPipeline** pipelines, uint32_t pipelineCount, ISlangBlob* manifest)
+{
+    if (!manifest || (pipelineCount > 0 && !pipelines))
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    std::string_view text(static_cast<const char*>(manifest->getBufferPointer()), manifest->getBufferSize());
+    auto nextToken = [](std::string_view& str, char separator) -> std::string_view
+    {
+        size_t pos = str.find(separator);
+        std::string_view token = str.substr(0, pos);
+        str = pos == std::string_view::npos ? std::string_view() : str.substr(pos + 1);
+        return token;
+    };
+    // Lines may end with "\r\n" if the manifest was edited on Windows.
+    auto nextLine = [&nextToken](std::string_view& str) -> std::string_view
+    {
+        std::string_view line = nextToken(str, '\n');
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        return line;
+    };
+    if (nextLine(text) != kPipelineManifestHeader)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    // Find the specializable pipelines for each program key.
+    std::unordered_map<std::string, std::vector<Pipeline*>> programPipelines;
+    for (uint32_t i = 0; i < pipelineCount; ++i)
+    {
+        Pipeline* pipeline = dynamic_cast<Pipeline*>(pipelines[i]);
+        if (!pipeline)
+        {
+            return SLANG_E_INVALID_ARG;
+        }
+        if (pipeline->isVirtual() && pipeline->m_program->isSpecializable())
+        {
+            programPipelines[getPipelineManifestProgramKey(pipeline->m_program)].push_back(pipeline);
+        }
+    }
+
+    std::vector<RefPtr<ExtendedShaderObjectTypeListObject>> specializationArgs;
+    std::vector<PipelineSpecialization> specializations;
+    while (!text.empty())
+    {
+        std::string_view line = nextLine(text);
+        auto it = programPipelines.find(std::string(nextToken(line, '\t')));
+        if (it == programPipelines.end())
+        {
+            continue;
+        }
+        ShaderProgram* program = it->second[0]->m_program;
+        RefPtr<ExtendedShaderObjectTypeListObject> args = new ExtendedShaderObjectTypeListObject();
+        while (!line.empty())
+        {
+            std::string typeName(nextToken(line, '\t'));
+            slang::TypeReflection* type;
+            {
+                std::lock_guard<std::mutex> frontEndLock(m_slangFrontEndMutex);
+                type = program->findTypeByName(typeName.c_str());
+            }
+            if (!type)
+            {
+                args = nullptr;
+                break;
+            }
+            args->add(ExtendedShaderObjectType{type, m_shaderCache.getComponentId(type)});
+        }
+        // Skip entries that no longer match the program.
+        if (!args || SlangInt(args->getCount()) != program->linkedProgram->getSpecializationParamCount())
+        {
+            continue;
+        }
+        for (Pipeline* pipeline : it->second)
+        {
+            specializations.push_back({pipeline, args});
+        }
+        specializationArgs.push_back(args);
+    }
+
+    return precompileSpecializedPipelines(this, specializations);
+}
+
+Result Device::getSpecializedPipelineCacheStats(SpecializedPipelineCacheStats* outStats)
+{
+    if (!outStats)
+        return SLANG_E_INVALID_ARG;
+    m_shaderCache.getSpecializedPipelineCacheStats(*outStats);
+    return SLANG_OK;
+}
+
 Result Device::createShaderObject(
     slang::ISession* slangSession,
     slang::TypeReflection* type,
@@ -1110,6 +1736,49 @@ Result Device::reportHeaps(HeapReport* heapReports, uint32_t* heapCount)
     return SLANG_OK;
 }
 
+Result Device::getCommandProfile(CommandProfileEntry* entries, uint32_t* entryCount)
+{
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+    if (!entryCount)
+        return SLANG_E_INVALID_ARG;
+    if (!entries)
+    {
+        *entryCount = kCommandCount;
+        return SLANG_OK;
+    }
+    if (*entryCount < kCommandCount)
+        return SLANG_E_BUFFER_TOO_SMALL;
+    m_commandProfiler.getEntries(entries);
+    *entryCount = kCommandCount;
+    return SLANG_OK;
+#else
+    SLANG_UNUSED(entries);
+    SLANG_UNUSED(entryCount);
+    return SLANG_E_NOT_AVAILABLE;
+#endif
+}
+
+Result Device::dumpCommandProfile(CommandProfileFormat format, ISlangBlob** outBlob)
+{
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+    return m_commandProfiler.dump(format, outBlob);
+#else
+    SLANG_UNUSED(format);
+    SLANG_UNUSED(outBlob);
+    return SLANG_E_NOT_AVAILABLE;
+#endif
+}
+
+Result Device::resetCommandProfile()
+{
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+    m_commandProfiler.reset();
+    return SLANG_OK;
+#else
+    return SLANG_E_NOT_AVAILABLE;
+#endif
+}
+
 Result Device::flushHeaps()
 {
     for (Heap* heap : m_globalHeaps)
@@ -8,14 +8,20 @@
 #include "core/short_vector.h"
 
 #include "staging-heap.h"
+#include "command-profiler.h"
 
 #include "rhi.h"
 #include "rhi-shared-fwd.h"
 
 #include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace rhi {
 
@@ -105,9 +111,37 @@ struct PipelineKey
         }
         return true;
     }
+
+    struct Hasher
+    {
+        std::size_t operator()(const PipelineKey& key) const { return key.hash; }
+    };
+};
+
+/// A concrete pipeline that is being created by one thread.
+/// Other threads resolving the same `PipelineKey` wait for it instead of creating it again.
+class PendingPipeline : public RefObject
+{
+public:
+    /// Block until the pipeline is published and return the result of its creation.
+    Result wait(RefPtr<Pipeline>& outPipeline);
+
+    /// Publish the result of the creation and wake up all waiting threads.
+    void publish(Result result, Pipeline* pipeline);
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_done = false;
+    Result m_result = SLANG_OK;
+    RefPtr<Pipeline> m_pipeline;
 };
 
 // A cache from specialization keys to a specialized `ShaderKernel`.
+//
+// Lookups run on every bind of a specializable program, from any number of encoder threads.
+// The maps are split into shards, each guarded by a reader-writer lock, so that concurrent
+// lookups of existing entries neither serialize on a single lock nor block each other.
 class ShaderCache : public RefObject
 {
 public:
@@ -115,10 +149,52 @@ public:
     ShaderComponentID getComponentId(std::string_view name);
     ShaderComponentID getComponentId(ComponentKey key);
 
+    /// Get the component ID of a type owned by the device's slang session.
+    ///
+    /// The ID is cached by type pointer, so repeated lookups do not build the type name.
+    /// The cache does not own the pointer, so `type` must belong to a session that lives
+    /// as long as the device, such as the results of `specializeType` and `getDynamicType`
+    /// on the device's session. Types from other sessions must use `getComponentId`, as a
+    /// later allocation reusing their address would map to the wrong component.
+    ShaderComponentID getSessionTypeComponentId(slang::TypeReflection* type);
+
+    /// Get the type name a component ID was created for.
+    std::string getComponentName(ShaderComponentID id);
+
+    /// A specialized pipeline evicted from the cache.
+    struct EvictedPipeline
+    {
+        /// Program of the virtual pipeline the pipeline was specialized from.
+        RefPtr<ShaderProgram> program;
+        short_vector<ShaderComponentID> specializationArgs;
+        RefPtr<Pipeline> pipeline;
+    };
+
+    /// Set the maximum number of specialized pipelines. 0 means unlimited.
+    void setMaxSpecializedPipelineCount(uint32_t count) { m_maxSpecializedPipelineCount = count; }
+
+    /// Look up a specialized pipeline and mark it as recently used.
     RefPtr<Pipeline> getSpecializedPipeline(PipelineKey programKey);
 
+    /// Look up a specialized pipeline without counting the lookup or marking the entry as used.
+    /// Used to check again for an entry after `getSpecializedPipeline` missed it.
+    RefPtr<Pipeline> findSpecializedPipeline(const PipelineKey& key);
+
+    /// Add a specialized pipeline. Call `evictSpecializedPipelines()` afterwards to enforce the maximum count.
     void addSpecializedPipeline(PipelineKey key, RefPtr<Pipeline> specializedPipeline);
 
+    /// Remove the least recently used specialized pipelines, except `keep`, until the maximum number of
+    /// specialized pipelines is no longer exceeded, and return them in `outEvicted`. Command lists retain the
+    /// pipelines they use, so evicting a pipeline does not affect command buffers that are still in flight.
+    void evictSpecializedPipelines(const PipelineKey& keep, std::vector<EvictedPipeline>& outEvicted);
+
+    /// Remove all specialized pipelines of a virtual pipeline that is being destroyed.
+    void removeSpecializedPipelines(Pipeline* pipeline);
+
+    size_t getSpecializedPipelineCount();
+
+    void getSpecializedPipelineCacheStats(SpecializedPipelineCacheStats& outStats);
+
     void free();
 
 protected:
@@ -131,9 +207,62 @@ protected:
         std::size_t operator()(const PipelineKey& k) const { return k.hash; }
     };
 
-    std::mutex m_mutex;
-    std::unordered_map<ComponentKey, ShaderComponentID, ComponentKeyHasher> componentIds;
-    std::unordered_map<PipelineKey, RefPtr<Pipeline>, PipelineKeyHasher> specializedPipelines;
+    static constexpr size_t kShardCount = 16;
+
+    struct SpecializedPipelineEntry
+    {
+        RefPtr<Pipeline> pipeline;
+        /// Value of `m_useClock` when the entry was last used.
+        std::atomic<uint64_t> lastUse = 0;
+        /// Key of the entry in `Shard::specializedPipelines`.
+        const PipelineKey* key = nullptr;
+        /// Links in the shard's LRU list.
+        SpecializedPipelineEntry* prev = nullptr;
+        SpecializedPipelineEntry* next = nullptr;
+    };
+
+    struct Shard
+    {
+        std::shared_mutex mutex;
+        std::unordered_map<ComponentKey, ShaderComponentID, ComponentKeyHasher> componentIds;
+        std::unordered_map<slang::TypeReflection*, ShaderComponentID> typeComponentIds;
+        std::unordered_map<PipelineKey, SpecializedPipelineEntry, PipelineKeyHasher> specializedPipelines;
+        std::atomic<uint64_t> hitCount = 0;
+        std::atomic<uint64_t> missCount = 0;
+
+        /// Guards the LRU list of `specializedPipelines`, which lookups reorder while holding `mutex` shared.
+        /// The list is ordered by `lastUse`, most recently used first.
+        std::mutex lruMutex;
+        SpecializedPipelineEntry* lruHead = nullptr;
+        SpecializedPipelineEntry* lruTail = nullptr;
+
+        /// Move an entry to the front of the LRU list, marking it as used now. Requires `lruMutex`.
+        void linkFront(SpecializedPipelineEntry& entry, uint64_t now);
+        /// Remove an entry from the LRU list. Requires `lruMutex`.
+        void unlink(SpecializedPipelineEntry& entry);
+    };
+
+    static size_t getShardIndex(size_t hash)
+    {
+        // Pointer hashes have their low bits cleared by alignment, so fold in higher bits.
+        return (hash ^ (hash >> 7) ^ (hash >> 17)) % kShardCount;
+    }
+
+    Shard m_shards[kShardCount];
+
+    uint32_t m_maxSpecializedPipelineCount = 0;
+    std::atomic<size_t> m_specializedPipelineCount = 0;
+    std::atomic<uint64_t> m_evictionCount = 0;
+    /// Advanced whenever a specialized pipeline is added. Entries used since the last addition share the
+    /// same timestamp, so lookups only write to an entry the first time it is used after an addition.
+    std::atomic<uint64_t> m_useClock = 0;
+    /// Serializes evictions, which compare the LRU lists of all shards.
+    std::mutex m_evictionMutex;
+
+    /// Guards allocation of component IDs and `componentNames`.
+    std::mutex m_componentNamesMutex;
+    /// Type names indexed by component ID.
+    std::vector<std::string> componentNames;
 };
 
 class NullDebugCallback : public IDebugCallback
@@ -233,8 +362,41 @@ public:
         IRayTracingPipeline** outPipeline
     ) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL createRenderPipelineAsync(
+        const RenderPipelineDesc& desc,
+        IRenderPipeline* fallback,
+        IRenderPipeline** outPipeline,
+        IPipelineCreationTask** outTask
+    ) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL createComputePipelineAsync(
+        const ComputePipelineDesc& desc,
+        IComputePipeline* fallback,
+        IComputePipeline** outPipeline,
+        IPipelineCreationTask** outTask
+    ) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL createRayTracingPipelineAsync(
+        const RayTracingPipelineDesc& desc,
+        IRayTracingPipeline* fallback,
+        IRayTracingPipeline** outPipeline,
+        IPipelineCreationTask** outTask
+    ) override;
+
+    /// Start creating the concrete pipeline of a virtual pipeline on the task pool.
+    Result createPipelineAsync(Pipeline* pipeline, IPipeline* fallback, IPipelineCreationTask** outTask);
+
     virtual SLANG_NO_THROW Result SLANG_MCALL getCompilationReportList(ISlangBlob** outReportListBlob) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL getPipelineManifest(ISlangBlob** outManifest) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL precompilePipelines(
+        IPipeline** pipelines,
+        uint32_t pipelineCount,
+        ISlangBlob* manifest
+    ) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL getSpecializedPipelineCacheStats(
+        SpecializedPipelineCacheStats* outStats
+    ) override;
+
     virtual SLANG_NO_THROW Result SLANG_MCALL createShaderObject(
         slang::ISession* session,
         slang::TypeReflection* type,
@@ -371,6 +533,12 @@ public:
     // Provides a default implementation that reports heaps from m_globalHeaps.
     virtual SLANG_NO_THROW Result SLANG_MCALL reportHeaps(HeapReport* heapReports, uint32_t* heapCount) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL getCommandProfile(CommandProfileEntry* entries, uint32_t* entryCount)
+        override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL dumpCommandProfile(CommandProfileFormat format, ISlangBlob** outBlob)
+        override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL resetCommandProfile() override;
+
     // Default no-op implementations for CUDA context management (only meaningful for CUDA backend).
     virtual SLANG_NO_THROW Result SLANG_MCALL setCudaContextCurrent() override { return SLANG_OK; }
     virtual SLANG_NO_THROW Result SLANG_MCALL pushCudaContext() override { return SLANG_OK; }
@@ -431,14 +599,37 @@ public:
         ShaderProgram** outSpecializedProgram
     );
 
+    /// Get the `__Dynamic` type of the device's session, used for arguments that cannot be specialized.
+    /// Takes `m_slangFrontEndMutex`, so it must not be called while holding it.
+    slang::TypeReflection* getSlangDynamicType();
+
     Result getConcretePipeline(
         Pipeline* pipeline,
         ExtendedShaderObjectTypeList* specializationArgs,
-        Pipeline*& outPipeline
+        RefPtr<Pipeline>& outPipeline
     );
 
     Result createConcretePipeline(Pipeline* pipeline, ShaderProgram* program, RefPtr<Pipeline>& outPipeline);
 
+    /// Look up the concrete pipeline for `key`, returning null if it has not been created yet.
+    /// In that case `outPending` is set to the pending creation of the pipeline. If no other thread is creating it,
+    /// the caller is registered as its creator (`outIsCreator`) and must call `publishConcretePipeline`.
+    /// Otherwise the caller can wait on `outPending`.
+    /// Callers look up the cache first, this takes `m_pendingPipelinesMutex` and is only called on a miss.
+    RefPtr<Pipeline> findOrBeginConcretePipeline(
+        const PipelineKey& key,
+        RefPtr<PendingPipeline>& outPending,
+        bool& outIsCreator
+    );
+
+    /// Publish the concrete pipeline created for `key`, or the failure to create it, and wake up waiting threads.
+    void publishConcretePipeline(
+        const PipelineKey& key,
+        PendingPipeline* pending,
+        Result result,
+        Pipeline* concretePipeline
+    );
+
     /// Backends opt individual pipelines into creation on the global task pool.
     /// Pipelines that perform nested work on that pool must return false.
     virtual bool canCreatePipelineOnTaskPool(const Pipeline* pipeline) const
@@ -492,6 +683,10 @@ public:
     StagingHeap m_uploadHeap;
     StagingHeap m_readbackHeap;
 
+#if SLANG_RHI_ENABLE_COMMAND_PROFILING
+    CommandProfiler m_commandProfiler;
+#endif
+
     ComPtr<IPersistentCache> m_persistentShaderCache;
     ComPtr<IPersistentCache> m_persistentPipelineCache;
 
@@ -540,8 +735,32 @@ public:
         }
     }
 
-    /// Serializes resolution/publication across command encoders. Work within one resolver may still run concurrently.
-    std::mutex m_pipelineResolutionMutex;
+    /// Serializes Slang front-end work on the device's session, which is not thread-safe: program and shader
+    /// object type specialization, layout queries and entry-point preparation. Target code compilation (including
+    /// CPU host-callable code generation) and backend pipeline creation run outside of this lock, and may run
+    /// concurrently.
+    std::mutex m_slangFrontEndMutex;
+
+    /// Protects publication of concrete pipelines and `m_pendingPipelines`.
+    /// Cached pipelines are looked up before taking this lock, it is only needed on a miss.
+    std::mutex m_pendingPipelinesMutex;
+    /// Concrete pipelines that are currently being created.
+    std::unordered_map<PipelineKey, RefPtr<PendingPipeline>, PipelineKey::Hasher> m_pendingPipelines;
+
+    bool m_recordPipelineManifest = false;
+    /// Protects `m_pipelineManifest`.
+    std::mutex m_pipelineManifestMutex;
+    /// Recorded manifest entries, see `recordPipelineManifestEntry()`.
+    std::set<std::string> m_pipelineManifest;
+
+    /// Returns a key identifying a program across runs, see `recordPipelineManifestEntry()`.
+    const std::string& getPipelineManifestProgramKey(ShaderProgram* program);
+
+    /// Record the specialization of a created specialized pipeline in the pipeline manifest.
+    void recordPipelineManifestEntry(const PipelineKey& key);
+
+    /// Drop the specialized programs of pipelines evicted from the shader cache.
+    void releaseEvictedPipelines(std::vector<ShaderCache::EvictedPipeline>& evicted);
 
     LiveDeviceTracker m_liveDeviceTracker;
 };
@@ -0,0 +1,740 @@
+#include "file-persistent-cache.h"
+#include "reference.h"
+
+#include "core/blob.h"
+#include "core/com-object.h"
+#include "core/common.h"
+#include "core/sha1.h"
+
+#if SLANG_WINDOWS_FAMILY
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rhi {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Platform helpers
+// ----------------------------------------------------------------------------
+
+#if SLANG_WINDOWS_FAMILY
+using FileHandle = HANDLE;
+static const FileHandle kInvalidFileHandle = INVALID_HANDLE_VALUE;
+#else
+using FileHandle = int;
+static const FileHandle kInvalidFileHandle = -1;
+#endif
+
+struct FileMapping
+{
+    void* data = nullptr;
+    size_t size = 0;
+};
+
+/// Open a file. Writable files are created if they do not exist.
+FileHandle openFile(const std::filesystem::path& path, bool writable)
+{
+#if SLANG_WINDOWS_FAMILY
+    return ::CreateFileW(
+        path.c_str(),
+        GENERIC_READ | (writable ? GENERIC_WRITE : 0),
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        writable ? OPEN_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+#else
+    return ::open(path.c_str(), writable ? (O_RDWR | O_CREAT | O_CLOEXEC) : (O_RDONLY | O_CLOEXEC), 0644);
+#endif
+}
+
+/// Create a file for writing, truncating it if it exists.
+FileHandle createFile(const std::filesystem::path& path)
+{
+#if SLANG_WINDOWS_FAMILY
+    return ::CreateFileW(
+        path.c_str(),
+        GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+#else
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+}
+
+void closeFile(FileHandle file)
+{
+#if SLANG_WINDOWS_FAMILY
+    ::CloseHandle(file);
+#else
+    ::close(file);
+#endif
+}
+
+bool getFileSize(FileHandle file, uint64_t& outSize)
+{
+#if SLANG_WINDOWS_FAMILY
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size))
+        return false;
+    outSize = uint64_t(size.QuadPart);
+#else
+    struct stat st;
+    if (::fstat(file, &st) != 0)
+        return false;
+    outSize = uint64_t(st.st_size);
+#endif
+    return true;
+}
+
+bool writeFile(FileHandle file, const void* data, size_t size)
+{
+    const uint8_t* ptr = static_cast<const uint8_t*>(data);
+    while (size > 0)
+    {
+#if SLANG_WINDOWS_FAMILY
+        DWORD written = 0;
+        if (!::WriteFile(file, ptr, DWORD(std::min<size_t>(size, 1u << 30)), &written, nullptr))
+            return false;
+#else
+        ssize_t written = ::write(file, ptr, size);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+#endif
+        ptr += written;
+        size -= size_t(written);
+    }
+    return true;
+}
+
+/// Flush written data to the storage device.
+bool syncFile(FileHandle file)
+{
+#if SLANG_WINDOWS_FAMILY
+    return ::FlushFileBuffers(file);
+#else
+    return ::fsync(file) == 0;
+#endif
+}
+
+bool resizeFile(FileHandle file, uint64_t size)
+{
+#if SLANG_WINDOWS_FAMILY
+    LARGE_INTEGER offset;
+    offset.QuadPart = LONGLONG(size);
+    return ::SetFilePointerEx(file, offset, nullptr, FILE_BEGIN) && ::SetEndOfFile(file);
+#else
+    return ::ftruncate(file, off_t(size)) == 0;
+#endif
+}
+
+/// Map the first `size` bytes of a file. The mapping stays valid after the file is closed.
+bool mapFile(FileHandle file, size_t size, bool writable, FileMapping& outMapping)
+{
+#if SLANG_WINDOWS_FAMILY
+    HANDLE mapping =
+        ::CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+        return false;
+    void* data = ::MapViewOfFile(mapping, writable ? (FILE_MAP_READ | FILE_MAP_WRITE) : FILE_MAP_READ, 0, 0, size);
+    ::CloseHandle(mapping);
+    if (!data)
+        return false;
+#else
+    void* data = ::mmap(nullptr, size, PROT_READ | (writable ? PROT_WRITE : 0), MAP_SHARED, file, 0);
+    if (data == MAP_FAILED)
+        return false;
+#endif
+    outMapping.data = data;
+    outMapping.size = size;
+    return true;
+}
+
+void unmapFile(FileMapping& mapping)
+{
+    if (!mapping.data)
+        return;
+#if SLANG_WINDOWS_FAMILY
+    ::UnmapViewOfFile(mapping.data);
+#else
+    ::munmap(mapping.data, mapping.size);
+#endif
+    mapping = {};
+}
+
+/// Exclusive lock on a file, shared across processes.
+class FileLock
+{
+public:
+    explicit FileLock(FileHandle file)
+        : m_file(file)
+    {
+#if SLANG_WINDOWS_FAMILY
+        OVERLAPPED overlapped = {};
+        m_locked = ::LockFileEx(m_file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped);
+#else
+        int result;
+        do
+        {
+            result = ::flock(m_file, LOCK_EX);
+        }
+        while (result != 0 && errno == EINTR);
+        m_locked = result == 0;
+#endif
+    }
+
+    ~FileLock()
+    {
+        if (!m_locked)
+            return;
+#if SLANG_WINDOWS_FAMILY
+        OVERLAPPED overlapped = {};
+        ::UnlockFileEx(m_file, 0, MAXDWORD, MAXDWORD, &overlapped);
+#else
+        ::flock(m_file, LOCK_UN);
+#endif
+    }
+
+    bool isLocked() const { return m_locked; }
+
+private:
+    FileHandle m_file;
+    bool m_locked = false;
+};
+
+uint32_t getProcessId()
+{
+#if SLANG_WINDOWS_FAMILY
+    return uint32_t(::GetCurrentProcessId());
+#else
+    return uint32_t(::getpid());
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// File formats
+// ----------------------------------------------------------------------------
+
+static constexpr uint32_t kIndexMagic = 0x49435253;  // 'SRCI'
+static constexpr uint32_t kEntryMagic = 0x45435253;  // 'SRCE'
+static constexpr uint32_t kVersion = 1;
+static constexpr size_t kEntryDataAlignment = 16;
+
+struct IndexHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    /// Number of slots in the hash table (power of two).
+    uint32_t capacity;
+    /// Number of used slots.
+    uint32_t entryCount;
+    /// Total size of all entry files.
+    uint64_t totalSize;
+    /// Counter used to order accesses for LRU eviction.
+    uint64_t clock;
+};
+
+struct IndexEntry
+{
+    SHA1::Digest digest;
+    uint32_t used;
+    uint64_t size;
+    uint64_t lastAccess;
+};
+
+static_assert(sizeof(IndexHeader) == 32);
+static_assert(sizeof(IndexEntry) == 40);
+
+struct EntryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t keySize;
+    uint64_t dataSize;
+};
+
+static_assert(sizeof(EntryHeader) == 24);
+
+size_t getIndexSize(uint32_t capacity)
+{
+    return sizeof(IndexHeader) + size_t(capacity) * sizeof(IndexEntry);
+}
+
+size_t getEntryDataOffset(uint64_t keySize)
+{
+    return calcAligned2(sizeof(EntryHeader) + size_t(keySize), kEntryDataAlignment);
+}
+
+std::string toHexString(const SHA1::Digest& digest)
+{
+    static const char kHexDigits[] = "0123456789abcdef";
+    std::string str(digest.size() * 2, '0');
+    for (size_t i = 0; i < digest.size(); ++i)
+    {
+        str[i * 2 + 0] = kHexDigits[digest[i] >> 4];
+        str[i * 2 + 1] = kHexDigits[digest[i] & 0xf];
+    }
+    return str;
+}
+
+/// Blob viewing the data of a memory-mapped entry file.
+class MappedFileBlob : public BlobBase
+{
+public:
+    MappedFileBlob(const FileMapping& mapping, size_t offset, size_t size)
+        : m_mapping(mapping)
+        , m_offset(offset)
+        , m_size(size)
+    {
+    }
+
+    ~MappedFileBlob() override { unmapFile(m_mapping); }
+
+    virtual SLANG_NO_THROW const void* SLANG_MCALL getBufferPointer() override
+    {
+        return static_cast<const uint8_t*>(m_mapping.data) + m_offset;
+    }
+    virtual SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() override { return m_size; }
+
+private:
+    FileMapping m_mapping;
+    size_t m_offset;
+    size_t m_size;
+};
+
+// ----------------------------------------------------------------------------
+// FilePersistentCache
+// ----------------------------------------------------------------------------
+
+class FilePersistentCache : public IPersistentCache, public ComObject
+{
+public:
+    SLANG_COM_OBJECT_IUNKNOWN_ALL
+
+    IPersistentCache* getInterface(const Guid& guid)
+    {
+        if (guid == ISlangUnknown::getTypeGuid() || guid == IPersistentCache::getTypeGuid())
+            return static_cast<IPersistentCache*>(this);
+        return nullptr;
+    }
+
+    ~FilePersistentCache()
+    {
+        removePendingFiles();
+        unmapFile(m_indexMapping);
+        if (m_indexFile != kInvalidFileHandle)
+            closeFile(m_indexFile);
+    }
+
+    Result init(const FilePersistentCacheDesc& desc)
+    {
+        if (!desc.path || desc.path[0] == 0)
+            return SLANG_E_INVALID_ARG;
+
+        m_path = std::filesystem::path(desc.path);
+        m_maxSize = desc.maxSize;
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_path, ec);
+        if (!std::filesystem::is_directory(m_path, ec))
+            return SLANG_FAIL;
+
+        // Retry removing files left behind by caches that could not remove them before exiting.
+        for (std::filesystem::directory_iterator it(m_path, ec), end; !ec && it != end; it.increment(ec))
+        {
+            if (it->path().extension() == ".old")
+                m_pendingRemovals.push_back(it->path());
+        }
+        removePendingFiles();
+
+        m_indexFile = openFile(m_path / "index", true);
+        if (m_indexFile == kInvalidFileHandle)
+            return SLANG_FAIL;
+
+        FileLock fileLock(m_indexFile);
+        if (!fileLock.isLocked())
+            return SLANG_FAIL;
+
+        // Use the existing index if it is valid.
+        uint64_t fileSize = 0;
+        if (!getFileSize(m_indexFile, fileSize))
+            return SLANG_FAIL;
+        if (fileSize >= sizeof(IndexHeader) && mapFile(m_indexFile, size_t(fileSize), true, m_indexMapping))
+        {
+            const IndexHeader* header = static_cast<const IndexHeader*>(m_indexMapping.data);
+            if (header->magic == kIndexMagic && header->version == kVersion && header->capacity > 0 &&
+                isPowerOf2(header->capacity) && fileSize == getIndexSize(header->capacity))
+            {
+                m_capacity = header->capacity;
+                return SLANG_OK;
+            }
+            unmapFile(m_indexMapping);
+        }
+
+        // Otherwise create a new index.
+        // Entry files of a previous index are no longer tracked, but are replaced when written again.
+        // Slots are kept at most half full, so probe sequences stay short.
+        uint32_t capacity = 16;
+        while (capacity < 2 * uint64_t(desc.maxEntryCount) && capacity < (1u << 30))
+            capacity *= 2;
+        if (!resizeFile(m_indexFile, 0) || !resizeFile(m_indexFile, getIndexSize(capacity)) ||
+            !mapFile(m_indexFile, getIndexSize(capacity), true, m_indexMapping))
+        {
+            return SLANG_FAIL;
+        }
+        IndexHeader* header = static_cast<IndexHeader*>(m_indexMapping.data);
+        header->magic = kIndexMagic;
+        header->version = kVersion;
+        header->capacity = capacity;
+        header->entryCount = 0;
+        header->totalSize = 0;
+        header->clock = 0;
+        m_capacity = capacity;
+        return SLANG_OK;
+    }
+
+    // IPersistentCache interface
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL writeCache(ISlangBlob* key, ISlangBlob* data) override
+    {
+        if (!key || !data)
+            return SLANG_E_INVALID_ARG;
+
+        SHA1::Digest digest = SHA1(key->getBufferPointer(), key->getBufferSize()).getDigest();
+        size_t keySize = key->getBufferSize();
+        size_t dataSize = data->getBufferSize();
+        size_t dataOffset = getEntryDataOffset(keySize);
+        uint64_t fileSize = dataOffset + dataSize;
+
+        // Entries that exceed the budget on their own are not cached.
+        if (m_maxSize != 0 && fileSize > m_maxSize)
+            return SLANG_OK;
+
+        // Write the entry to a temporary file and move it in place, so readers never see partial entries.
+        // The file is synced before it is moved, so a crash cannot leave a renamed but incomplete entry behind.
+        std::filesystem::path entryPath = getEntryPath(digest);
+        std::filesystem::path tempPath = getUniquePath(entryPath, ".tmp");
+        {
+            FileHandle file = createFile(tempPath);
+            if (file == kInvalidFileHandle)
+                return SLANG_FAIL;
+            EntryHeader header = {kEntryMagic, kVersion, keySize, dataSize};
+            static const char kPadding[kEntryDataAlignment] = {};
+            bool written = writeFile(file, &header, sizeof(header)) &&
+                           writeFile(file, key->getBufferPointer(), keySize) &&
+                           writeFile(file, kPadding, dataOffset - sizeof(header) - keySize) &&
+                           writeFile(file, data->getBufferPointer(), dataSize) && syncFile(file);
+            closeFile(file);
+            if (!written)
+            {
+                removeFile(tempPath);
+                return SLANG_FAIL;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tempPath, entryPath, ec);
+        if (ec)
+        {
+            // On Windows, an entry file that is mapped by a reader cannot be replaced, but it can be moved away.
+            if (removeFile(entryPath))
+                std::filesystem::rename(tempPath, entryPath, ec);
+            if (ec)
+            {
+                removeFile(tempPath);
+                return SLANG_FAIL;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FileLock fileLock(m_indexFile);
+        if (!fileLock.isLocked() || !isIndexValid())
+            return SLANG_FAIL;
+
+        IndexHeader* header = getHeader();
+        IndexEntry* entry = findEntry(digest, true);
+        if (entry->used)
+        {
+            header->totalSize -= std::min(entry->size, header->totalSize);
+        }
+        else
+        {
+            entry->digest = digest;
+            entry->used = 1;
+            header->entryCount++;
+        }
+        entry->size = fileSize;
+        entry->lastAccess = ++header->clock;
+        header->totalSize += fileSize;
+
+        evict(digest);
+        removePendingFiles();
+        return SLANG_OK;
+    }
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL queryCache(ISlangBlob* key, ISlangBlob** outData) override
+    {
+        if (!key || !outData)
+            return SLANG_E_INVALID_ARG;
+        *outData = nullptr;
+
+        SHA1::Digest digest = SHA1(key->getBufferPointer(), key->getBufferSize()).getDigest();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            FileLock fileLock(m_indexFile);
+            if (!fileLock.isLocked() || !isIndexValid())
+                return SLANG_E_NOT_FOUND;
+            IndexEntry* entry = findEntry(digest, false);
+            if (!entry)
+                return SLANG_E_NOT_FOUND;
+            entry->lastAccess = ++getHeader()->clock;
+        }
+
+        // The entry file is mapped outside of the lock. It is immutable once in place,
+        // it can only be replaced or deleted, which leaves existing mappings intact.
+        FileMapping mapping;
+        FileHandle file = openFile(getEntryPath(digest), false);
+        if (file != kInvalidFileHandle)
+        {
+            uint64_t fileSize = 0;
+            if (getFileSize(file, fileSize) && fileSize >= sizeof(EntryHeader))
+                mapFile(file, size_t(fileSize), false, mapping);
+            closeFile(file);
+        }
+
+        size_t dataOffset = 0;
+        size_t dataSize = 0;
+        if (!mapping.data || !validateEntry(mapping, key, dataOffset, dataSize))
+        {
+            // The entry was evicted or is damaged, stop tracking it.
+            unmapFile(mapping);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            FileLock fileLock(m_indexFile);
+            if (fileLock.isLocked() && isIndexValid())
+            {
+                if (IndexEntry* entry = findEntry(digest, false))
+                    removeEntry(entry);
+            }
+            return SLANG_E_NOT_FOUND;
+        }
+
+        ComPtr<ISlangBlob> blob(new MappedFileBlob(mapping, dataOffset, dataSize));
+        returnComPtr(outData, blob);
+        return SLANG_OK;
+    }
+
+private:
+    IndexHeader* getHeader() { return static_cast<IndexHeader*>(m_indexMapping.data); }
+
+    IndexEntry* getEntries() { return reinterpret_cast<IndexEntry*>(getHeader() + 1); }
+
+    /// Check that the index has not been replaced by another process since it was mapped.
+    bool isIndexValid()
+    {
+        const IndexHeader* header = getHeader();
+        return header->magic == kIndexMagic && header->version == kVersion && header->capacity == m_capacity;
+    }
+
+    std::filesystem::path getEntryPath(const SHA1::Digest& digest) const { return m_path / toHexString(digest); }
+
+    size_t getSlot(const SHA1::Digest& digest) const
+    {
+        uint64_t hash;
+        std::memcpy(&hash, digest.data(), sizeof(hash));
+        return size_t(hash) & (m_capacity - 1);
+    }
+
+    /// Find the entry for `digest` using linear probing.
+    /// Returns the free slot the entry would be inserted in if it is missing and `orFree` is set.
+    IndexEntry* findEntry(const SHA1::Digest& digest, bool orFree)
+    {
+        IndexEntry* entries = getEntries();
+        for (size_t slot = getSlot(digest);; slot = (slot + 1) & (m_capacity - 1))
+        {
+            IndexEntry* entry = &entries[slot];
+            if (!entry->used)
+                return orFree ? entry : nullptr;
+            if (entry->digest == digest)
+                return entry;
+        }
+    }
+
+    /// Remove an entry, shifting back entries of the same probe sequence to keep lookups valid.
+    void removeEntry(IndexEntry* entry)
+    {
+        IndexHeader* header = getHeader();
+        IndexEntry* entries = getEntries();
+        size_t mask = m_capacity - 1;
+
+        header->entryCount--;
+        header->totalSize -= std::min(entry->size, header->totalSize);
+
+        size_t hole = size_t(entry - entries);
+        for (size_t slot = (hole + 1) & mask; entries[slot].used; slot = (slot + 1) & mask)
+        {
+            // Move the entry into the hole unless its home slot lies cyclically after the hole.
+            size_t home = getSlot(entries[slot].digest);
+            if (((slot - home) & mask) >= ((slot - hole) & mask))
+            {
+                entries[hole] = entries[slot];
+                hole = slot;
+            }
+        }
+        entries[hole] = {};
+    }
+
+    /// Evict least recently used entries until the index is within its size and entry count limits.
+    /// The entry for `keep` (the one just written) is never evicted.
+    void evict(const SHA1::Digest& keep)
+    {
+        IndexHeader* header = getHeader();
+        auto isOverBudget = [&]()
+        {
+            return (m_maxSize != 0 && header->totalSize > m_maxSize) || header->entryCount > m_capacity / 2;
+        };
+        if (!isOverBudget())
+            return;
+
+        std::vector<std::pair<uint64_t, SHA1::Digest>> candidates;
+        candidates.reserve(header->entryCount);
+        IndexEntry* entries = getEntries();
+        for (size_t slot = 0; slot < m_capacity; ++slot)
+        {
+            if (entries[slot].used && entries[slot].digest != keep)
+                candidates.push_back({entries[slot].lastAccess, entries[slot].digest});
+        }
+        std::sort(
+            candidates.begin(),
+            candidates.end(),
+            [](const auto& a, const auto& b)
+            {
+                return a.first < b.first;
+            }
+        );
+
+        for (const auto& candidate : candidates)
+        {
+            if (!isOverBudget())
+                break;
+            // Processes that have the file mapped keep their view of it.
+            // Entries whose file cannot be removed stay tracked, so the size budget remains accurate.
+            if (!removeFile(getEntryPath(candidate.second)))
+                continue;
+            if (IndexEntry* entry = findEntry(candidate.second, false))
+                removeEntry(entry);
+        }
+    }
+
+    /// Return a path next to `path` that is unique across caches and processes.
+    std::filesystem::path getUniquePath(const std::filesystem::path& path, const char* extension)
+    {
+        std::filesystem::path uniquePath = path;
+        uniquePath += "." + std::to_string(getProcessId()) + "." + std::to_string(m_tempCounter++) + extension;
+        return uniquePath;
+    }
+
+    /// Remove a file, returning true if `path` no longer exists afterwards.
+    /// On Windows, files that are mapped by a reader cannot be removed. They are moved to a unique path
+    /// instead, so `path` can be reused right away, and removed later by `removePendingFiles()`.
+    bool removeFile(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        if (!ec)
+            return true;
+        std::filesystem::path pendingPath = getUniquePath(path, ".old");
+        std::filesystem::rename(path, pendingPath, ec);
+        if (ec)
+            return false;
+        std::lock_guard<std::mutex> lock(m_pendingRemovalsMutex);
+        m_pendingRemovals.push_back(std::move(pendingPath));
+        return true;
+    }
+
+    /// Retry removing the files that could not be removed before.
+    void removePendingFiles()
+    {
+        std::lock_guard<std::mutex> lock(m_pendingRemovalsMutex);
+        auto it = std::remove_if(
+            m_pendingRemovals.begin(),
+            m_pendingRemovals.end(),
+            [](const std::filesystem::path& path)
+            {
+                std::error_code ec;
+                std::filesystem::remove(path, ec);
+                return !ec;
+            }
+        );
+        m_pendingRemovals.erase(it, m_pendingRemovals.end());
+    }
+
+    /// Check the header and key of a mapped entry file and return the location of its data.
+    static bool validateEntry(const FileMapping& mapping, ISlangBlob* key, size_t& outDataOffset, size_t& outDataSize)
+    {
+        EntryHeader header;
+        std::memcpy(&header, mapping.data, sizeof(header));
+        if (header.magic != kEntryMagic || header.version != kVersion || header.keySize != key->getBufferSize())
+            return false;
+        size_t dataOffset = getEntryDataOffset(header.keySize);
+        if (dataOffset > mapping.size || header.dataSize != mapping.size - dataOffset)
+            return false;
+        const uint8_t* fileKey = static_cast<const uint8_t*>(mapping.data) + sizeof(EntryHeader);
+        if (std::memcmp(fileKey, key->getBufferPointer(), header.keySize) != 0)
+            return false;
+        outDataOffset = dataOffset;
+        outDataSize = size_t(header.dataSize);
+        return true;
+    }
+
+    std::filesystem::path m_path;
+    uint64_t m_maxSize = 0;
+    uint32_t m_capacity = 0;
+    std::atomic<uint64_t> m_tempCounter = 0;
+
+    /// Serializes access to the index within this process. The file lock serializes it across processes.
+    std::mutex m_mutex;
+    FileHandle m_indexFile = kInvalidFileHandle;
+    FileMapping m_indexMapping;
+
+    /// Files that were moved away because they could not be removed, see `removeFile()`.
+    std::mutex m_pendingRemovalsMutex;
+    std::vector<std::filesystem::path> m_pendingRemovals;
+};
+
+} // namespace
+
+Result openFilePersistentCache(const FilePersistentCacheDesc& desc, IPersistentCache** outCache)
+{
+    if (!outCache)
+        return SLANG_E_INVALID_ARG;
+    RefPtr<FilePersistentCache> cache = new FilePersistentCache();
+    SLANG_RETURN_ON_FAIL(cache->init(desc));
+    returnComPtr(outCache, cache);
+    return SLANG_OK;
+}
+
+} // namespace rhi
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <slang-rhi.h>
+
+namespace rhi {
+
+/// Open a persistent cache stored in the directory `desc.path`.
+///
+/// Each entry is stored in its own file, named after the SHA-1 digest of its key. The file holds the key
+/// and the data, so lookups can verify that they found the right entry. Entries are written to a temporary
+/// file which is then renamed, so a crash or a concurrent reader never observes a partially written entry.
+///
+/// A memory-mapped index file maps key digests to entry sizes and last access times. It is used to answer
+/// lookups for missing entries and to evict the least recently used entries when the size budget is exceeded.
+/// The index is only accessed while holding a lock on the index file, so the directory can be shared by
+/// multiple caches and processes.
+Result openFilePersistentCache(const FilePersistentCacheDesc& desc, IPersistentCache** outCache);
+
+} // namespace rhi
@@ -161,6 +161,7 @@ Result CommandRecorder::record(CommandBufferImpl* commandBuffer)
         cmd##x(commandList.getCommand<commands::x>(command));                                                          \
         break;
 
+        SLANG_RHI_COMMAND_PROFILE_SCOPE(&m_device->m_commandProfiler, Execute, command->id);
         switch (command->id)
         {
             SLANG_RHI_COMMANDS(SLANG_RHI_COMMAND_EXECUTE_X);
@@ -1167,7 +1168,9 @@ void CommandQueueImpl::retireCommandBuffers()
         auto status = commandBuffer->m_commandBuffer->status();
         if (status == MTL::CommandBufferStatusCompleted || status == MTL::CommandBufferStatusError)
         {
-            commandBuffer->reset();
+            // Reusable command buffers keep their command list and are released with their last reference.
+            if (!commandBuffer->isReusable())
+                commandBuffer->reset();
         }
         else
         {
@@ -1305,6 +1308,11 @@ Result CommandQueueImpl::submit(const SubmitDesc& desc)
     {
         // Get command buffer, assign updated submission id and store in the in-flight list.
         CommandBufferImpl* commandBuffer = checked_cast<CommandBufferImpl*>(desc.commandBuffers[i]);
+        if (commandBuffer->isReusable() &&
+            commandBuffer->m_commandBuffer->status() != MTL::CommandBufferStatusNotEnrolled)
+        {
+            SLANG_RETURN_ON_FAIL(commandBuffer->rerecord());
+        }
         commandBuffer->m_submissionID = m_lastSubmittedID;
         m_commandBuffersInFlight.push_back(commandBuffer);
 
@@ -1383,10 +1391,28 @@ Result CommandEncoderImpl::getBindingData(RootShaderObject* rootObject, BindingD
     );
 }
 
+Result CommandEncoderImpl::createChildEncoderImpl(CommandEncoder** outEncoder)
+{
+    AUTORELEASEPOOL
+
+    RefPtr<CommandEncoderImpl> encoder = new CommandEncoderImpl(m_device, m_queue, m_desc);
+    SLANG_RETURN_ON_FAIL(encoder->init());
+    returnRefPtr(outEncoder, encoder);
+    return SLANG_OK;
+}
+
+Result CommandEncoderImpl::detachCommandBuffer(CommandBuffer** outCommandBuffer)
+{
+    returnRefPtrMove(outCommandBuffer, m_commandBuffer);
+    m_commandList = nullptr;
+    return SLANG_OK;
+}
+
 Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer** outCommandBuffer)
 {
     AUTORELEASEPOOL
 
+    SLANG_RETURN_ON_FAIL(finishChildEncoders(m_commandBuffer));
     DeviceImpl* device = getDevice<DeviceImpl>();
     bool hadLabel = m_commandBuffer->m_desc.label != nullptr;
     m_commandBuffer->setDesc(desc);
@@ -1395,6 +1421,7 @@ Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer*
         m_commandBuffer->m_commandBuffer->setLabel(createString(m_commandBuffer->m_desc.label).get());
     }
     SLANG_RETURN_ON_FAIL(resolvePipelines(device));
+    m_commandBuffer->optimizeCommands();
     CommandRecorder recorder(device);
     SLANG_RETURN_ON_FAIL(recorder.record(m_commandBuffer));
     returnComPtr(outCommandBuffer, m_commandBuffer);
@@ -1435,6 +1462,17 @@ Result CommandBufferImpl::reset()
     return CommandBuffer::reset();
 }
 
+Result CommandBufferImpl::rerecord()
+{
+    SLANG_RETURN_ON_FAIL(init());
+    if (m_desc.label)
+    {
+        m_commandBuffer->setLabel(createString(m_desc.label).get());
+    }
+    CommandRecorder recorder(getDevice<DeviceImpl>());
+    return recorder.record(this);
+}
+
 Result CommandBufferImpl::getNativeHandle(NativeHandle* outHandle)
 {
     outHandle->type = NativeHandleType::MTLCommandBuffer;
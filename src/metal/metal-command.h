@@ -151,6 +151,8 @@ public:
     Result init();
 
     virtual Result getBindingData(RootShaderObject* rootObject, BindingData*& outBindingData) override;
+    virtual Result createChildEncoderImpl(CommandEncoder** outEncoder) override;
+    virtual Result detachCommandBuffer(CommandBuffer** outCommandBuffer) override;
 
     // ICommandEncoder implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(
@@ -174,6 +176,11 @@ public:
     Result init();
     virtual Result reset() override;
 
+    /// Record the command list into a new Metal command buffer.
+    /// Metal command buffers can only be committed once, so reusable command buffers are re-recorded from their
+    /// immutable command list before every submission after the first.
+    Result rerecord();
+
     // ICommandBuffer implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
 };
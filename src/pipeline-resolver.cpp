@@ -7,17 +7,21 @@
 #include "shader.h"
 #include "shader-object.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 namespace rhi {
 
 namespace {
 
+/// Tasks submitted to a task group, so that a batch waited on from inside another task
+/// (e.g. by an asynchronous pipeline creation) can execute its own tasks instead of blocking a worker.
 class TaskBatch
 {
 public:
     explicit TaskBatch(ITaskPool* taskPool)
         : m_taskPool(taskPool)
+        , m_group(taskPool->createTaskGroup())
     {
     }
 
@@ -25,7 +29,7 @@ public:
 
     Result submit(void (*func)(void*), void* payload, void (*payloadDeleter)(void*))
     {
-        auto handle = m_taskPool->submitTask(func, payload, payloadDeleter);
+        auto handle = m_taskPool->submitTask(func, payload, payloadDeleter, m_group);
         SLANG_RHI_ASSERT(handle);
         if (!handle)
         {
@@ -33,25 +37,20 @@ public:
                 payloadDeleter(payload);
             return SLANG_FAIL;
         }
-        m_handles.push_back(handle);
+        m_taskPool->releaseTask(handle);
         return SLANG_OK;
     }
 
     void wait()
     {
-        for (auto handle : m_handles)
-            m_taskPool->waitAndReleaseTask(handle);
-        m_handles.clear();
+        if (m_group)
+            m_taskPool->waitAndReleaseTaskGroup(m_group);
+        m_group = nullptr;
     }
 
 private:
     ITaskPool* m_taskPool;
-    std::vector<ITaskPool::TaskHandle> m_handles;
-};
-
-struct PipelineKeyHasher
-{
-    size_t operator()(const PipelineKey& key) const { return key.hash; }
+    ITaskPool::TaskGroupHandle m_group;
 };
 
 struct PipelineRequest
@@ -61,10 +60,14 @@ struct PipelineRequest
     ExtendedShaderObjectTypeListObject* specializationArgs = nullptr;
     std::vector<const CommandList::CommandSlot*> commands;
 
+    /// Set if the concrete pipeline is being created, either by this resolver or by another thread.
+    RefPtr<PendingPipeline> pending;
+    /// True if this resolver creates the concrete pipeline and publishes it.
+    bool isCreator = false;
+
     RefPtr<ShaderProgram> program;
     RefPtr<Pipeline> concretePipeline;
     Result result = SLANG_OK;
-    bool created = false;
 };
 
 struct ProgramWork
@@ -94,21 +97,39 @@ public:
     {
     }
 
-    Result resolve()
+    PipelineResolver(Device* device, std::span<const PipelineSpecialization> specializations)
+        : m_device(device)
+        , m_commandList(nullptr)
+        , m_specializations(specializations)
     {
-        std::lock_guard<std::mutex> resolutionLock(m_device->m_pipelineResolutionMutex);
+    }
 
-        if (m_device->m_pipelineCompilationMode == PipelineCompilationMode::Serial ||
-            m_device->getInfo().deviceType == DeviceType::CPU)
+    Result resolve()
+    {
+        if (m_device->m_pipelineCompilationMode == PipelineCompilationMode::Serial)
         {
             return resolveSerial();
         }
+        return resolveParallel();
+    }
 
-        SLANG_RETURN_ON_FAIL(collectRequests());
-        SLANG_RETURN_ON_FAIL(preparePrograms());
-        SLANG_RETURN_ON_FAIL(compilePrograms());
-        SLANG_RETURN_ON_FAIL(createPipelines());
-        finalize();
+    Result resolveParallel()
+    {
+        Result result = collectRequests();
+        if (SLANG_SUCCEEDED(result))
+            result = preparePrograms();
+        if (SLANG_SUCCEEDED(result))
+            result = compilePrograms();
+        if (SLANG_SUCCEEDED(result))
+            result = createPipelines();
+        // Pipelines this resolver registered to create are always published, even on failure,
+        // so that other threads waiting for them wake up.
+        publishPipelines();
+        SLANG_RETURN_ON_FAIL(result);
+        // Pipelines created by other threads are waited for only after publishing our own,
+        // so resolvers waiting for each other cannot deadlock.
+        SLANG_RETURN_ON_FAIL(waitForPipelines());
+        patchCommands();
         return SLANG_OK;
     }
 
@@ -148,6 +169,13 @@ private:
         default:
             break;
         }
+
+        // Pipelines that are still being created asynchronously are replaced by their fallback, if any.
+        while (outPipeline && outPipeline->m_asyncFallback &&
+               outPipeline->m_isCreatingAsync.load(std::memory_order_acquire))
+        {
+            outPipeline = outPipeline->m_asyncFallback;
+        }
     }
 
     static void patchCommand(
@@ -156,6 +184,8 @@ private:
         Pipeline* concretePipeline
     )
     {
+        // Keep the concrete pipeline alive for as long as the command list references it.
+        commandList->retainResource(concretePipeline);
         switch (command->id)
         {
         case CommandID::SetRenderState:
@@ -186,7 +216,7 @@ private:
 
     Result resolveSerial()
     {
-        for (auto command = m_commandList->getCommands(); command; command = command->next)
+        for (CommandList::CommandSlot* command : *m_commandList)
         {
             Pipeline* pipeline;
             ExtendedShaderObjectTypeListObject* specializationArgs;
@@ -194,7 +224,8 @@ private:
             if (!pipeline)
                 continue;
 
-            Pipeline* concretePipeline = nullptr;
+            // Hold a reference until the command list retains the pipeline, it may be evicted from the cache.
+            RefPtr<Pipeline> concretePipeline;
             SLANG_RETURN_ON_FAIL(m_device->getConcretePipeline(pipeline, specializationArgs, concretePipeline));
             patchCommand(m_commandList, command, concretePipeline);
         }
@@ -203,9 +234,23 @@ private:
 
     Result collectRequests()
     {
-        std::unordered_map<PipelineKey, size_t, PipelineKeyHasher> requestMap;
+        std::unordered_map<PipelineKey, size_t, PipelineKey::Hasher> requestMap;
+
+        if (!m_commandList)
+        {
+            for (const PipelineSpecialization& specialization : m_specializations)
+            {
+                if (specialization.pipeline->isVirtual())
+                {
+                    SLANG_RETURN_ON_FAIL(
+                        addRequest(requestMap, specialization.pipeline, specialization.specializationArgs, nullptr)
+                    );
+                }
+            }
+            return SLANG_OK;
+        }
 
-        for (auto command = m_commandList->getCommands(); command; command = command->next)
+        for (CommandList::CommandSlot* command : *m_commandList)
         {
             Pipeline* pipeline;
             ExtendedShaderObjectTypeListObject* specializationArgs;
@@ -219,48 +264,63 @@ private:
                 continue;
             }
 
-            PipelineKey key = {};
-            key.pipeline = pipeline;
-            if (pipeline->m_program->isSpecializable())
+            // Deferred pipelines that were already created need no request.
+            if (Pipeline* concretePipeline = pipeline->getConcretePipeline())
             {
-                if (!specializationArgs)
-                    return SLANG_FAIL;
-                for (ShaderComponentID componentID : specializationArgs->componentIDs)
-                    key.specializationArgs.push_back(componentID);
+                patchCommand(m_commandList, command, concretePipeline);
+                continue;
             }
-            key.updateHash();
 
-            auto [it, inserted] = requestMap.emplace(key, m_requests.size());
-            if (inserted)
-            {
-                PipelineRequest request;
-                request.key = key;
-                request.pipeline = pipeline;
-                request.specializationArgs = specializationArgs;
-                request.commands.push_back(command);
-
-                if (pipeline->m_program->isSpecializable())
-                    request.concretePipeline = m_device->m_shaderCache.getSpecializedPipeline(key);
-                else
-                    request.concretePipeline = pipeline->getConcretePipeline();
+            SLANG_RETURN_ON_FAIL(addRequest(requestMap, pipeline, specializationArgs, command));
+        }
+        return SLANG_OK;
+    }
 
-                m_requests.push_back(std::move(request));
-            }
-            else
-            {
-                m_requests[it->second].commands.push_back(command);
-            }
+    /// Add a request for a virtual pipeline, or add `command` to the existing request with the same key.
+    Result addRequest(
+        std::unordered_map<PipelineKey, size_t, PipelineKey::Hasher>& requestMap,
+        Pipeline* pipeline,
+        ExtendedShaderObjectTypeListObject* specializationArgs,
+        const CommandList::CommandSlot* command
+    )
+    {
+        PipelineKey key = {};
+        key.pipeline = pipeline;
+        if (pipeline->m_program->isSpecializable())
+        {
+            if (!specializationArgs)
+                return SLANG_FAIL;
+            for (ShaderComponentID componentID : specializationArgs->componentIDs)
+                key.specializationArgs.push_back(componentID);
         }
+        key.updateHash();
+
+        auto [it, inserted] = requestMap.emplace(key, m_requests.size());
+        if (inserted)
+        {
+            PipelineRequest request;
+            request.key = key;
+            request.pipeline = pipeline;
+            request.specializationArgs = specializationArgs;
+            // Look up the cache before registering the request with the device.
+            if (pipeline->m_program->isSpecializable())
+                request.concretePipeline = m_device->m_shaderCache.getSpecializedPipeline(key);
+            if (!request.concretePipeline)
+                request.concretePipeline =
+                    m_device->findOrBeginConcretePipeline(key, request.pending, request.isCreator);
+            m_requests.push_back(std::move(request));
+        }
+        if (command)
+            m_requests[it->second].commands.push_back(command);
         return SLANG_OK;
     }
 
     Result preparePrograms()
     {
-        std::unordered_map<ShaderProgram*, size_t> programMap;
-
+        std::vector<ShaderProgram*> programs;
         for (auto& request : m_requests)
         {
-            if (request.concretePipeline)
+            if (!request.isCreator)
                 continue;
 
             request.program = request.pipeline->m_program;
@@ -274,19 +334,30 @@ private:
                 ));
                 request.program = specializedProgram;
             }
+            programs.push_back(request.program);
+        }
 
-            if (programMap.find(request.program) == programMap.end())
+        // Programs are locked in address order, so that resolvers sharing programs cannot deadlock.
+        std::sort(programs.begin(), programs.end());
+        programs.erase(std::unique(programs.begin(), programs.end()), programs.end());
+
+        m_programs.reserve(programs.size());
+        for (ShaderProgram* program : programs)
+        {
+            m_programs.emplace_back(program);
+            ProgramWork& programWork = m_programs.back();
+            if (!programWork.program->m_compiledShaders)
             {
-                size_t index = m_programs.size();
-                programMap.emplace(request.program, index);
-                m_programs.emplace_back(request.program);
-                ProgramWork& programWork = m_programs.back();
-                if (!programWork.program->m_compiledShaders)
+                if (m_device->getInfo().deviceType == DeviceType::CPU)
                 {
-                    SLANG_RETURN_ON_FAIL(
-                        programWork.program->prepareEntryPointCompilation(m_device, programWork.entryPoints)
-                    );
+                    // CPU device does not need to compile shaders, kernels are compiled with the pipeline.
+                    programWork.program->m_compiledShaders = true;
+                    continue;
                 }
+                // Takes the device's Slang front-end lock.
+                SLANG_RETURN_ON_FAIL(
+                    programWork.program->prepareEntryPointCompilation(m_device, programWork.entryPoints)
+                );
             }
         }
         return SLANG_OK;
@@ -389,7 +460,7 @@ private:
         std::vector<PipelineRequest*> callerRequests;
         for (auto& request : m_requests)
         {
-            if (!request.concretePipeline)
+            if (request.isCreator)
             {
                 if (m_device->canCreatePipelineOnTaskPool(request.pipeline))
                     workerRequests.push_back(&request);
@@ -403,7 +474,6 @@ private:
             TaskBatch batch(globalTaskPool());
             for (PipelineRequest* request : workerRequests)
             {
-                request->created = true;
                 auto* payload = new std::pair<Device*, PipelineRequest*>(m_device, request);
                 SLANG_RETURN_ON_FAIL(batch.submit(
                     createPipelineTask,
@@ -420,7 +490,6 @@ private:
         {
             for (PipelineRequest* request : workerRequests)
             {
-                request->created = true;
                 std::pair<Device*, PipelineRequest*> payload(m_device, request);
                 createPipelineTask(&payload);
             }
@@ -430,7 +499,6 @@ private:
         // prevents CUDA ray-tracing pipeline workers from blocking the same pool used by OptiX.
         for (PipelineRequest* request : callerRequests)
         {
-            request->created = true;
             std::pair<Device*, PipelineRequest*> payload(m_device, request);
             createPipelineTask(&payload);
         }
@@ -440,24 +508,33 @@ private:
         return SLANG_OK;
     }
 
-    void finalize()
+    void publishPipelines()
     {
         for (auto& request : m_requests)
         {
-            if (request.created)
-            {
-                if (request.pipeline->m_program->isSpecializable())
-                {
-                    m_device->m_shaderCache.addSpecializedPipeline(request.key, request.concretePipeline);
-                    request.concretePipeline->breakStrongReferenceToDevice();
-                    request.concretePipeline->m_program->breakStrongReferenceToDevice();
-                }
-                else
-                {
-                    request.pipeline->setConcretePipeline(request.concretePipeline);
-                }
-            }
+            if (!request.isCreator)
+                continue;
+            Result result = request.result;
+            if (SLANG_SUCCEEDED(result) && !request.concretePipeline)
+                result = SLANG_FAIL;
+            m_device->publishConcretePipeline(request.key, request.pending, result, request.concretePipeline);
+        }
+    }
+
+    Result waitForPipelines()
+    {
+        for (auto& request : m_requests)
+        {
+            if (!request.concretePipeline)
+                SLANG_RETURN_ON_FAIL(request.pending->wait(request.concretePipeline));
+        }
+        return SLANG_OK;
+    }
 
+    void patchCommands()
+    {
+        for (auto& request : m_requests)
+        {
             for (const auto* command : request.commands)
                 patchCommand(m_commandList, command, request.concretePipeline);
         }
@@ -465,6 +542,7 @@ private:
 
     Device* m_device;
     CommandList* m_commandList;
+    std::span<const PipelineSpecialization> m_specializations;
     std::vector<PipelineRequest> m_requests;
     std::vector<ProgramWork> m_programs;
 };
@@ -477,4 +555,10 @@ Result resolvePipelines(Device* device, CommandList* commandList)
     return resolver.resolve();
 }
 
+Result precompileSpecializedPipelines(Device* device, std::span<const PipelineSpecialization> specializations)
+{
+    PipelineResolver resolver(device, specializations);
+    return resolver.resolveParallel();
+}
+
 } // namespace rhi
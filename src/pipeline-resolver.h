@@ -2,15 +2,33 @@
 
 #include <slang-rhi.h>
 
+#include <span>
+
 namespace rhi {
 
 class CommandList;
 class Device;
+class ExtendedShaderObjectTypeListObject;
+class Pipeline;
 
 /// Resolves virtual pipelines referenced by a command list.
 ///
-/// Front-end Slang work and cache publication are performed serially. Fully prepared
-/// entry-point code generation and supported backend pipeline creation may run concurrently.
+/// Front-end Slang work (specialization, layout queries and entry-point preparation) is serialized
+/// by the device's Slang front-end lock, including across resolvers. Fully prepared entry-point code
+/// generation and supported backend pipeline creation may run concurrently.
+/// Resolvers on different threads only synchronize on the pipelines they share: each concrete
+/// pipeline is created once, and other resolvers needing it wait for that creation.
 Result resolvePipelines(Device* device, CommandList* commandList);
 
+/// A virtual pipeline and the specialization arguments to create a concrete pipeline for.
+struct PipelineSpecialization
+{
+    Pipeline* pipeline;
+    ExtendedShaderObjectTypeListObject* specializationArgs;
+};
+
+/// Creates the concrete pipelines for a list of specializations ahead of their first use.
+/// This uses the parallel path of `resolvePipelines`, regardless of the device's pipeline compilation mode.
+Result precompileSpecializedPipelines(Device* device, std::span<const PipelineSpecialization> specializations);
+
 } // namespace rhi
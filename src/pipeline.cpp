@@ -4,6 +4,14 @@
 
 namespace rhi {
 
+/// Specialized pipelines are cached by the virtual pipeline they were specialized from,
+/// so remove them from the cache when that pipeline is destroyed.
+static void removeSpecializedPipelines(Pipeline* pipeline)
+{
+    if (pipeline->m_program && pipeline->m_program->isSpecializable())
+        pipeline->getDevice()->m_shaderCache.removeSpecializedPipelines(pipeline);
+}
+
 // ----------------------------------------------------------------------------
 // RenderPipeline
 // ----------------------------------------------------------------------------
@@ -35,6 +43,11 @@ VirtualRenderPipeline::VirtualRenderPipeline(Device* device, const RenderPipelin
 {
 }
 
+VirtualRenderPipeline::~VirtualRenderPipeline()
+{
+    removeSpecializedPipelines(this);
+}
+
 Result VirtualRenderPipeline::getNativeHandle(NativeHandle* outHandle)
 {
     *outHandle = {};
@@ -71,6 +84,11 @@ VirtualComputePipeline::VirtualComputePipeline(Device* device, const ComputePipe
 {
 }
 
+VirtualComputePipeline::~VirtualComputePipeline()
+{
+    removeSpecializedPipelines(this);
+}
+
 Result VirtualComputePipeline::getNativeHandle(NativeHandle* outHandle)
 {
     *outHandle = {};
@@ -115,10 +133,48 @@ VirtualRayTracingPipeline::VirtualRayTracingPipeline(Device* device, const RayTr
 {
 }
 
+VirtualRayTracingPipeline::~VirtualRayTracingPipeline()
+{
+    removeSpecializedPipelines(this);
+}
+
 Result VirtualRayTracingPipeline::getNativeHandle(NativeHandle* outHandle)
 {
     *outHandle = {};
     return SLANG_E_NOT_AVAILABLE;
 }
 
+// ----------------------------------------------------------------------------
+// PipelineCreationTask
+// ----------------------------------------------------------------------------
+
+IPipelineCreationTask* PipelineCreationTask::getInterface(const Guid& guid)
+{
+    if (guid == ISlangUnknown::getTypeGuid() || guid == IPipelineCreationTask::getTypeGuid())
+        return static_cast<IPipelineCreationTask*>(this);
+    return nullptr;
+}
+
+void PipelineCreationTask::complete(Result result)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_result = result;
+        m_done.store(true, std::memory_order_release);
+    }
+    m_condition.notify_all();
+}
+
+bool PipelineCreationTask::isReady()
+{
+    return m_done.load(std::memory_order_acquire);
+}
+
+Result PipelineCreationTask::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return m_done.load(std::memory_order_relaxed); });
+    return m_result;
+}
+
 } // namespace rhi
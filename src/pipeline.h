@@ -9,6 +9,10 @@
 #include "rhi-shared-fwd.h"
 #include "device-child.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 namespace rhi {
 
 enum class PipelineType
@@ -32,6 +36,11 @@ public:
     virtual bool isVirtual() const { return false; }
     virtual Pipeline* getConcretePipeline() const { return nullptr; }
     virtual void setConcretePipeline(Pipeline* pipeline) {}
+
+    /// Set while the concrete pipeline is created asynchronously, see `Device::createPipelineAsync()`.
+    std::atomic<bool> m_isCreatingAsync = false;
+    /// Pipeline used in place of this one while it is created asynchronously.
+    RefPtr<Pipeline> m_asyncFallback;
 };
 
 class RenderPipeline : public IRenderPipeline, public Pipeline
@@ -58,12 +67,22 @@ class VirtualRenderPipeline : public RenderPipeline
 {
 public:
     RefPtr<Pipeline> m_concretePipeline;
+    /// Set once the concrete pipeline is created, so that binds can look it up without locking.
+    std::atomic<Pipeline*> m_publishedConcretePipeline = nullptr;
 
     VirtualRenderPipeline(Device* device, const RenderPipelineDesc& desc);
+    ~VirtualRenderPipeline() override;
 
     virtual bool isVirtual() const override { return true; }
-    virtual Pipeline* getConcretePipeline() const override { return m_concretePipeline.get(); }
-    virtual void setConcretePipeline(Pipeline* pipeline) override { m_concretePipeline = pipeline; }
+    virtual Pipeline* getConcretePipeline() const override
+    {
+        return m_publishedConcretePipeline.load(std::memory_order_acquire);
+    }
+    virtual void setConcretePipeline(Pipeline* pipeline) override
+    {
+        m_concretePipeline = pipeline;
+        m_publishedConcretePipeline.store(pipeline, std::memory_order_release);
+    }
 
     // IRenderPipeline interface
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
@@ -92,12 +111,22 @@ class VirtualComputePipeline : public ComputePipeline
 {
 public:
     RefPtr<Pipeline> m_concretePipeline;
+    /// Set once the concrete pipeline is created, so that binds can look it up without locking.
+    std::atomic<Pipeline*> m_publishedConcretePipeline = nullptr;
 
     VirtualComputePipeline(Device* device, const ComputePipelineDesc& desc);
+    ~VirtualComputePipeline() override;
 
     virtual bool isVirtual() const override { return true; }
-    virtual Pipeline* getConcretePipeline() const override { return m_concretePipeline.get(); }
-    virtual void setConcretePipeline(Pipeline* pipeline) override { m_concretePipeline = pipeline; }
+    virtual Pipeline* getConcretePipeline() const override
+    {
+        return m_publishedConcretePipeline.load(std::memory_order_acquire);
+    }
+    virtual void setConcretePipeline(Pipeline* pipeline) override
+    {
+        m_concretePipeline = pipeline;
+        m_publishedConcretePipeline.store(pipeline, std::memory_order_release);
+    }
 
     // IComputePipeline interface
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
@@ -126,15 +155,45 @@ class VirtualRayTracingPipeline : public RayTracingPipeline
 {
 public:
     RefPtr<Pipeline> m_concretePipeline;
+    /// Set once the concrete pipeline is created, so that binds can look it up without locking.
+    std::atomic<Pipeline*> m_publishedConcretePipeline = nullptr;
 
     VirtualRayTracingPipeline(Device* device, const RayTracingPipelineDesc& desc);
+    ~VirtualRayTracingPipeline() override;
 
     virtual bool isVirtual() const override { return true; }
-    virtual Pipeline* getConcretePipeline() const override { return m_concretePipeline.get(); }
-    virtual void setConcretePipeline(Pipeline* pipeline) override { m_concretePipeline = pipeline; }
+    virtual Pipeline* getConcretePipeline() const override
+    {
+        return m_publishedConcretePipeline.load(std::memory_order_acquire);
+    }
+    virtual void setConcretePipeline(Pipeline* pipeline) override
+    {
+        m_concretePipeline = pipeline;
+        m_publishedConcretePipeline.store(pipeline, std::memory_order_release);
+    }
 
     // IRayTracingPipeline interface
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
 };
 
+class PipelineCreationTask : public IPipelineCreationTask, public ComObject
+{
+public:
+    SLANG_COM_OBJECT_IUNKNOWN_ALL
+    IPipelineCreationTask* getInterface(const Guid& guid);
+
+    /// Store the result of the pipeline creation and wake up waiting threads.
+    void complete(Result result);
+
+    // IPipelineCreationTask interface
+    virtual SLANG_NO_THROW bool SLANG_MCALL isReady() override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL wait() override;
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::atomic<bool> m_done = false;
+    Result m_result = SLANG_OK;
+};
+
 } // namespace rhi
@@ -4,6 +4,7 @@
 #include "aftermath.h"
 #include "backend.h"
 #include "debug-layer/debug-device.h"
+#include "file-persistent-cache.h"
 #include "rhi-shared.h"
 #include "shader-object.h"
 
@@ -375,6 +376,11 @@ Result RHI::createBlob(const void* data, size_t size, ISlangBlob** outBlob)
     return SLANG_OK;
 }
 
+Result RHI::createFilePersistentCache(const FilePersistentCacheDesc& desc, IPersistentCache** outCache)
+{
+    return openFilePersistentCache(desc, outCache);
+}
+
 Result RHI::reportLiveObjects()
 {
 #if SLANG_RHI_ENABLE_REF_OBJECT_TRACKING
@@ -38,6 +38,7 @@ public:
     virtual Result createDevice(const DeviceDesc& desc, IDevice** outDevice) override;
 
     virtual Result createBlob(const void* data, size_t size, ISlangBlob** outBlob) override;
+    virtual Result createFilePersistentCache(const FilePersistentCacheDesc& desc, IPersistentCache** outCache) override;
 
     virtual Result reportLiveObjects() override;
     virtual Result setTaskPool(ITaskPool* scheduler) override;
@@ -638,8 +638,9 @@ Result ShaderObject::collectSpecializationArgs(ExtendedShaderObjectTypeList& arg
                 {
                     if (args[i + oldArgsCount].componentID != typeArgs[i].componentID)
                     {
-                        auto dynamicType = m_device->m_slangContext.session->getDynamicType();
-                        args.componentIDs[i + oldArgsCount] = m_device->m_shaderCache.getComponentId(dynamicType);
+                        slang::TypeReflection* dynamicType = m_device->getSlangDynamicType();
+                        args.componentIDs[i + oldArgsCount] =
+                            m_device->m_shaderCache.getSessionTypeComponentId(dynamicType);
                         args.components[i + oldArgsCount] = slang::SpecializationArg::fromType(dynamicType);
                     }
                 }
@@ -672,7 +673,7 @@ Result ShaderObject::writeStructuredBuffer(
     return SLANG_OK;
 }
 
-void ShaderObject::trackResources(std::set<RefPtr<RefObject>>& resources)
+void ShaderObject::trackResources(RefObjectSet& resources)
 {
     for (const auto& slot : m_slots)
     {
@@ -701,12 +702,17 @@ Result ShaderObject::getSpecializedShaderObjectType(ExtendedShaderObjectType* ou
     }
     else
     {
-        m_shaderObjectType.slangType = m_device->m_slangContext.session->specializeType(
-            _getElementTypeLayout()->getType(),
-            specializationArgs.components.data(),
-            specializationArgs.getCount()
-        );
-        m_shaderObjectType.componentID = m_device->m_shaderCache.getComponentId(m_shaderObjectType.slangType);
+        // Sub-object types are collected above, the lock is only held for the session call.
+        {
+            std::lock_guard<std::mutex> frontEndLock(m_device->m_slangFrontEndMutex);
+            m_shaderObjectType.slangType = m_device->m_slangContext.session->specializeType(
+                _getElementTypeLayout()->getType(),
+                specializationArgs.components.data(),
+                specializationArgs.getCount()
+            );
+        }
+        m_shaderObjectType.componentID =
+            m_device->m_shaderCache.getSessionTypeComponentId(m_shaderObjectType.slangType);
     }
     *outType = m_shaderObjectType;
     return SLANG_OK;
@@ -756,9 +762,9 @@ void ShaderObject::setSpecializationArgsForContainerElement(ExtendedShaderObject
         {
             if (m_structuredBufferSpecializationArgs[i].componentID != specializationArgs[i].componentID)
             {
-                auto dynamicType = m_device->m_slangContext.session->getDynamicType();
+                slang::TypeReflection* dynamicType = m_device->getSlangDynamicType();
                 m_structuredBufferSpecializationArgs.componentIDs[i] =
-                    m_device->m_shaderCache.getComponentId(dynamicType);
+                    m_device->m_shaderCache.getSessionTypeComponentId(dynamicType);
                 m_structuredBufferSpecializationArgs.components[i] = slang::SpecializationArg::fromType(dynamicType);
             }
         }
@@ -924,7 +930,7 @@ Result RootShaderObject::collectSpecializationArgs(ExtendedShaderObjectTypeList&
     return SLANG_OK;
 }
 
-void RootShaderObject::trackResources(std::set<RefPtr<RefObject>>& resources)
+void RootShaderObject::trackResources(RefObjectSet& resources)
 {
     ShaderObject::trackResources(resources);
     for (const auto& entryPoint : m_entryPoints)
@@ -5,6 +5,7 @@
 #include "core/common.h"
 #include "core/short_vector.h"
 #include "core/block-allocator.h"
+#include "core/ref-object-set.h"
 
 #include "reference.h"
 
@@ -12,8 +13,6 @@
 
 #include "rhi-shared-fwd.h"
 
-#include <set>
-
 namespace rhi {
 
 struct ShaderObjectID
@@ -299,7 +298,7 @@ public:
         IBuffer** buffer
     );
 
-    void trackResources(std::set<RefPtr<RefObject>>& resources);
+    void trackResources(RefObjectSet& resources);
 
 protected:
     inline void incrementVersion() { m_version++; }
@@ -354,7 +353,7 @@ public:
 
     virtual Result collectSpecializationArgs(ExtendedShaderObjectTypeList& args) override;
 
-    void trackResources(std::set<RefPtr<RefObject>>& resources);
+    void trackResources(RefObjectSet& resources);
 };
 
 bool _doesValueFitInExistentialPayload(
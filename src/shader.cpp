@@ -136,6 +136,8 @@ Result ShaderProgram::compileShaders(Device* device)
 
 Result ShaderProgram::prepareEntryPointCompilation(Device* device, std::vector<CompiledEntryPoint>& outEntryPoints)
 {
+    std::lock_guard<std::mutex> frontEndLock(device->m_slangFrontEndMutex);
+
     outEntryPoints.clear();
 
     auto appendEntryPoint = [&](slang::IComponentType* componentType, uint32_t entryPointIndex) -> Result
@@ -49,6 +49,10 @@ struct SpecializationKey
     short_vector<ShaderComponentID> componentIDs;
 
     SpecializationKey(const ExtendedShaderObjectTypeList& args);
+    SpecializationKey(const short_vector<ShaderComponentID>& componentIDs_)
+        : componentIDs(componentIDs_)
+    {
+    }
 
     bool operator==(const SpecializationKey& rhs) const { return componentIDs == rhs.componentIDs; }
 
@@ -97,6 +101,10 @@ public:
     std::mutex m_specializedProgramsMutex;
     std::unordered_map<SpecializationKey, RefPtr<ShaderProgram>, SpecializationKey::Hasher> m_specializedPrograms;
 
+    /// Key identifying the program in pipeline manifests, computed on first use.
+    /// Guarded by the device's Slang front-end lock, see `Device::getPipelineManifestProgramKey()`.
+    std::string m_pipelineManifestKey;
+
     ShaderProgram(Device* device, const ShaderProgramDesc& desc);
     virtual ~ShaderProgram() override;
 
@@ -107,7 +115,8 @@ public:
 
     Result compileShaders(Device* device);
 
-    /// Must be called while holding m_compileMutex. Performs only front-end/reflection work.
+    /// Must be called while holding m_compileMutex. Performs only front-end/reflection work,
+    /// under the device's Slang front-end lock.
     Result prepareEntryPointCompilation(Device* device, std::vector<CompiledEntryPoint>& outEntryPoints);
 
     /// Performs the concurrency-safe backend code generation operation for one prepared entry point.
@@ -190,6 +190,39 @@ Result StagingHeap::unmap(const Allocation& allocation)
         return SLANG_OK;
 }
 
+Result StagingHeap::mapPageBuffer(Buffer* buffer, void** outAddress)
+{
+    Page* page = findPage(buffer);
+    if (!page)
+        return SLANG_E_NOT_FOUND;
+    if (!m_keepPagesMapped)
+        SLANG_RETURN_ON_FAIL(page->map(m_device));
+    *outAddress = page->getMapped();
+    return SLANG_OK;
+}
+
+Result StagingHeap::unmapPageBuffer(Buffer* buffer)
+{
+    Page* page = findPage(buffer);
+    if (!page)
+        return SLANG_E_NOT_FOUND;
+    if (!m_keepPagesMapped)
+        return page->unmap(m_device);
+    else
+        return SLANG_OK;
+}
+
+StagingHeap::Page* StagingHeap::findPage(Buffer* buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& page : m_pages)
+    {
+        if (page.second->getBuffer() == buffer)
+            return page.second.get();
+    }
+    return nullptr;
+}
+
 void StagingHeap::free(Allocation allocation)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
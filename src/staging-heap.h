@@ -214,6 +214,13 @@ public:
     // Unmap memory for allocation if necessary (for heap that keeps pages mapped, this is noop)
     Result unmap(const Allocation& allocation);
 
+    // Map the page whose device buffer is `buffer` (if not mapped already) and return ptr to it.
+    // Returns SLANG_E_NOT_FOUND if the buffer is not a page of this heap.
+    Result mapPageBuffer(Buffer* buffer, void** outAddress);
+
+    // Unmap a page mapped with mapPageBuffer if necessary.
+    Result unmapPageBuffer(Buffer* buffer);
+
 private:
     Device* m_device = nullptr;
     int m_nextPageId = 1;
@@ -236,6 +243,8 @@ private:
     void freePage(StagingHeap::Page* page);
 
     void releaseAllFreePages();
+
+    Page* findPage(Buffer* buffer);
 };
 
 } // namespace rhi
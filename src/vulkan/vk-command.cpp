@@ -147,7 +147,9 @@ Result CommandRecorder::record(CommandBufferImpl* commandBuffer)
 #endif
 
     VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    // Reusable command buffers may be resubmitted while a previous submission is still pending.
+    beginInfo.flags = commandBuffer->isReusable() ? VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT
+                                                  : VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     SLANG_VK_RETURN_ON_FAIL_REPORT(m_api.vkBeginCommandBuffer(m_cmdBuffer, &beginInfo), m_device);
 
     CommandList& commandList = commandBuffer->m_commandList;
@@ -180,6 +182,7 @@ Result CommandRecorder::record(CommandBufferImpl* commandBuffer)
         cmd##x(commandList.getCommand<commands::x>(slot));                                                             \
         break;
 
+        SLANG_RHI_COMMAND_PROFILE_SCOPE(&m_device->m_commandProfiler, Execute, slot->id);
         switch (slot->id)
         {
             SLANG_RHI_COMMANDS(SLANG_RHI_COMMAND_EXECUTE_X);
@@ -1912,6 +1915,10 @@ Result CommandQueueImpl::getOrCreateCommandBuffer(CommandBufferImpl** outCommand
 
 void CommandQueueImpl::retireCommandBuffer(CommandBufferImpl* commandBuffer)
 {
+    for (CommandBuffer* childCommandBuffer : commandBuffer->m_childCommandBuffers)
+    {
+        retireCommandBuffer(checked_cast<CommandBufferImpl*>(childCommandBuffer));
+    }
     commandBuffer->reset();
     {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -1930,7 +1937,9 @@ void CommandQueueImpl::retireCommandBuffers()
     {
         if (commandBuffer->m_submissionID <= lastFinishedID)
         {
-            retireCommandBuffer(commandBuffer);
+            // Reusable command buffers keep their recording and are released with their last reference.
+            if (!commandBuffer->isReusable())
+                retireCommandBuffer(commandBuffer);
         }
         else
         {
@@ -2181,8 +2190,25 @@ Result CommandEncoderImpl::getBindingData(RootShaderObject* rootObject, BindingD
     );
 }
 
+Result CommandEncoderImpl::createChildEncoderImpl(CommandEncoder** outEncoder)
+{
+    RefPtr<CommandEncoderImpl> encoder = new CommandEncoderImpl(m_device, m_queue, m_desc);
+    SLANG_RETURN_ON_FAIL(encoder->init());
+    returnRefPtr(outEncoder, encoder);
+    return SLANG_OK;
+}
+
+Result CommandEncoderImpl::detachCommandBuffer(CommandBuffer** outCommandBuffer)
+{
+    m_commandBuffer->m_constantBufferPool.finish();
+    returnRefPtrMove(outCommandBuffer, m_commandBuffer);
+    m_commandList = nullptr;
+    return SLANG_OK;
+}
+
 Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer** outCommandBuffer)
 {
+    SLANG_RETURN_ON_FAIL(finishChildEncoders(m_commandBuffer));
     DeviceImpl* device = getDevice<DeviceImpl>();
     bool hadLabel = m_commandBuffer->m_desc.label != nullptr;
     m_commandBuffer->setDesc(desc);
@@ -2195,6 +2221,7 @@ Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer*
         );
     }
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
+    m_commandBuffer->optimizeCommands();
     m_commandBuffer->m_constantBufferPool.finish();
     CommandRecorder recorder(getDevice<DeviceImpl>());
     SLANG_RETURN_ON_FAIL(recorder.record(m_commandBuffer));
@@ -111,6 +111,10 @@ Result CommandRecorder::record(CommandBufferImpl* commandBuffer, const char* enc
 
     // Upload constant buffer data
     commandBuffer->m_constantBufferPool.upload(m_ctx, m_commandEncoder);
+    for (CommandBuffer* childCommandBuffer : commandBuffer->m_childCommandBuffers)
+    {
+        checked_cast<CommandBufferImpl*>(childCommandBuffer)->m_constantBufferPool.upload(m_ctx, m_commandEncoder);
+    }
 
     const CommandList& commandList = commandBuffer->m_commandList;
     auto command = commandList.getCommands();
@@ -121,6 +125,7 @@ Result CommandRecorder::record(CommandBufferImpl* commandBuffer, const char* enc
         cmd##x(commandList.getCommand<commands::x>(command));                                                          \
         break;
 
+        SLANG_RHI_COMMAND_PROFILE_SCOPE(&m_device->m_commandProfiler, Execute, command->id);
         switch (command->id)
         {
             SLANG_RHI_COMMANDS(SLANG_RHI_COMMAND_EXECUTE_X);
@@ -926,7 +931,13 @@ Result CommandQueueImpl::submit(const SubmitDesc& desc)
     short_vector<WGPUCommandBuffer, 16> commandBuffers;
     for (uint32_t i = 0; i < desc.commandBufferCount; i++)
     {
-        commandBuffers.push_back(checked_cast<CommandBufferImpl*>(desc.commandBuffers[i])->m_commandBuffer);
+        CommandBufferImpl* commandBuffer = checked_cast<CommandBufferImpl*>(desc.commandBuffers[i]);
+        if (commandBuffer->m_submitted && commandBuffer->isReusable())
+        {
+            SLANG_RETURN_ON_FAIL(commandBuffer->rerecord());
+        }
+        commandBuffer->m_submitted = true;
+        commandBuffers.push_back(commandBuffer->m_commandBuffer);
     }
     device->m_ctx.api.wgpuQueueSubmit(m_queue, commandBuffers.size(), commandBuffers.data());
 
@@ -1016,10 +1027,27 @@ Result CommandEncoderImpl::getBindingData(RootShaderObject* rootObject, BindingD
     );
 }
 
+Result CommandEncoderImpl::createChildEncoderImpl(CommandEncoder** outEncoder)
+{
+    RefPtr<CommandEncoderImpl> encoder = new CommandEncoderImpl(m_device, m_queue, m_desc);
+    returnRefPtr(outEncoder, encoder);
+    return SLANG_OK;
+}
+
+Result CommandEncoderImpl::detachCommandBuffer(CommandBuffer** outCommandBuffer)
+{
+    m_commandBuffer->m_constantBufferPool.finish();
+    returnRefPtrMove(outCommandBuffer, m_commandBuffer);
+    m_commandList = nullptr;
+    return SLANG_OK;
+}
+
 Result CommandEncoderImpl::finish(const CommandBufferDesc& desc, ICommandBuffer** outCommandBuffer)
 {
+    SLANG_RETURN_ON_FAIL(finishChildEncoders(m_commandBuffer));
     m_commandBuffer->setDesc(desc);
     SLANG_RETURN_ON_FAIL(resolvePipelines(m_device));
+    m_commandBuffer->optimizeCommands();
     m_commandBuffer->m_constantBufferPool.finish();
     CommandRecorder recorder(getDevice<DeviceImpl>());
     SLANG_RETURN_ON_FAIL(recorder.record(m_commandBuffer, m_desc.label));
@@ -1063,6 +1091,19 @@ Result CommandBufferImpl::reset()
     return CommandBuffer::reset();
 }
 
+Result CommandBufferImpl::rerecord()
+{
+    DeviceImpl* device = getDevice<DeviceImpl>();
+    if (m_commandBuffer)
+    {
+        device->m_ctx.api.wgpuCommandBufferRelease(m_commandBuffer);
+        m_commandBuffer = nullptr;
+    }
+    m_submitted = false;
+    CommandRecorder recorder(device);
+    return recorder.record(this, m_desc.label);
+}
+
 Result CommandBufferImpl::getNativeHandle(NativeHandle* outHandle)
 {
     outHandle->type = NativeHandleType::WGPUCommandBuffer;
@@ -36,6 +36,8 @@ public:
     Result init();
 
     virtual Result getBindingData(RootShaderObject* rootObject, BindingData*& outBindingData) override;
+    virtual Result createChildEncoderImpl(CommandEncoder** outEncoder) override;
+    virtual Result detachCommandBuffer(CommandBuffer** outCommandBuffer) override;
 
     // ICommandEncoder implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL finish(
@@ -52,12 +54,19 @@ public:
     WGPUCommandBuffer m_commandBuffer = nullptr;
     ConstantBufferPool m_constantBufferPool;
     BindingCache m_bindingCache;
+    /// Set once the native command buffer has been submitted.
+    bool m_submitted = false;
 
     CommandBufferImpl(Device* device, CommandQueueImpl* queue);
     ~CommandBufferImpl();
 
     virtual Result reset() override;
 
+    /// Record the command list into a new WebGPU command buffer.
+    /// WebGPU command buffers can only be submitted once, so reusable command buffers are re-recorded from their
+    /// immutable command list before every submission after the first.
+    Result rerecord();
+
     // ICommandBuffer implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL getNativeHandle(NativeHandle* outHandle) override;
 };
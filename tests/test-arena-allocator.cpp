@@ -122,4 +122,65 @@ TEST_CASE("arena-allocator")
         uintptr_t bEnd = bBegin + 32;
         CHECK_UNARY((bBegin >= aEnd) || (bEnd <= aBegin));
     }
+
+    SUBCASE("large-allocation")
+    {
+        ArenaAllocator allocator(1024);
+
+        // Allocations larger than a page are allocated separately and do not add pages.
+        void* a = allocator.allocate(4096, 64);
+        CHECK(a != nullptr);
+        CHECK(((uintptr_t)a % 64) == 0);
+        std::memset(a, 0xAB, 4096);
+        CHECK_EQ(allocator.getStats().pageCount, 0);
+        CHECK_EQ(allocator.getStats().largeAllocationCount, 1);
+
+        void* b = allocator.allocate(32, 16);
+        CHECK(b != nullptr);
+        CHECK_EQ(allocator.getStats().pageCount, 1);
+        CHECK_EQ(allocator.getStats().usedBytes, 4096 + 32);
+
+        // Large allocations are freed on reset.
+        allocator.reset();
+        CHECK_EQ(allocator.getStats().largeAllocationCount, 0);
+        CHECK_EQ(allocator.getStats().pageCount, 1);
+        CHECK_EQ(allocator.getStats().reservedBytes, 1024);
+        CHECK_EQ(allocator.getStats().usedBytes, 0);
+        CHECK_EQ(allocator.getStats().peakUsedBytes, 4096 + 32);
+    }
+
+    SUBCASE("trim")
+    {
+        ArenaAllocator allocator(1024, 2);
+
+        for (size_t i = 0; i < 100; i++)
+            allocator.allocate(100);
+        size_t peakPageCount = allocator.getStats().pageCount;
+        CHECK_GT(peakPageCount, 1);
+
+        // Pages stay available for reuse for a number of resets.
+        allocator.reset();
+        CHECK_EQ(allocator.getStats().pageCount, peakPageCount);
+        for (size_t i = 0; i < 2; i++)
+        {
+            allocator.allocate(100);
+            allocator.reset();
+            CHECK_EQ(allocator.getStats().pageCount, peakPageCount);
+        }
+
+        // Pages unused for longer are freed, pages in use are kept.
+        allocator.allocate(100);
+        allocator.reset();
+        CHECK_EQ(allocator.getStats().pageCount, 1);
+        CHECK_EQ(allocator.getStats().reservedBytes, 1024);
+        CHECK_GE(allocator.getStats().peakReservedBytes, peakPageCount * 1024);
+
+        // Freed pages are allocated again when needed.
+        for (size_t i = 0; i < 100; i++)
+        {
+            void* a = allocator.allocate(100);
+            std::memset(a, 0xAB, 100);
+        }
+        CHECK_EQ(allocator.getStats().pageCount, peakPageCount);
+    }
 }
@@ -30,7 +30,7 @@ Result getSizeAndMakeBuffer(TextureTestContext* c, uint64_t* outSize, IBuffer**
     return c->getDevice()->createBuffer(bufferDesc, nullptr, outBuffer);
 }
 
-GPU_TEST_CASE("cmd-copy-texture-to-buffer-full", D3D12 | Vulkan | Metal | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-to-buffer-full", D3D12 | Vulkan | Metal | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(
@@ -120,7 +120,7 @@ GPU_TEST_CASE("cmd-copy-texture-to-buffer-full", D3D12 | Vulkan | Metal | WGPU |
 }
 
 // Tests copying data at a different alignment to that returned by getSubresourceLayout
-GPU_TEST_CASE("cmd-copy-texture-to-buffer-rowalignment", D3D12 | Vulkan | Metal | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-to-buffer-rowalignment", D3D12 | Vulkan | Metal | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(
@@ -241,7 +241,7 @@ GPU_TEST_CASE("cmd-copy-texture-to-buffer-rowalignment", D3D12 | Vulkan | Metal
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-to-buffer-offset", D3D12 | Vulkan | Metal | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-to-buffer-offset", D3D12 | Vulkan | Metal | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(
@@ -346,7 +346,7 @@ GPU_TEST_CASE("cmd-copy-texture-to-buffer-offset", D3D12 | Vulkan | Metal | WGPU
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-to-buffer-sizeoffset", D3D12 | Vulkan | Metal | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-to-buffer-sizeoffset", D3D12 | Vulkan | Metal | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(
@@ -453,7 +453,7 @@ GPU_TEST_CASE("cmd-copy-texture-to-buffer-sizeoffset", D3D12 | Vulkan | Metal |
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-to-buffer-offset-mip1", D3D12 | Vulkan | Metal | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-to-buffer-offset-mip1", D3D12 | Vulkan | Metal | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(
@@ -559,7 +559,7 @@ GPU_TEST_CASE("cmd-copy-texture-to-buffer-offset-mip1", D3D12 | Vulkan | Metal |
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-to-buffer-sizeoffset-mip1", D3D12 | Vulkan | Metal | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-to-buffer-sizeoffset-mip1", D3D12 | Vulkan | Metal | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(
@@ -9,7 +9,7 @@
 using namespace rhi;
 using namespace rhi::testing;
 
-GPU_TEST_CASE("cmd-copy-texture-full", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-full", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(
@@ -63,7 +63,7 @@ GPU_TEST_CASE("cmd-copy-texture-full", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-arrayrange", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-arrayrange", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::On, TTMip::Both, TTFmtDepth::Off);
@@ -117,7 +117,7 @@ GPU_TEST_CASE("cmd-copy-texture-arrayrange", D3D11 | D3D12 | Vulkan | WGPU | CUD
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-miprange", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-miprange", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTMip::On, TTFmtDepth::Off);
@@ -172,7 +172,7 @@ GPU_TEST_CASE("cmd-copy-texture-miprange", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-fromarray", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-fromarray", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::D1 | TTShape::D2, TTArray::On, TTMip::Both, TTFmtDepth::Off);
@@ -220,7 +220,7 @@ GPU_TEST_CASE("cmd-copy-texture-fromarray", D3D11 | D3D12 | Vulkan | WGPU | CUDA
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-toarray", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-toarray", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::D1 | TTShape::D2, TTArray::On, TTMip::Both, TTFmtDepth::Off, TextureInitMode::None);
@@ -271,7 +271,7 @@ GPU_TEST_CASE("cmd-copy-texture-toarray", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-fromslice", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-fromslice", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::D3, TTArray::Off, TTMip::Both, TTFmtDepth::Off);
@@ -323,7 +323,7 @@ GPU_TEST_CASE("cmd-copy-texture-fromslice", D3D11 | D3D12 | Vulkan | WGPU | CUDA
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-arrayfromslice", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-arrayfromslice", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::D3, TTArray::Off, TTMip::Both, TTFmtDepth::Off);
@@ -376,7 +376,7 @@ GPU_TEST_CASE("cmd-copy-texture-arrayfromslice", D3D11 | D3D12 | Vulkan | WGPU |
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-toslice", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-toslice", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::D3, TTArray::Off, TTMip::Off, TTFmtDepth::Off, TextureInitMode::Invalid);
@@ -446,7 +446,7 @@ GPU_TEST_CASE("cmd-copy-texture-toslice", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-offset-nomip", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-offset-nomip", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTFmtDepth::Off);
@@ -496,7 +496,7 @@ GPU_TEST_CASE("cmd-copy-texture-offset-nomip", D3D11 | D3D12 | Vulkan | WGPU | C
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-sizeoffset-nomip", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-sizeoffset-nomip", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTFmtDepth::Off);
@@ -546,7 +546,7 @@ GPU_TEST_CASE("cmd-copy-texture-sizeoffset-nomip", D3D11 | D3D12 | Vulkan | WGPU
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-smalltolarge", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-smalltolarge", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTFmtDepth::Off);
@@ -594,7 +594,7 @@ GPU_TEST_CASE("cmd-copy-texture-smalltolarge", D3D11 | D3D12 | Vulkan | WGPU | C
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-largetosmall", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-largetosmall", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTFmtDepth::Off);
@@ -647,7 +647,7 @@ GPU_TEST_CASE("cmd-copy-texture-largetosmall", D3D11 | D3D12 | Vulkan | WGPU | C
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-acrossmips", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-acrossmips", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTMip::On, TTFmtDepth::Off);
@@ -749,7 +749,7 @@ GPU_TEST_CASE("cmd-copy-texture-compressed-npot-mips", Metal | Vulkan | WGPU)
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-offset-mip1", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-offset-mip1", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTMip::On, TTFmtDepth::Off);
@@ -808,7 +808,7 @@ GPU_TEST_CASE("cmd-copy-texture-offset-mip1", D3D11 | D3D12 | Vulkan | WGPU | CU
     );
 }
 
-GPU_TEST_CASE("cmd-copy-texture-offset-mip1", D3D11 | D3D12 | Vulkan | WGPU | CUDA)
+GPU_TEST_CASE("cmd-copy-texture-offset-mip1", D3D11 | D3D12 | Vulkan | WGPU | CUDA | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTMip::On, TTFmtDepth::Off);
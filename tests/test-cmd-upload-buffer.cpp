@@ -49,6 +49,16 @@ struct UploadData
     }
 };
 
+// Expected upload heap usage after staging `count` uploads of `size` bytes with a single encoder.
+Size getExpectedHeapUsage(StagingHeap& heap, Size size, int count)
+{
+    if (size > CommandEncoder::kMaxBatchedUploadSize)
+        return heap.alignAllocationSize(size) * count;
+    // Small uploads are packed into the encoder's staging blocks.
+    Size uploadsPerBlock = CommandEncoder::kUploadBlockSize / calcAligned2(size, 4);
+    return heap.alignAllocationSize(CommandEncoder::kUploadBlockSize) * divideRoundedUp(count, uploadsPerBlock);
+}
+
 void testUploadToBuffer(IDevice* device, Size size, Offset offset, int tests, bool multi_encoder = false)
 {
     // Ensure any previous operations have finished so we can safely check heap usage.
@@ -70,7 +80,7 @@ void testUploadToBuffer(IDevice* device, Size size, Offset offset, int tests, bo
             auto encoder = queue->createCommandEncoder();
             for (int i = 0; i < tests; i++)
                 encoder->uploadBufferData(uploads[i].dst, uploads[i].offset, uploads[i].size, uploads[i].data.data());
-            CHECK_EQ(heap.getUsed(), heap.alignAllocationSize(uploads[0].size) * tests);
+            CHECK_EQ(heap.getUsed(), getExpectedHeapUsage(heap, uploads[0].size, tests));
             queue->submit(encoder->finish());
         }
         else
@@ -119,3 +129,43 @@ GPU_TEST_CASE("cmd-upload-buffer-multienc", ALL)
 {
     testUploadToBuffer(device, 16, 0, 30);
 }
+
+GPU_TEST_CASE("cmd-upload-buffer-coalesce", ALL)
+{
+    std::vector<uint8_t> data(1024);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = uint8_t(i * 7 + 3);
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = data.size();
+    bufferDesc.usage = BufferUsage::CopyDestination | BufferUsage::CopySource;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, buffer.writeRef()));
+    ComPtr<IBuffer> otherBuffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, otherBuffer.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    // Adjacent uploads to the same buffer are merged into a single copy.
+    for (size_t offset = 0; offset < 512; offset += 64)
+        REQUIRE_CALL(encoder->uploadBufferData(buffer, offset, 64, data.data() + offset));
+    // Uploads to another buffer or to a non-adjacent range start a new copy.
+    REQUIRE_CALL(encoder->uploadBufferData(otherBuffer, 0, 64, data.data()));
+    REQUIRE_CALL(encoder->uploadBufferData(buffer, 768, 256, data.data() + 768));
+    REQUIRE_CALL(encoder->uploadBufferData(buffer, 512, 256, data.data() + 512));
+    ComPtr<ICommandBuffer> commandBuffer;
+    REQUIRE_CALL(encoder->finish(commandBuffer.writeRef()));
+
+    CommandBufferStats stats;
+    REQUIRE_CALL(commandBuffer->getStats(&stats));
+    CHECK_EQ(stats.commandCount, 4);
+
+    REQUIRE_CALL(queue->submit(commandBuffer));
+    REQUIRE_CALL(queue->waitOnHost());
+
+    ComPtr<ISlangBlob> blob;
+    REQUIRE_CALL(device->readBuffer(buffer, 0, data.size(), blob.writeRef()));
+    CHECK_EQ(memcmp(blob->getBufferPointer(), data.data(), data.size()), 0);
+    REQUIRE_CALL(device->readBuffer(otherBuffer, 0, 64, blob.writeRef()));
+    CHECK_EQ(memcmp(blob->getBufferPointer(), data.data(), 64), 0);
+}
@@ -7,7 +7,7 @@
 using namespace rhi;
 using namespace rhi::testing;
 
-GPU_TEST_CASE("cmd-upload-texture-simple", D3D12 | Vulkan | Metal | CUDA | WGPU)
+GPU_TEST_CASE("cmd-upload-texture-simple", D3D12 | Vulkan | Metal | CUDA | WGPU | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTMip::Both, TextureInitMode::None, TTFmtDepth::Off);
@@ -44,7 +44,7 @@ GPU_TEST_CASE("cmd-upload-texture-simple", D3D12 | Vulkan | Metal | CUDA | WGPU)
     );
 }
 
-GPU_TEST_CASE("cmd-upload-texture-subresource-offset-alignment", D3D12 | Vulkan | Metal | CUDA | WGPU)
+GPU_TEST_CASE("cmd-upload-texture-subresource-offset-alignment", D3D12 | Vulkan | Metal | CUDA | WGPU | CPU)
 {
     TextureTestOptions options(device);
     // The generated 33x17 texture has mip sizes that are not all multiples of
@@ -112,7 +112,7 @@ GPU_TEST_CASE("cmd-upload-texture-compressed-npot-mips", Metal | Vulkan | WGPU)
     );
 }
 
-GPU_TEST_CASE("cmd-upload-texture-single-layer", D3D12 | Vulkan | Metal | CUDA | WGPU)
+GPU_TEST_CASE("cmd-upload-texture-single-layer", D3D12 | Vulkan | Metal | CUDA | WGPU | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::On, TTMip::Both, TextureInitMode::Random, TTFmtDepth::Off);
@@ -167,7 +167,7 @@ GPU_TEST_CASE("cmd-upload-texture-single-layer", D3D12 | Vulkan | Metal | CUDA |
     );
 }
 
-GPU_TEST_CASE("cmd-upload-texture-single-mip", D3D12 | Vulkan | Metal | CUDA | WGPU)
+GPU_TEST_CASE("cmd-upload-texture-single-mip", D3D12 | Vulkan | Metal | CUDA | WGPU | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::On, TTMip::On, TextureInitMode::Random, TTFmtDepth::Off);
@@ -228,7 +228,7 @@ GPU_TEST_CASE("cmd-upload-texture-single-mip", D3D12 | Vulkan | Metal | CUDA | W
     );
 }
 
-GPU_TEST_CASE("cmd-upload-texture-multisubmit", D3D12 | Vulkan | Metal | CUDA | WGPU)
+GPU_TEST_CASE("cmd-upload-texture-multisubmit", D3D12 | Vulkan | Metal | CUDA | WGPU | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::On, TTMip::On, TextureInitMode::Random, TTFmtDepth::Off);
@@ -284,7 +284,7 @@ GPU_TEST_CASE("cmd-upload-texture-multisubmit", D3D12 | Vulkan | Metal | CUDA |
     );
 }
 
-GPU_TEST_CASE("cmd-upload-texture-offset", D3D12 | Vulkan | Metal | CUDA | WGPU)
+GPU_TEST_CASE("cmd-upload-texture-offset", D3D12 | Vulkan | Metal | CUDA | WGPU | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTMip::Off, TextureInitMode::Random, TTFmtDepth::Off);
@@ -339,7 +339,7 @@ GPU_TEST_CASE("cmd-upload-texture-offset", D3D12 | Vulkan | Metal | CUDA | WGPU)
     );
 }
 
-GPU_TEST_CASE("cmd-upload-texture-sizeoffset", D3D12 | Vulkan | Metal | CUDA | WGPU)
+GPU_TEST_CASE("cmd-upload-texture-sizeoffset", D3D12 | Vulkan | Metal | CUDA | WGPU | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(TTShape::All, TTArray::Both, TTMip::Off, TextureInitMode::Random, TTFmtDepth::Off);
@@ -397,7 +397,7 @@ GPU_TEST_CASE("cmd-upload-texture-sizeoffset", D3D12 | Vulkan | Metal | CUDA | W
     );
 }
 
-GPU_TEST_CASE("cmd-upload-texture-mipsizeoffset", D3D12 | Vulkan | Metal | CUDA | WGPU)
+GPU_TEST_CASE("cmd-upload-texture-mipsizeoffset", D3D12 | Vulkan | Metal | CUDA | WGPU | CPU)
 {
     TextureTestOptions options(device);
     options.addVariants(
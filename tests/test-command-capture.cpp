@@ -0,0 +1,84 @@
+#include "testing.h"
+
+#include "../src/command-capture.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+GPU_TEST_CASE("command-capture-replay", ALL)
+{
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = 4 * sizeof(uint32_t);
+    bufferDesc.elementSize = sizeof(uint32_t);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> srcBuffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, srcBuffer.writeRef()));
+    ComPtr<IBuffer> dstBuffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, dstBuffer.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    uint32_t data[] = {1, 2, 3, 4};
+    REQUIRE_CALL(encoder->uploadBufferData(srcBuffer, 0, sizeof(data), data));
+    encoder->pushDebugGroup("capture", {});
+    encoder->copyBuffer(dstBuffer, 0, srcBuffer, 0, sizeof(data));
+    encoder->popDebugGroup();
+    encoder->clearBuffer(srcBuffer, 0, 2 * sizeof(uint32_t));
+    ComPtr<ICommandBuffer> commandBuffer;
+    REQUIRE_CALL(encoder->finish(commandBuffer.writeRef()));
+
+    // Capture before submitting, staged upload data is released after execution.
+    ComPtr<ISlangBlob> blob;
+    REQUIRE_CALL(commandBuffer->captureTransfers(blob.writeRef()));
+    REQUIRE(blob);
+    REQUIRE_CALL(queue->submit(commandBuffer));
+    REQUIRE_CALL(queue->waitOnHost());
+
+    CaptureReplayer replayer;
+    REQUIRE_CALL(replayer.load(blob->getBufferPointer(), blob->getBufferSize()));
+    CHECK_EQ(replayer.getObjectCount(), 2u);
+    CHECK_EQ(replayer.getCommandCount(), 5u);
+    REQUIRE_CALL(replayer.createObjects(device));
+    REQUIRE_CALL(replayer.replay(queue, true));
+
+    // Objects are numbered in order of first reference.
+    REQUIRE(replayer.getObjectType(0) == CaptureObjectType::Buffer);
+    REQUIRE(replayer.getObjectType(1) == CaptureObjectType::Buffer);
+    compareComputeResult(device, replayer.getBuffer(0), makeArray<uint32_t>(0, 0, 3, 4));
+    compareComputeResult(device, replayer.getBuffer(1), makeArray<uint32_t>(1, 2, 3, 4));
+
+    // Corrupted captures are rejected.
+    std::vector<uint8_t> corrupted(
+        (const uint8_t*)blob->getBufferPointer(),
+        (const uint8_t*)blob->getBufferPointer() + blob->getBufferSize()
+    );
+    corrupted[0] ^= 0xff;
+    CHECK(SLANG_FAILED(replayer.load(corrupted.data(), corrupted.size())));
+    CHECK(SLANG_FAILED(replayer.load(blob->getBufferPointer(), blob->getBufferSize() - 1)));
+}
+
+static void SLANG_MCALL emptyExecuteCallback(const ExecuteCallbackContext*, void*, const void*, Size) {}
+
+GPU_TEST_CASE("command-capture-non-transfer", ALL)
+{
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    encoder->insertDebugMarker("capture", {});
+    ExecuteCallbackDesc callbackDesc = {};
+    callbackDesc.callback = emptyExecuteCallback;
+    encoder->executeCallback(callbackDesc);
+    ComPtr<ICommandBuffer> commandBuffer;
+    REQUIRE_CALL(encoder->finish(commandBuffer.writeRef()));
+
+    // Commands depending on pipelines, shader objects or callbacks cannot be captured.
+    ComPtr<ISlangBlob> blob;
+    CHECK_EQ(commandBuffer->captureTransfers(blob.writeRef()), SLANG_E_NOT_AVAILABLE);
+    CHECK(!blob);
+
+    REQUIRE_CALL(queue->submit(commandBuffer));
+    REQUIRE_CALL(queue->waitOnHost());
+}
@@ -1,5 +1,7 @@
 #include "testing.h"
 
+#include <thread>
+
 using namespace rhi;
 using namespace rhi::testing;
 
@@ -36,3 +38,259 @@ GPU_TEST_CASE("command-encoder-labels", ALL)
     CHECK(retrievedBufferDesc.label != nullptr);
     CHECK(std::strcmp(retrievedBufferDesc.label, "test-command-buffer") == 0);
 }
+
+GPU_TEST_CASE("command-buffer-reusable", ALL)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    REQUIRE_CALL(loadProgram(device, "test-compute-trivial", "computeMain", shaderProgram.writeRef()));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = sizeof(initialData);
+    bufferDesc.format = Format::Undefined;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, (void*)initialData, buffer.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+
+    ComPtr<ICommandBuffer> commandBuffer;
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+        auto passEncoder = commandEncoder->beginComputePass();
+        auto rootObject = passEncoder->bindPipeline(pipeline);
+        ShaderCursor shaderCursor(rootObject);
+        shaderCursor["buffer"].setBinding(buffer);
+        shaderCursor["value"].setData(10.f);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->end();
+
+        CommandBufferDesc commandBufferDesc;
+        commandBufferDesc.reusable = true;
+        commandBuffer = commandEncoder->finish(commandBufferDesc);
+        REQUIRE(commandBuffer);
+        CHECK(commandBuffer->getDesc().reusable);
+    }
+
+    // The command buffer retains the pipeline it was recorded with.
+    pipeline.setNull();
+    shaderProgram.setNull();
+
+    // Submit back to back, then again after the queue is idle.
+    REQUIRE_CALL(queue->submit(commandBuffer));
+    REQUIRE_CALL(queue->submit(commandBuffer));
+    REQUIRE_CALL(queue->waitOnHost());
+    REQUIRE_CALL(queue->submit(commandBuffer));
+    REQUIRE_CALL(queue->waitOnHost());
+
+    compareComputeResult(device, buffer, makeArray<float>(33.0f, 34.0f, 35.0f, 36.0f));
+}
+
+GPU_TEST_CASE("command-buffer-optimize", ALL)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    REQUIRE_CALL(loadProgram(device, "test-compute-trivial", "computeMain", shaderProgram.writeRef()));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = sizeof(initialData);
+    bufferDesc.format = Format::Undefined;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, (void*)initialData, buffer.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+
+    auto encode = [&](bool optimize)
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+
+        // Repeated barriers and an empty debug group.
+        commandEncoder->globalBarrier();
+        commandEncoder->globalBarrier();
+        commandEncoder->setBufferState(buffer, ResourceState::UnorderedAccess);
+        commandEncoder->setBufferState(buffer, ResourceState::UnorderedAccess);
+        commandEncoder->pushDebugGroup("empty", {1.f, 0.f, 0.f});
+        commandEncoder->popDebugGroup();
+
+        auto passEncoder = commandEncoder->beginComputePass();
+        auto rootObject = passEncoder->bindPipeline(pipeline);
+        ShaderCursor shaderCursor(rootObject);
+        shaderCursor["buffer"].setBinding(buffer);
+        shaderCursor["value"].setData(10.f);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->end();
+
+        CommandBufferDesc commandBufferDesc;
+        commandBufferDesc.optimizeCommands = optimize;
+        return commandEncoder->finish(commandBufferDesc);
+    };
+
+    auto commandBuffer = encode(false);
+    REQUIRE(commandBuffer);
+    CommandBufferStats stats;
+    REQUIRE_CALL(commandBuffer->getStats(&stats));
+    uint32_t commandCount = stats.commandCount;
+    CHECK_EQ(stats.removedCommandCount, 0);
+    CHECK_GT(stats.memoryUsed, 0);
+    CHECK_GE(stats.memoryPeak, stats.memoryUsed);
+    CHECK_GE(stats.memoryReserved, stats.memoryUsed);
+    REQUIRE_CALL(queue->submit(commandBuffer));
+
+    commandBuffer = encode(true);
+    REQUIRE(commandBuffer);
+    REQUIRE_CALL(commandBuffer->getStats(&stats));
+    // The second global barrier, the second buffer state and the empty debug group are always removed.
+    // The second compute state is removed if the backend reuses the binding data.
+    CHECK_GE(stats.removedCommandCount, 4);
+    CHECK_EQ(stats.commandCount + stats.removedCommandCount, commandCount);
+    REQUIRE_CALL(queue->submit(commandBuffer));
+    REQUIRE_CALL(queue->waitOnHost());
+
+    compareComputeResult(device, buffer, makeArray<float>(44.0f, 45.0f, 46.0f, 47.0f));
+}
+
+GPU_TEST_CASE("command-encoder-child", ALL)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    REQUIRE_CALL(loadProgram(device, "test-compute-trivial", "computeMain", shaderProgram.writeRef()));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    static constexpr uint32_t kElementCount = 8;
+    float initialData[kElementCount] = {};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = sizeof(initialData);
+    bufferDesc.format = Format::Undefined;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, (void*)initialData, buffer.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto commandEncoder = queue->createCommandEncoder();
+
+    // Writer `index` writes its own value to the elements [index, kElementCount).
+    // Each element ends up holding the value of the last writer covering it, so the final contents
+    // are {10, 20, 30, ...} only if the writers execute in index order.
+    auto write = [&](ICommandEncoder* encoder, uint32_t index)
+    {
+        float data[kElementCount];
+        for (uint32_t i = 0; i < kElementCount; ++i)
+            data[i] = float(index + 1) * 10.0f;
+        uint32_t offset = index * sizeof(float);
+        encoder->uploadBufferData(buffer, offset, sizeof(data) - offset, data);
+    };
+    // Adds 11 to the first 4 elements.
+    auto dispatch = [&](ICommandEncoder* encoder)
+    {
+        auto passEncoder = encoder->beginComputePass();
+        auto rootObject = passEncoder->bindPipeline(pipeline);
+        ShaderCursor shaderCursor(rootObject);
+        shaderCursor["buffer"].setBinding(buffer);
+        shaderCursor["value"].setData(10.f);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->end();
+    };
+
+    // Children execute at their creation point, interleaved with the parent's own commands.
+    auto child0 = commandEncoder->createChildEncoder();
+    write(commandEncoder, 1);
+    auto child2 = commandEncoder->createChildEncoder();
+    auto child3 = commandEncoder->createChildEncoder();
+    write(commandEncoder, 4);
+    auto child5 = commandEncoder->createChildEncoder();
+    REQUIRE(child0);
+    REQUIRE(child2);
+    REQUIRE(child3);
+    REQUIRE(child5);
+
+    // Children are recorded concurrently, in any order.
+    std::thread thread5([&]() { dispatch(child5); });
+    std::thread thread3([&]() { write(child3, 3); });
+    std::thread thread2([&]() { write(child2, 2); });
+    std::thread thread0([&]() { write(child0, 0); });
+    thread5.join();
+    thread3.join();
+    thread2.join();
+    thread0.join();
+
+    REQUIRE_CALL(queue->submit(commandEncoder->finish()));
+    REQUIRE_CALL(queue->waitOnHost());
+
+    compareComputeResult(device, buffer, makeArray<float>(21.0f, 31.0f, 41.0f, 51.0f, 50.0f, 50.0f, 50.0f, 50.0f));
+}
+
+GPU_TEST_CASE("command-profile", ALL)
+{
+    uint32_t entryCount = 0;
+    Result result = device->getCommandProfile(nullptr, &entryCount);
+    if (result == SLANG_E_NOT_AVAILABLE)
+        SKIP("command profiling not enabled");
+    REQUIRE_CALL(result);
+    REQUIRE_CALL(device->resetCommandProfile());
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = 16;
+    bufferDesc.usage = BufferUsage::CopySource | BufferUsage::CopyDestination | BufferUsage::UnorderedAccess;
+    bufferDesc.defaultState = ResourceState::CopyDestination;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, nullptr, buffer.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    encoder->clearBuffer(buffer);
+    encoder->clearBuffer(buffer);
+    REQUIRE_CALL(queue->submit(encoder->finish()));
+    REQUIRE_CALL(queue->waitOnHost());
+
+    std::vector<CommandProfileEntry> entries(entryCount);
+    REQUIRE_CALL(device->getCommandProfile(entries.data(), &entryCount));
+    bool found = false;
+    for (const CommandProfileEntry& entry : entries)
+    {
+        if (std::strcmp(entry.command, "ClearBuffer") == 0)
+        {
+            found = true;
+            CHECK_EQ(entry.encodeCount, 2);
+            CHECK_EQ(entry.executeCount, 2);
+        }
+    }
+    CHECK(found);
+
+    ComPtr<ISlangBlob> blob;
+    REQUIRE_CALL(device->dumpCommandProfile(CommandProfileFormat::JSON, blob.writeRef()));
+    std::string json((const char*)blob->getBufferPointer(), blob->getBufferSize());
+    CHECK(json.find("\"ClearBuffer\"") != std::string::npos);
+    REQUIRE_CALL(device->dumpCommandProfile(CommandProfileFormat::ChromeTrace, blob.writeRef()));
+    std::string trace((const char*)blob->getBufferPointer(), blob->getBufferSize());
+    CHECK(trace.find("traceEvents") != std::string::npos);
+}
@@ -0,0 +1,73 @@
+#include "testing.h"
+
+#include "command-list.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+TEST_CASE("command-list")
+{
+    ArenaAllocator allocator(64 * 1024);
+    RefObjectSet trackedObjects;
+    std::vector<ExecuteCallbackObjectRetainer> trackedExecuteCallbackObjects;
+
+    SUBCASE("inline")
+    {
+        CommandList commandList(allocator, trackedObjects, trackedExecuteCallbackObjects);
+        for (uint64_t i = 0; i < 100; i++)
+        {
+            commandList.write(commands::ClearBuffer{nullptr, {i, 4}});
+            commandList.write(commands::GlobalBarrier{});
+            commandList.write(commands::SetBufferState{nullptr, ResourceState::CopySource});
+        }
+
+        uint64_t index = 0;
+        const CommandList::CommandSlot* prev = nullptr;
+        for (const CommandList::CommandSlot* command : commandList)
+        {
+            // Payloads are stored right after their header.
+            CHECK(command->getData() == command + 1);
+            if (index % 3 == 0)
+            {
+                REQUIRE(command->id == CommandID::ClearBuffer);
+                CHECK_EQ(command->size, sizeof(commands::ClearBuffer));
+                CHECK_EQ(commandList.getCommand<commands::ClearBuffer>(command).range.offset, index / 3);
+            }
+            else
+            {
+                CHECK(command->id == (index % 3 == 1 ? CommandID::GlobalBarrier : CommandID::SetBufferState));
+            }
+            // Consecutive commands follow each other in memory.
+            if (prev)
+            {
+                uintptr_t prevEnd = uintptr_t(prev->getData()) + prev->size;
+                CHECK_EQ(uintptr_t(command), calcAligned2(prevEnd, alignof(CommandList::CommandSlot)));
+            }
+            prev = command;
+            index++;
+        }
+        CHECK_EQ(index, 300u);
+        CHECK_EQ(prev, commandList.getLastCommand());
+    }
+
+    SUBCASE("splice")
+    {
+        CommandList commandList(allocator, trackedObjects, trackedExecuteCallbackObjects);
+        CommandList otherList(allocator, trackedObjects, trackedExecuteCallbackObjects);
+        commandList.write(commands::ClearBuffer{nullptr, {0, 4}});
+        CommandList::CommandSlot* position = commandList.getLastCommand();
+        commandList.write(commands::ClearBuffer{nullptr, {3, 4}});
+        otherList.write(commands::ClearBuffer{nullptr, {1, 4}});
+        otherList.write(commands::ClearBuffer{nullptr, {2, 4}});
+        commandList.splice(position, otherList);
+
+        CHECK(otherList.begin() == otherList.end());
+        uint64_t index = 0;
+        for (const CommandList::CommandSlot* command : commandList)
+        {
+            CHECK_EQ(commandList.getCommand<commands::ClearBuffer>(command).range.offset, index);
+            index++;
+        }
+        CHECK_EQ(index, 4u);
+    }
+}
@@ -6,7 +6,7 @@ using namespace rhi::testing;
 // Test dispatchComputeIndirect with a simple compute shader.
 // The test sets up an indirect argument buffer with dispatch dimensions written by the GPU,
 // then verifies the compute shader ran with the correct number of threads.
-GPU_TEST_CASE("compute-indirect", D3D12 | Vulkan | Metal | CUDA)
+GPU_TEST_CASE("compute-indirect", D3D12 | Vulkan | Metal | CUDA | CPU)
 {
     ComPtr<IShaderProgram> program;
     REQUIRE_CALL(loadProgram(device, "test-compute-indirect", "computeMain", program.writeRef()));
@@ -117,7 +117,7 @@ GPU_TEST_CASE("compute-indirect", D3D12 | Vulkan | Metal | CUDA)
 
 // Test dispatchComputeIndirect with zero dispatch dimensions.
 // This verifies the implementation handles edge cases correctly.
-GPU_TEST_CASE("compute-indirect-zero", D3D12 | Vulkan | Metal | CUDA)
+GPU_TEST_CASE("compute-indirect-zero", D3D12 | Vulkan | Metal | CUDA | CPU)
 {
     ComPtr<IShaderProgram> program;
     REQUIRE_CALL(loadProgram(device, "test-compute-indirect", "computeMain", program.writeRef()));
@@ -202,7 +202,7 @@ GPU_TEST_CASE("compute-indirect-zero", D3D12 | Vulkan | Metal | CUDA)
 
 // Test dispatchComputeIndirect with non-zero buffer offset.
 // This verifies the offset parameter is handled correctly.
-GPU_TEST_CASE("compute-indirect-offset", D3D12 | Vulkan | Metal | CUDA)
+GPU_TEST_CASE("compute-indirect-offset", D3D12 | Vulkan | Metal | CUDA | CPU)
 {
     ComPtr<IShaderProgram> program;
     REQUIRE_CALL(loadProgram(device, "test-compute-indirect", "computeMain", program.writeRef()));
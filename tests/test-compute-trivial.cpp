@@ -1,5 +1,7 @@
 #include "testing.h"
 
+#include "../src/device.h"
+
 using namespace rhi;
 using namespace rhi::testing;
 
@@ -48,3 +50,226 @@ GPU_TEST_CASE("compute-trivial", ALL)
 
     compareComputeResult(device, buffer, makeArray<float>(11.0f, 12.0f, 13.0f, 14.0f));
 }
+
+GPU_TEST_CASE("compute-trivial-large-dispatch", ALL)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    REQUIRE_CALL(loadProgram(device, "test-compute-trivial", "computeMain", shaderProgram.writeRef()));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    // Dispatch enough groups to be split across multiple tasks on the CPU device.
+    const uint32_t groupCount = 4099;
+    const uint32_t numberCount = groupCount * 4;
+    std::vector<float> initialData(numberCount);
+    for (uint32_t i = 0; i < numberCount; ++i)
+        initialData[i] = float(i);
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = numberCount * sizeof(float);
+    bufferDesc.format = Format::Undefined;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, initialData.data(), buffer.writeRef()));
+
+    {
+        auto queue = device->getQueue(QueueType::Graphics);
+        auto commandEncoder = queue->createCommandEncoder();
+
+        auto passEncoder = commandEncoder->beginComputePass();
+        auto rootObject = passEncoder->bindPipeline(pipeline);
+        ShaderCursor shaderCursor(rootObject);
+        shaderCursor["buffer"].setBinding(buffer);
+        float value = 10.f;
+        shaderCursor["value"].setData(value);
+        passEncoder->dispatchCompute(groupCount, 1, 1);
+        passEncoder->end();
+
+        queue->submit(commandEncoder->finish());
+        queue->waitOnHost();
+    }
+
+    std::vector<float> expectedData(numberCount);
+    for (uint32_t i = 0; i < numberCount; ++i)
+        expectedData[i] = float(i) + 11.0f;
+    compareComputeResult(device, buffer, std::span<float>(expectedData));
+}
+
+GPU_TEST_CASE("compute-trivial-repeated-dispatch", ALL)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    REQUIRE_CALL(loadProgram(device, "test-compute-trivial", "computeMain", shaderProgram.writeRef()));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    const int numberCount = 4;
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = numberCount * sizeof(float);
+    bufferDesc.format = Format::Undefined;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, (void*)initialData, buffer.writeRef()));
+
+    // Dispatch repeatedly with the same root object, changing it in between,
+    // to make sure binding data reused across dispatches is kept up to date.
+    {
+        auto queue = device->getQueue(QueueType::Graphics);
+        auto commandEncoder = queue->createCommandEncoder();
+
+        auto passEncoder = commandEncoder->beginComputePass();
+        auto rootObject = passEncoder->bindPipeline(pipeline);
+        ShaderCursor shaderCursor(rootObject);
+        shaderCursor["buffer"].setBinding(buffer);
+        float value = 10.f;
+        shaderCursor["value"].setData(value);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->dispatchCompute(1, 1, 1);
+        value = 20.f;
+        shaderCursor["value"].setData(value);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->end();
+
+        queue->submit(commandEncoder->finish());
+        queue->waitOnHost();
+    }
+
+    compareComputeResult(device, buffer, makeArray<float>(43.0f, 44.0f, 45.0f, 46.0f));
+}
+
+// Dispatches with an unchanged root object reuse the binding data built for the first dispatch.
+// Modifying the root object must rebuild it.
+GPU_TEST_CASE("compute-trivial-binding-cache", CPU)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    REQUIRE_CALL(loadProgram(device, "test-compute-trivial", "computeMain", shaderProgram.writeRef()));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    const int numberCount = 4;
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = numberCount * sizeof(float);
+    bufferDesc.format = Format::Undefined;
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, (void*)initialData, buffer.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto commandEncoder = queue->createCommandEncoder();
+    auto passEncoder = commandEncoder->beginComputePass();
+    ComPtr<IShaderObject> rootObject(passEncoder->bindPipeline(pipeline));
+    ShaderCursor shaderCursor(rootObject);
+    shaderCursor["buffer"].setBinding(buffer);
+    shaderCursor["value"].setData(10.f);
+    passEncoder->dispatchCompute(1, 1, 1);
+    // Unchanged root object.
+    passEncoder->dispatchCompute(1, 1, 1);
+    // Modified root object.
+    shaderCursor["value"].setData(20.f);
+    passEncoder->dispatchCompute(1, 1, 1);
+    // Binding the same unchanged root object again.
+    passEncoder->bindPipeline(pipeline, rootObject);
+    passEncoder->dispatchCompute(1, 1, 1);
+    passEncoder->end();
+
+    ComPtr<ICommandBuffer> commandBuffer = commandEncoder->finish();
+    CommandBufferStats stats;
+    REQUIRE_CALL(commandBuffer->getStats(&stats));
+    CHECK_EQ(stats.bindingDataReuseCount, 2);
+
+    queue->submit(commandBuffer);
+    queue->waitOnHost();
+
+    compareComputeResult(device, buffer, makeArray<float>(60.0f, 61.0f, 62.0f, 63.0f));
+}
+
+// Dispatches on the CPU device are split into tasks of `computeGrainSize` thread groups.
+// Check dispatches with no groups, fewer groups than workers and many groups, split automatically,
+// with explicit grain sizes and executed on the submitting thread.
+GPU_TEST_CASE("compute-trivial-dispatch-splitting", CPU | DontCreateDevice)
+{
+    struct Config
+    {
+        uint32_t grainSize;
+        bool singleThreaded;
+    };
+    const Config configs[] = {{0, false}, {1, false}, {7, false}, {100000, false}, {0, true}, {1, true}};
+    const uint32_t groupCounts[] = {0, 1, 3, 4099};
+    const uint32_t maxNumberCount = 4099 * 4;
+
+    for (const Config& config : configs)
+    {
+        CAPTURE(config.grainSize);
+        CAPTURE(config.singleThreaded);
+        DeviceExtraOptions options;
+        options.cpuComputeGrainSize = config.grainSize;
+        options.cpuSingleThreaded = config.singleThreaded;
+        device = createTestingDevice(ctx, ctx->deviceType, false, &options);
+
+        ComPtr<IShaderProgram> shaderProgram;
+        REQUIRE_CALL(loadProgram(device, "test-compute-trivial", "computeMain", shaderProgram.writeRef()));
+        ComputePipelineDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<IComputePipeline> pipeline;
+        REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+        for (uint32_t groupCount : groupCounts)
+        {
+            CAPTURE(groupCount);
+            std::vector<float> data(maxNumberCount);
+            for (uint32_t i = 0; i < maxNumberCount; ++i)
+                data[i] = float(i);
+
+            BufferDesc bufferDesc = {};
+            bufferDesc.size = maxNumberCount * sizeof(float);
+            bufferDesc.elementSize = sizeof(float);
+            bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess |
+                               BufferUsage::CopyDestination | BufferUsage::CopySource;
+            bufferDesc.defaultState = ResourceState::UnorderedAccess;
+            ComPtr<IBuffer> buffer;
+            REQUIRE_CALL(device->createBuffer(bufferDesc, data.data(), buffer.writeRef()));
+
+            auto queue = device->getQueue(QueueType::Graphics);
+            auto commandEncoder = queue->createCommandEncoder();
+            auto passEncoder = commandEncoder->beginComputePass();
+            auto rootObject = passEncoder->bindPipeline(pipeline);
+            ShaderCursor shaderCursor(rootObject);
+            shaderCursor["buffer"].setBinding(buffer);
+            shaderCursor["value"].setData(10.f);
+            passEncoder->dispatchCompute(groupCount, 1, 1);
+            passEncoder->end();
+            queue->submit(commandEncoder->finish());
+            queue->waitOnHost();
+
+            // Every thread of the dispatched groups runs exactly once, the rest of the buffer is untouched.
+            for (uint32_t i = 0; i < groupCount * 4; ++i)
+                data[i] += 11.0f;
+            compareComputeResult(device, buffer, std::span<float>(data));
+        }
+    }
+}
@@ -0,0 +1,112 @@
+#include "testing.h"
+
+using namespace rhi;
+using namespace rhi::testing;
+
+static void encodeIncrement(IDevice* device, ICommandEncoder* commandEncoder, IBuffer* buffer)
+{
+    ComPtr<IShaderProgram> shaderProgram;
+    REQUIRE_CALL(loadProgram(device, "test-compute-trivial", "computeMain", shaderProgram.writeRef()));
+
+    ComputePipelineDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+
+    auto passEncoder = commandEncoder->beginComputePass();
+    auto rootObject = passEncoder->bindPipeline(pipeline);
+    ShaderCursor shaderCursor(rootObject);
+    shaderCursor["buffer"].setBinding(buffer);
+    float value = 10.f;
+    shaderCursor["value"].setData(value);
+    passEncoder->dispatchCompute(1, 1, 1);
+    passEncoder->end();
+}
+
+static ComPtr<IBuffer> createNumberBuffer(IDevice* device)
+{
+    float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = sizeof(initialData);
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopyDestination |
+                       BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, initialData, buffer.writeRef()));
+    return buffer;
+}
+
+GPU_TEST_CASE("cpu-async-queue-submit", CPU)
+{
+    DeviceExtraOptions options = {};
+    options.cpuAsyncQueue = true;
+    device = createTestingDevice(ctx, ctx->deviceType, false, &options);
+    REQUIRE(device);
+
+    ComPtr<IBuffer> buffer = createNumberBuffer(device);
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    for (int i = 0; i < 3; ++i)
+    {
+        auto commandEncoder = queue->createCommandEncoder();
+        encodeIncrement(device, commandEncoder, buffer);
+        REQUIRE_CALL(queue->submit(commandEncoder->finish()));
+    }
+    REQUIRE_CALL(queue->waitOnHost());
+
+    compareComputeResult(device, buffer, makeArray<float>(33.0f, 34.0f, 35.0f, 36.0f));
+}
+
+GPU_TEST_CASE("cpu-async-queue-fences", CPU)
+{
+    DeviceExtraOptions options = {};
+    options.cpuAsyncQueue = true;
+    device = createTestingDevice(ctx, ctx->deviceType, false, &options);
+    REQUIRE(device);
+
+    ComPtr<IBuffer> buffer = createNumberBuffer(device);
+
+    FenceDesc fenceDesc = {};
+    ComPtr<IFence> waitFence;
+    ComPtr<IFence> signalFence;
+    REQUIRE_CALL(device->createFence(fenceDesc, waitFence.writeRef()));
+    REQUIRE_CALL(device->createFence(fenceDesc, signalFence.writeRef()));
+
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto commandEncoder = queue->createCommandEncoder();
+    encodeIncrement(device, commandEncoder, buffer);
+    ComPtr<ICommandBuffer> commandBuffer;
+    REQUIRE_CALL(commandEncoder->finish(commandBuffer.writeRef()));
+
+    // Submitting with an unsignaled wait fence must not block the submitting thread.
+    ICommandBuffer* commandBuffers[] = {commandBuffer.get()};
+    IFence* waitFences[] = {waitFence.get()};
+    uint64_t waitFenceValues[] = {1};
+    IFence* signalFences[] = {signalFence.get()};
+    uint64_t signalFenceValues[] = {2};
+    SubmitDesc submitDesc = {};
+    submitDesc.commandBuffers = commandBuffers;
+    submitDesc.commandBufferCount = 1;
+    submitDesc.waitFences = waitFences;
+    submitDesc.waitFenceValues = waitFenceValues;
+    submitDesc.waitFenceCount = 1;
+    submitDesc.signalFences = signalFences;
+    submitDesc.signalFenceValues = signalFenceValues;
+    submitDesc.signalFenceCount = 1;
+    REQUIRE_CALL(queue->submit(submitDesc));
+
+    // The submission cannot have executed yet.
+    uint64_t value;
+    REQUIRE_CALL(signalFence->getCurrentValue(&value));
+    CHECK(value == 0);
+
+    // Release the queue and wait for the signal fence.
+    REQUIRE_CALL(waitFence->setCurrentValue(1));
+    IFence* fences[] = {signalFence.get()};
+    uint64_t values[] = {2};
+    REQUIRE_CALL(device->waitForFences(1, fences, values, true, kTimeoutInfinite));
+
+    REQUIRE_CALL(queue->waitOnHost());
+    compareComputeResult(device, buffer, makeArray<float>(11.0f, 12.0f, 13.0f, 14.0f));
+}
@@ -1,5 +1,7 @@
 #include "testing.h"
 
+#include <thread>
+
 using namespace rhi;
 using namespace rhi::testing;
 
@@ -133,6 +135,52 @@ GPU_TEST_CASE("fence-wait-with-timeout", ALL & ~D3D11)
     }
 }
 
+GPU_TEST_CASE("fence-wait-signal-from-thread", CPU)
+{
+    FenceDesc fenceDesc = {};
+    ComPtr<IFence> fence1;
+    ComPtr<IFence> fence2;
+    REQUIRE_CALL(device->createFence(fenceDesc, fence1.writeRef()));
+    REQUIRE_CALL(device->createFence(fenceDesc, fence2.writeRef()));
+
+    // Wait for any fence while the second one is signaled from another thread.
+    {
+        std::thread thread(
+            [&]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                fence2->setCurrentValue(1);
+            }
+        );
+        IFence* fences[] = {fence1.get(), fence2.get()};
+        uint64_t values[] = {1, 1};
+        CHECK(device->waitForFences(2, fences, values, false, kTimeoutInfinite) == SLANG_OK);
+        thread.join();
+    }
+
+    // Wait for all fences while the first one is signaled from another thread.
+    {
+        std::thread thread(
+            [&]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                fence1->setCurrentValue(1);
+            }
+        );
+        IFence* fences[] = {fence1.get(), fence2.get()};
+        uint64_t values[] = {1, 1};
+        CHECK(device->waitForFences(2, fences, values, true, kTimeoutInfinite) == SLANG_OK);
+        thread.join();
+    }
+
+    // Time out while sleeping.
+    {
+        IFence* fences[] = {fence1.get(), fence2.get()};
+        uint64_t values[] = {2, 2};
+        CHECK(device->waitForFences(2, fences, values, false, 20000000) == SLANG_E_TIME_OUT);
+    }
+}
+
 GPU_TEST_CASE("fence-queue-signal", ALL & ~D3D11)
 {
     FenceDesc fenceDesc = {};
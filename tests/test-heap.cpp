@@ -144,7 +144,7 @@ ComPtr<IBuffer> createBuffer(IDevice* device, uint32_t size)
     return buffer;
 }
 
-GPU_TEST_CASE("heap-create", CUDA | Vulkan)
+GPU_TEST_CASE("heap-create", CUDA | Vulkan | CPU)
 {
     HeapDesc desc;
     desc.memoryType = MemoryType::DeviceLocal;
@@ -153,7 +153,7 @@ GPU_TEST_CASE("heap-create", CUDA | Vulkan)
     REQUIRE_CALL(device->createHeap(desc, heap.writeRef()));
 }
 
-GPU_TEST_CASE("heap-allocate", CUDA | Vulkan)
+GPU_TEST_CASE("heap-allocate", CUDA | Vulkan | CPU)
 {
     HeapDesc desc;
     desc.memoryType = MemoryType::DeviceLocal;
@@ -419,7 +419,7 @@ bool allocationsOverlap(const HeapAlloc& a, const HeapAlloc& b)
     return !(aEnd <= bStart || bEnd <= aStart);
 }
 
-GPU_TEST_CASE("heap-no-overlaps", CUDA | Vulkan)
+GPU_TEST_CASE("heap-no-overlaps", CUDA | Vulkan | CPU)
 {
     HeapDesc desc;
     desc.memoryType = MemoryType::DeviceLocal;
@@ -462,7 +462,7 @@ GPU_TEST_CASE("heap-no-overlaps", CUDA | Vulkan)
     }
 }
 
-GPU_TEST_CASE("heap-alloc-free-no-overlaps", CUDA | Vulkan)
+GPU_TEST_CASE("heap-alloc-free-no-overlaps", CUDA | Vulkan | CPU)
 {
     HeapDesc desc;
     desc.memoryType = MemoryType::DeviceLocal;
@@ -514,7 +514,7 @@ GPU_TEST_CASE("heap-alloc-free-no-overlaps", CUDA | Vulkan)
     }
 }
 
-GPU_TEST_CASE("heap-alignment-sizes", CUDA | Vulkan)
+GPU_TEST_CASE("heap-alignment-sizes", CUDA | Vulkan | CPU)
 {
     HeapDesc desc;
     desc.memoryType = MemoryType::DeviceLocal;
@@ -735,7 +735,7 @@ GPU_TEST_CASE("heap-multiple-submits-pending-frees", Vulkan)
     }
 }
 
-GPU_TEST_CASE("heap-fragmentation-test", CUDA | Vulkan)
+GPU_TEST_CASE("heap-fragmentation-test", CUDA | Vulkan | CPU)
 {
     HeapDesc desc;
     desc.memoryType = MemoryType::DeviceLocal;
@@ -786,6 +786,41 @@ GPU_TEST_CASE("heap-fragmentation-test", CUDA | Vulkan)
     REQUIRE_CALL(heap->free(largeAllocation));
 }
 
+// CPU: heap allocations are host memory and their device address is a plain pointer
+// that can be used by kernels as well as by the host.
+GPU_TEST_CASE("heap-cpu-device-address", CPU)
+{
+    HeapDesc desc;
+    desc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IHeap> heap;
+    REQUIRE_CALL(device->createHeap(desc, heap.writeRef()));
+
+    const uint32_t numElements = 1024;
+    HeapAllocDesc allocDesc;
+    allocDesc.size = numElements * sizeof(uint32_t);
+    allocDesc.alignment = 128;
+
+    HeapAlloc allocation;
+    REQUIRE_CALL(heap->allocate(allocDesc, &allocation));
+
+    runInitPointerShader(device, 0x12345678, allocation.getDeviceAddress(), numElements);
+    device->getQueue(QueueType::Graphics)->waitOnHost();
+
+    const uint32_t* data = reinterpret_cast<const uint32_t*>(allocation.getDeviceAddress());
+    for (uint32_t i = 0; i < numElements; i++)
+    {
+        if (data[i] != 0x12345678)
+        {
+            CAPTURE(i);
+            CHECK_EQ(data[i], 0x12345678);
+            break;
+        }
+    }
+
+    REQUIRE_CALL(heap->free(allocation));
+}
+
 GPU_TEST_CASE("heap-reports", ALL)
 {
     auto deviceType = device->getDeviceType();
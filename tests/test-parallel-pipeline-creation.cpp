@@ -1,6 +1,9 @@
 #include "testing.h"
 #include "shader-cache.h"
 
+#include <thread>
+#include <vector>
+
 using namespace rhi;
 using namespace rhi::testing;
 
@@ -205,6 +208,67 @@ void runDeferredCudaRayTracingPipelineBatch(IDevice* device)
     compareComputeResult(device, outputBuffers[1], std::array<uint32_t, 4>{10, 12, 14, 16});
 }
 
+void runConcurrentFinish(IDevice* device)
+{
+    const char* entryPointNames[] = {"computeAdd", "computeMul", "computeSub", "computeNeg"};
+    ComPtr<IShaderProgram> programs[4];
+    ComPtr<IComputePipeline> pipelines[4];
+    for (size_t i = 0; i < std::size(programs); ++i)
+    {
+        REQUIRE_CALL(
+            loadProgram(device, "test-parallel-pipeline-creation", entryPointNames[i], programs[i].writeRef())
+        );
+        ComputePipelineDesc desc = {};
+        desc.program = programs[i];
+        desc.compilationPolicy = PipelineCompilationPolicy::Deferred;
+        REQUIRE_CALL(device->createComputePipeline(desc, pipelines[i].writeRef()));
+    }
+
+    // Every encoder uses the same virtual pipelines, so concurrent resolvers share the pipeline creations.
+    static constexpr size_t kEncoderCount = 4;
+    auto queue = device->getQueue(QueueType::Graphics);
+    ComPtr<IBuffer> buffers[kEncoderCount];
+    ComPtr<ICommandEncoder> encoders[kEncoderCount];
+    for (size_t i = 0; i < kEncoderCount; ++i)
+    {
+        float initialData[] = {1.0f, 2.0f, 3.0f, 4.0f};
+        BufferDesc bufferDesc = {};
+        bufferDesc.size = sizeof(initialData);
+        bufferDesc.elementSize = sizeof(float);
+        bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopySource;
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        REQUIRE_CALL(device->createBuffer(bufferDesc, initialData, buffers[i].writeRef()));
+
+        encoders[i] = queue->createCommandEncoder();
+        for (IComputePipeline* pipeline : pipelines)
+        {
+            auto pass = encoders[i]->beginComputePass();
+            auto rootObject = pass->bindPipeline(pipeline);
+            ShaderCursor(rootObject)["buffer"].setBinding(buffers[i]);
+            pass->dispatchCompute(1, 1, 1);
+            pass->end();
+        }
+    }
+
+    ComPtr<ICommandBuffer> commandBuffers[kEncoderCount];
+    Result results[kEncoderCount];
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kEncoderCount; ++i)
+        threads.emplace_back([&, i]() { results[i] = encoders[i]->finish(commandBuffers[i].writeRef()); });
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < kEncoderCount; ++i)
+    {
+        REQUIRE_CALL(results[i]);
+        REQUIRE_CALL(queue->submit(commandBuffers[i]));
+    }
+    REQUIRE_CALL(queue->waitOnHost());
+
+    for (size_t i = 0; i < kEncoderCount; ++i)
+        compareComputeResult(device, buffers[i], makeArray<float>(-3.5f, -5.5f, -7.5f, -9.5f));
+}
+
 void checkImmediateComputePipeline(IDevice* device, PipelineCompilationPolicy compilationPolicy)
 {
     ComPtr<IShaderProgram> program;
@@ -220,6 +284,142 @@ void checkImmediateComputePipeline(IDevice* device, PipelineCompilationPolicy co
     REQUIRE_CALL(pipeline->getNativeHandle(&nativeHandle));
 }
 
+void dispatchComputePipeline(IDevice* device, IComputePipeline* pipeline, IBuffer* buffer)
+{
+    auto queue = device->getQueue(QueueType::Graphics);
+    auto encoder = queue->createCommandEncoder();
+    auto pass = encoder->beginComputePass();
+    auto rootObject = pass->bindPipeline(pipeline);
+    ShaderCursor(rootObject)["buffer"].setBinding(buffer);
+    pass->dispatchCompute(1, 1, 1);
+    pass->end();
+    ComPtr<ICommandBuffer> commandBuffer;
+    REQUIRE_CALL(encoder->finish(commandBuffer.writeRef()));
+    REQUIRE_CALL(queue->submit(commandBuffer));
+    REQUIRE_CALL(queue->waitOnHost());
+}
+
+ComPtr<IBuffer> createComputeBuffer(IDevice* device)
+{
+    float initialData[] = {1.0f, 2.0f, 3.0f, 4.0f};
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = sizeof(initialData);
+    bufferDesc.elementSize = sizeof(float);
+    bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopySource;
+    bufferDesc.defaultState = ResourceState::UnorderedAccess;
+    ComPtr<IBuffer> buffer;
+    REQUIRE_CALL(device->createBuffer(bufferDesc, initialData, buffer.writeRef()));
+    return buffer;
+}
+
+ComPtr<IComputePipeline> createComputePipeline(IDevice* device, const char* entryPointName)
+{
+    ComPtr<IShaderProgram> program;
+    REQUIRE_CALL(loadProgram(device, "test-parallel-pipeline-creation", entryPointName, program.writeRef()));
+    ComputePipelineDesc desc = {};
+    desc.program = program;
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipeline(desc, pipeline.writeRef()));
+    return pipeline;
+}
+
+ComPtr<IComputePipeline> createComputePipelineAsync(
+    IDevice* device,
+    const char* entryPointName,
+    IComputePipeline* fallback,
+    IPipelineCreationTask** outTask
+)
+{
+    ComPtr<IShaderProgram> program;
+    REQUIRE_CALL(loadProgram(device, "test-parallel-pipeline-creation", entryPointName, program.writeRef()));
+    ComputePipelineDesc desc = {};
+    desc.program = program;
+    ComPtr<IComputePipeline> pipeline;
+    REQUIRE_CALL(device->createComputePipelineAsync(desc, fallback, pipeline.writeRef(), outTask));
+    return pipeline;
+}
+
+/// Task pool that holds back top-level tasks until they are waited on or explicitly run.
+/// Tasks submitted to a group run immediately, so nested batches complete synchronously.
+class DeferredTaskPool : public ITaskPool
+{
+public:
+    ~DeferredTaskPool()
+    {
+        for (Task* task : m_tasks)
+            delete task;
+    }
+
+    void runPendingTasks()
+    {
+        for (size_t i = 0; i < m_tasks.size(); ++i)
+            run(m_tasks[i]);
+    }
+
+    virtual SLANG_NO_THROW TaskHandle SLANG_MCALL submitTask(
+        void (*func)(void*),
+        void* payload,
+        void (*payloadDeleter)(void*),
+        TaskGroupHandle group
+    ) override
+    {
+        Task* task = new Task{func, payload, payloadDeleter};
+        m_tasks.push_back(task);
+        if (group)
+            run(task);
+        return task;
+    }
+
+    virtual SLANG_NO_THROW void SLANG_MCALL releaseTask(TaskHandle task) override { SLANG_UNUSED(task); }
+
+    virtual SLANG_NO_THROW void SLANG_MCALL waitAndReleaseTask(TaskHandle task) override
+    {
+        run(static_cast<Task*>(task));
+    }
+
+    virtual SLANG_NO_THROW TaskGroupHandle SLANG_MCALL createTaskGroup() override { return this; }
+
+    virtual SLANG_NO_THROW void SLANG_MCALL waitAndReleaseTaskGroup(TaskGroupHandle group) override
+    {
+        SLANG_UNUSED(group);
+    }
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL queryInterface(const SlangUUID& uuid, void** outObject) override
+    {
+        if (uuid == ITaskPool::getTypeGuid())
+        {
+            *outObject = static_cast<ITaskPool*>(this);
+            return SLANG_OK;
+        }
+        return SLANG_E_NO_INTERFACE;
+    }
+
+    // The lifetime of this object is tied to the test.
+    virtual SLANG_NO_THROW uint32_t SLANG_MCALL addRef() override { return 2; }
+    virtual SLANG_NO_THROW uint32_t SLANG_MCALL release() override { return 2; }
+
+private:
+    struct Task
+    {
+        void (*func)(void*);
+        void* payload;
+        void (*payloadDeleter)(void*);
+        bool done = false;
+    };
+
+    void run(Task* task)
+    {
+        if (task->done)
+            return;
+        task->done = true;
+        task->func(task->payload);
+        if (task->payloadDeleter)
+            task->payloadDeleter(task->payload);
+    }
+
+    std::vector<Task*> m_tasks;
+};
+
 struct TaskPoolReset
 {
     ComPtr<IDevice>& device;
@@ -242,6 +442,15 @@ GPU_TEST_CASE("parallel-pipeline-creation", ALL | DontCreateDevice)
     runDeferredPipelineBatch(device);
 }
 
+GPU_TEST_CASE("parallel-pipeline-creation-concurrent-finish", CPU | DontCreateDevice)
+{
+    DeviceExtraOptions options;
+    options.pipelineCompilationMode = PipelineCompilationMode::Parallel;
+    device = createTestingDevice(ctx, ctx->deviceType, false, &options);
+    REQUIRE(device);
+    runConcurrentFinish(device);
+}
+
 GPU_TEST_CASE("parallel-pipeline-creation-shared-cache", D3D12 | Vulkan | DontCreateDevice)
 {
     rhi::testing::ShaderCache sharedCache;
@@ -304,3 +513,50 @@ GPU_TEST_CASE("parallel-pipeline-creation-cuda-ray-tracing", CUDA | DontCreateDe
 
     runDeferredCudaRayTracingPipelineBatch(device);
 }
+
+GPU_TEST_CASE("async-pipeline-creation", ALL)
+{
+    ComPtr<IPipelineCreationTask> task;
+    ComPtr<IComputePipeline> pipeline = createComputePipelineAsync(device, "computeMul", nullptr, task.writeRef());
+    REQUIRE_CALL(task->wait());
+    CHECK(task->isReady());
+
+    // The task handle is optional.
+    ComPtr<IComputePipeline> addPipeline = createComputePipelineAsync(device, "computeAdd", nullptr, nullptr);
+
+    ComPtr<IBuffer> buffer = createComputeBuffer(device);
+    dispatchComputePipeline(device, pipeline, buffer);
+    dispatchComputePipeline(device, addPipeline, buffer);
+    compareComputeResult(device, buffer, makeArray<float>(3.0f, 5.0f, 7.0f, 9.0f));
+}
+
+GPU_TEST_CASE("async-pipeline-creation-fallback", CPU | CUDA | D3D12 | Vulkan | DontCreateDevice)
+{
+    // The deferred pool keeps the asynchronous creation pending until the test runs it.
+    DeferredTaskPool taskPool;
+    releaseCachedDevices();
+    REQUIRE_CALL(getRHI()->setTaskPool(&taskPool));
+    TaskPoolReset taskPoolReset{device};
+
+    DeviceExtraOptions options;
+    options.pipelineCompilationMode = PipelineCompilationMode::Parallel;
+    device = createTestingDevice(ctx, ctx->deviceType, false, &options);
+    REQUIRE(device);
+
+    ComPtr<IComputePipeline> fallback = createComputePipeline(device, "computeAdd");
+    ComPtr<IPipelineCreationTask> task;
+    ComPtr<IComputePipeline> pipeline = createComputePipelineAsync(device, "computeMul", fallback, task.writeRef());
+    CHECK_FALSE(task->isReady());
+
+    // The fallback is used while the pipeline is not ready.
+    ComPtr<IBuffer> buffer = createComputeBuffer(device);
+    dispatchComputePipeline(device, pipeline, buffer);
+    compareComputeResult(device, buffer, makeArray<float>(2.0f, 3.0f, 4.0f, 5.0f));
+
+    taskPool.runPendingTasks();
+    CHECK(task->isReady());
+    REQUIRE_CALL(task->wait());
+
+    dispatchComputePipeline(device, pipeline, buffer);
+    compareComputeResult(device, buffer, makeArray<float>(4.0f, 6.0f, 8.0f, 10.0f));
+}
@@ -0,0 +1,176 @@
+#include "testing.h"
+
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+namespace {
+
+ComPtr<ISlangBlob> createStringBlob(const std::string& str)
+{
+    ComPtr<ISlangBlob> blob;
+    REQUIRE_CALL(getRHI()->createBlob(str.data(), str.size(), blob.writeRef()));
+    return blob;
+}
+
+ComPtr<IPersistentCache> openCache(const std::filesystem::path& path, uint64_t maxSize = 0)
+{
+    std::string pathString = path.string();
+    FilePersistentCacheDesc desc;
+    desc.path = pathString.c_str();
+    desc.maxSize = maxSize;
+    desc.maxEntryCount = 64;
+    ComPtr<IPersistentCache> cache;
+    REQUIRE_CALL(getRHI()->createFilePersistentCache(desc, cache.writeRef()));
+    return cache;
+}
+
+void writeEntry(IPersistentCache* cache, const std::string& key, const std::string& data)
+{
+    REQUIRE_CALL(cache->writeCache(createStringBlob(key), createStringBlob(data)));
+}
+
+bool hasEntry(IPersistentCache* cache, const std::string& key, const std::string& data)
+{
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(cache->queryCache(createStringBlob(key), blob.writeRef())))
+        return false;
+    return blob->getBufferSize() == data.size() && std::memcmp(blob->getBufferPointer(), data.data(), data.size()) == 0;
+}
+
+struct TempDirectory
+{
+    std::filesystem::path path;
+
+    TempDirectory()
+    {
+        std::random_device rd;
+        path = std::filesystem::temp_directory_path() / ("slang-rhi-test-cache-" + std::to_string(rd()));
+    }
+
+    ~TempDirectory()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+};
+
+} // namespace
+
+TEST_CASE("file-persistent-cache")
+{
+    TempDirectory dir;
+
+    SUBCASE("roundtrip")
+    {
+        ComPtr<IPersistentCache> cache = openCache(dir.path);
+        ComPtr<ISlangBlob> blob;
+        CHECK_EQ(cache->queryCache(createStringBlob("key0"), blob.writeRef()), SLANG_E_NOT_FOUND);
+        CHECK(blob == nullptr);
+
+        writeEntry(cache, "key0", "data0");
+        writeEntry(cache, "key1", std::string(1000, 'x'));
+        CHECK(hasEntry(cache, "key0", "data0"));
+        CHECK(hasEntry(cache, "key1", std::string(1000, 'x')));
+
+        // Overwrite an existing entry.
+        writeEntry(cache, "key0", "new-data0");
+        CHECK(hasEntry(cache, "key0", "new-data0"));
+    }
+
+    SUBCASE("reopen")
+    {
+        {
+            ComPtr<IPersistentCache> cache = openCache(dir.path);
+            writeEntry(cache, "key0", "data0");
+        }
+        ComPtr<IPersistentCache> cache = openCache(dir.path);
+        CHECK(hasEntry(cache, "key0", "data0"));
+        CHECK_FALSE(hasEntry(cache, "key1", "data1"));
+    }
+
+    SUBCASE("eviction")
+    {
+        // Each entry takes a bit more than 1 KB on disk, so only 3 entries fit.
+        ComPtr<IPersistentCache> cache = openCache(dir.path, 3500);
+        std::string data(1024, 'x');
+        writeEntry(cache, "key0", data);
+        writeEntry(cache, "key1", data);
+        writeEntry(cache, "key2", data);
+        // Touch key0 so key1 becomes the least recently used entry.
+        CHECK(hasEntry(cache, "key0", data));
+        writeEntry(cache, "key3", data);
+        CHECK(hasEntry(cache, "key0", data));
+        CHECK_FALSE(hasEntry(cache, "key1", data));
+        CHECK(hasEntry(cache, "key2", data));
+        CHECK(hasEntry(cache, "key3", data));
+
+        // Entries larger than the budget are not stored.
+        writeEntry(cache, "key4", std::string(4096, 'x'));
+        CHECK_FALSE(hasEntry(cache, "key4", std::string(4096, 'x')));
+        CHECK(hasEntry(cache, "key3", data));
+    }
+
+    SUBCASE("mapped")
+    {
+        // Entries that are still mapped by a query result can be replaced and evicted.
+        ComPtr<IPersistentCache> cache = openCache(dir.path, 2500);
+        std::string data(1024, 'x');
+        writeEntry(cache, "key0", data);
+        ComPtr<ISlangBlob> blob;
+        REQUIRE_CALL(cache->queryCache(createStringBlob("key0"), blob.writeRef()));
+        writeEntry(cache, "key0", std::string(1024, 'y'));
+        CHECK(hasEntry(cache, "key0", std::string(1024, 'y')));
+        writeEntry(cache, "key1", data);
+        writeEntry(cache, "key2", data);
+        CHECK_FALSE(hasEntry(cache, "key0", std::string(1024, 'y')));
+        CHECK(std::memcmp(blob->getBufferPointer(), data.data(), data.size()) == 0);
+
+        // Files that could not be removed while mapped are removed eventually.
+        blob = nullptr;
+        cache = nullptr;
+        cache = openCache(dir.path, 2500);
+        for (const auto& dirEntry : std::filesystem::directory_iterator(dir.path))
+        {
+            CHECK_NE(dirEntry.path().extension().string(), ".old");
+            CHECK_NE(dirEntry.path().extension().string(), ".tmp");
+        }
+    }
+
+    SUBCASE("concurrent")
+    {
+        // Multiple caches share the same directory, like separate processes would.
+        static constexpr int kThreadCount = 4;
+        static constexpr int kEntryCount = 16;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreadCount; ++t)
+        {
+            threads.emplace_back(
+                [&dir]()
+                {
+                    ComPtr<IPersistentCache> cache = openCache(dir.path);
+                    for (int i = 0; i < kEntryCount; ++i)
+                    {
+                        std::string key = "key" + std::to_string(i);
+                        std::string data = "data" + std::to_string(i);
+                        cache->writeCache(createStringBlob(key), createStringBlob(data));
+                        ComPtr<ISlangBlob> blob;
+                        cache->queryCache(createStringBlob(key), blob.writeRef());
+                    }
+                }
+            );
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        ComPtr<IPersistentCache> cache = openCache(dir.path);
+        for (int i = 0; i < kEntryCount; ++i)
+            CHECK(hasEntry(cache, "key" + std::to_string(i), "data" + std::to_string(i)));
+    }
+}
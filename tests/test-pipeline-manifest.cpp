@@ -0,0 +1,253 @@
+#include "testing.h"
+
+#include "rhi-shared.h"
+
+#include <string>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+namespace {
+
+struct TransformerPipeline
+{
+    ComPtr<IShaderProgram> program;
+    slang::ProgramLayout* slangReflection = nullptr;
+    ComPtr<IComputePipeline> pipeline;
+
+    void init(IDevice* device)
+    {
+        REQUIRE_CALL(
+            loadAndLinkProgram(device, "test-compute-smoke", "computeMain", program.writeRef(), &slangReflection)
+        );
+        ComputePipelineDesc pipelineDesc = {};
+        pipelineDesc.program = program;
+        REQUIRE_CALL(device->createComputePipeline(pipelineDesc, pipeline.writeRef()));
+    }
+
+    /// Submit a dispatch transforming {0, 1, 2, 3} without waiting for it, and return the buffer it writes.
+    ComPtr<IBuffer> submit(IDevice* device, const char* transformerType, float c)
+    {
+        float initialData[] = {0.0f, 1.0f, 2.0f, 3.0f};
+        BufferDesc bufferDesc = {};
+        bufferDesc.size = sizeof(initialData);
+        bufferDesc.elementSize = sizeof(float);
+        bufferDesc.usage = BufferUsage::ShaderResource | BufferUsage::UnorderedAccess | BufferUsage::CopySource;
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        ComPtr<IBuffer> buffer;
+        REQUIRE_CALL(device->createBuffer(bufferDesc, initialData, buffer.writeRef()));
+
+        ComPtr<IShaderObject> transformer;
+        REQUIRE_CALL(device->createShaderObject(
+            nullptr,
+            slangReflection->findTypeByName(transformerType),
+            ShaderObjectContainerType::None,
+            transformer.writeRef()
+        ));
+        ShaderCursor(transformer)["c"].setData(&c, sizeof(float));
+
+        auto queue = device->getQueue(QueueType::Graphics);
+        auto encoder = queue->createCommandEncoder();
+        auto rootObject = device->createRootShaderObject(pipeline);
+        ShaderCursor cursor(rootObject->getEntryPoint(0));
+        cursor["buffer"].setBinding(buffer);
+        cursor["transformer"].setObject(transformer);
+        auto passEncoder = encoder->beginComputePass();
+        passEncoder->bindPipeline(pipeline, rootObject);
+        passEncoder->dispatchCompute(1, 1, 1);
+        passEncoder->end();
+        queue->submit(encoder->finish());
+        return buffer;
+    }
+
+    void dispatch(IDevice* device, const char* transformerType, float c, std::array<float, 4> expectedResult)
+    {
+        ComPtr<IBuffer> buffer = submit(device, transformerType, c);
+        device->getQueue(QueueType::Graphics)->waitOnHost();
+        compareComputeResult(device, buffer, expectedResult);
+    }
+};
+
+std::string getManifest(IDevice* device)
+{
+    ComPtr<ISlangBlob> manifest;
+    REQUIRE_CALL(device->getPipelineManifest(manifest.writeRef()));
+    return std::string(static_cast<const char*>(manifest->getBufferPointer()), manifest->getBufferSize());
+}
+
+} // namespace
+
+GPU_TEST_CASE("pipeline-manifest", ALL | DontCreateDevice)
+{
+    DeviceExtraOptions options;
+    options.recordPipelineManifest = true;
+
+    // Record the specializations used by a first device.
+    ComPtr<ISlangBlob> manifest;
+    {
+        ComPtr<IDevice> recordDevice = createTestingDevice(ctx, ctx->deviceType, false, &options);
+        TransformerPipeline transformerPipeline;
+        transformerPipeline.init(recordDevice);
+        transformerPipeline.dispatch(recordDevice, "AddTransformer", 1.0f, {11.0f, 12.0f, 13.0f, 14.0f});
+        transformerPipeline.dispatch(recordDevice, "MulTransformer", 2.0f, {0.0f, 2.0f, 4.0f, 6.0f});
+        transformerPipeline.dispatch(recordDevice, "AddTransformer", 2.0f, {12.0f, 13.0f, 14.0f, 15.0f});
+        REQUIRE_CALL(recordDevice->getPipelineManifest(manifest.writeRef()));
+    }
+
+    // Precompile them on a second device before first use.
+    device = createTestingDevice(ctx, ctx->deviceType, false, &options);
+    ShaderCache& shaderCache = getUnderlyingDevice(device)->m_shaderCache;
+    TransformerPipeline transformerPipeline;
+    transformerPipeline.init(device);
+    IPipeline* pipelines[] = {transformerPipeline.pipeline};
+    REQUIRE_CALL(device->precompilePipelines(pipelines, 1, manifest));
+    CHECK_EQ(shaderCache.getSpecializedPipelineCount(), 2);
+
+    // Precompiled pipelines are recorded as well.
+    std::string manifestString(static_cast<const char*>(manifest->getBufferPointer()), manifest->getBufferSize());
+    CHECK_EQ(getManifest(device), manifestString);
+
+    // Using the specializations does not create new pipelines.
+    transformerPipeline.dispatch(device, "MulTransformer", 3.0f, {0.0f, 3.0f, 6.0f, 9.0f});
+    transformerPipeline.dispatch(device, "AddTransformer", 1.0f, {11.0f, 12.0f, 13.0f, 14.0f});
+    CHECK_EQ(shaderCache.getSpecializedPipelineCount(), 2);
+
+    // Entries for other programs are skipped.
+    ComPtr<IShaderProgram> otherProgram;
+    REQUIRE_CALL(loadAndLinkProgram(device, "test-compute-trivial", "computeMain", otherProgram.writeRef()));
+    ComputePipelineDesc otherPipelineDesc = {};
+    otherPipelineDesc.program = otherProgram;
+    ComPtr<IComputePipeline> otherPipeline;
+    REQUIRE_CALL(device->createComputePipeline(otherPipelineDesc, otherPipeline.writeRef()));
+    IPipeline* otherPipelines[] = {otherPipeline};
+    REQUIRE_CALL(device->precompilePipelines(otherPipelines, 1, manifest));
+    CHECK_EQ(shaderCache.getSpecializedPipelineCount(), 2);
+
+    // Entries are skipped for unlabeled programs with the same entry point and parameters but different modules.
+    ComPtr<IShaderProgram> lookalikeProgram;
+    REQUIRE_CALL(loadComputeProgramFromSource(
+        device,
+        R"(
+            interface ITransformer { float transform(float x); }
+            struct AddTransformer : ITransformer { float c; float transform(float x) { return x - c; } };
+            struct MulTransformer : ITransformer { float c; float transform(float x) { return x / c; } };
+            [shader("compute")]
+            [numthreads(4,1,1)]
+            void computeMain(
+                uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+                uniform RWStructuredBuffer<float> buffer,
+                uniform ITransformer transformer)
+            {
+                buffer[sv_dispatchThreadID.x] = transformer.transform(buffer[sv_dispatchThreadID.x]);
+            }
+        )",
+        lookalikeProgram.writeRef()
+    ));
+    ComputePipelineDesc lookalikePipelineDesc = {};
+    lookalikePipelineDesc.program = lookalikeProgram;
+    ComPtr<IComputePipeline> lookalikePipeline;
+    REQUIRE_CALL(device->createComputePipeline(lookalikePipelineDesc, lookalikePipeline.writeRef()));
+    IPipeline* lookalikePipelines[] = {lookalikePipeline};
+    REQUIRE_CALL(device->precompilePipelines(lookalikePipelines, 1, manifest));
+    CHECK_EQ(shaderCache.getSpecializedPipelineCount(), 2);
+}
+
+GPU_TEST_CASE("pipeline-manifest-crlf", ALL | DontCreateDevice)
+{
+    DeviceExtraOptions options;
+    options.recordPipelineManifest = true;
+
+    std::string manifestString;
+    {
+        ComPtr<IDevice> recordDevice = createTestingDevice(ctx, ctx->deviceType, false, &options);
+        TransformerPipeline transformerPipeline;
+        transformerPipeline.init(recordDevice);
+        transformerPipeline.dispatch(recordDevice, "AddTransformer", 1.0f, {11.0f, 12.0f, 13.0f, 14.0f});
+        manifestString = getManifest(recordDevice);
+    }
+
+    // Manifests with Windows line endings are accepted.
+    std::string crlfString;
+    for (char c : manifestString)
+        crlfString += c == '\n' ? "\r\n" : std::string(1, c);
+    ComPtr<ISlangBlob> manifest;
+    REQUIRE_CALL(getRHI()->createBlob(crlfString.data(), crlfString.size(), manifest.writeRef()));
+
+    device = createTestingDevice(ctx, ctx->deviceType, false, &options);
+    TransformerPipeline transformerPipeline;
+    transformerPipeline.init(device);
+    IPipeline* pipelines[] = {transformerPipeline.pipeline};
+    REQUIRE_CALL(device->precompilePipelines(pipelines, 1, manifest));
+    CHECK_EQ(getUnderlyingDevice(device)->m_shaderCache.getSpecializedPipelineCount(), 1);
+
+    // Invalid arguments are rejected without the debug layer as well.
+    Device* underlyingDevice = getUnderlyingDevice(device);
+    CHECK_EQ(underlyingDevice->precompilePipelines(pipelines, 1, nullptr), SLANG_E_INVALID_ARG);
+    CHECK_EQ(underlyingDevice->precompilePipelines(nullptr, 1, manifest), SLANG_E_INVALID_ARG);
+    IPipeline* nullPipelines[] = {nullptr};
+    CHECK_EQ(underlyingDevice->precompilePipelines(nullPipelines, 1, manifest), SLANG_E_INVALID_ARG);
+}
+
+GPU_TEST_CASE("specialized-pipeline-cache-eviction", ALL | DontCreateDevice)
+{
+    DeviceExtraOptions options;
+    options.maxSpecializedPipelineCount = 1;
+    device = createTestingDevice(ctx, ctx->deviceType, false, &options);
+
+    auto getStats = [&]()
+    {
+        SpecializedPipelineCacheStats stats;
+        REQUIRE_CALL(device->getSpecializedPipelineCacheStats(&stats));
+        return stats;
+    };
+
+    TransformerPipeline transformerPipeline;
+    transformerPipeline.init(device);
+    transformerPipeline.dispatch(device, "AddTransformer", 1.0f, {11.0f, 12.0f, 13.0f, 14.0f});
+    SpecializedPipelineCacheStats stats = getStats();
+    CHECK_EQ(stats.entryCount, 1);
+    CHECK_EQ(stats.evictionCount, 0);
+    CHECK_GT(stats.missCount, 0);
+
+    // A second specialization evicts the first one.
+    transformerPipeline.dispatch(device, "MulTransformer", 2.0f, {0.0f, 2.0f, 4.0f, 6.0f});
+    stats = getStats();
+    CHECK_EQ(stats.entryCount, 1);
+    CHECK_EQ(stats.evictionCount, 1);
+
+    // Using the cached specialization is a hit.
+    uint64_t hitCount = stats.hitCount;
+    transformerPipeline.dispatch(device, "MulTransformer", 3.0f, {0.0f, 3.0f, 6.0f, 9.0f});
+    stats = getStats();
+    CHECK_GT(stats.hitCount, hitCount);
+    CHECK_EQ(stats.evictionCount, 1);
+
+    // Evicted specializations are created again when used.
+    uint64_t missCount = stats.missCount;
+    transformerPipeline.dispatch(device, "AddTransformer", 2.0f, {12.0f, 13.0f, 14.0f, 15.0f});
+    stats = getStats();
+    CHECK_GT(stats.missCount, missCount);
+    CHECK_EQ(stats.entryCount, 1);
+    CHECK_EQ(stats.evictionCount, 2);
+}
+
+GPU_TEST_CASE("specialized-pipeline-cache-eviction-in-flight", ALL | DontCreateDevice)
+{
+    DeviceExtraOptions options;
+    options.maxSpecializedPipelineCount = 1;
+    device = createTestingDevice(ctx, ctx->deviceType, false, &options);
+
+    // The second specialization evicts the first one while the command buffer using it is still in flight.
+    TransformerPipeline transformerPipeline;
+    transformerPipeline.init(device);
+    ComPtr<IBuffer> addBuffer = transformerPipeline.submit(device, "AddTransformer", 1.0f);
+    ComPtr<IBuffer> mulBuffer = transformerPipeline.submit(device, "MulTransformer", 2.0f);
+    SpecializedPipelineCacheStats stats;
+    REQUIRE_CALL(device->getSpecializedPipelineCacheStats(&stats));
+    CHECK_EQ(stats.entryCount, 1);
+    CHECK_EQ(stats.evictionCount, 1);
+
+    device->getQueue(QueueType::Graphics)->waitOnHost();
+    compareComputeResult(device, addBuffer, std::array{11.0f, 12.0f, 13.0f, 14.0f});
+    compareComputeResult(device, mulBuffer, std::array{0.0f, 2.0f, 4.0f, 6.0f});
+}
@@ -0,0 +1,126 @@
+#include "testing.h"
+
+#include "core/ref-object-set.h"
+
+#include <vector>
+
+using namespace rhi;
+
+namespace {
+
+struct TestObject : public RefObject
+{
+    int* destroyCount;
+
+    TestObject(int* destroyCount_)
+        : destroyCount(destroyCount_)
+    {
+    }
+
+    ~TestObject() { (*destroyCount)++; }
+};
+
+} // namespace
+
+TEST_CASE("ref-object-set")
+{
+    SUBCASE("insert-dedup")
+    {
+        int destroyCount = 0;
+        RefPtr<TestObject> a = new TestObject(&destroyCount);
+        RefPtr<TestObject> b = new TestObject(&destroyCount);
+
+        RefObjectSet set;
+        CHECK(set.empty());
+        CHECK(set.insert(a));
+        CHECK(set.insert(b));
+        CHECK_FALSE(set.insert(a));
+        CHECK_FALSE(set.insert(nullptr));
+        CHECK(set.size() == 2);
+        CHECK(set.contains(a));
+        CHECK(set.contains(b));
+
+        // A single reference is held per unique object.
+        CHECK(a->getReferenceCount() == 2);
+        CHECK(b->getReferenceCount() == 2);
+
+        set.clear();
+        CHECK(set.empty());
+        CHECK_FALSE(set.contains(a));
+        CHECK(a->getReferenceCount() == 1);
+        CHECK(destroyCount == 0);
+    }
+
+    SUBCASE("keeps-objects-alive")
+    {
+        int destroyCount = 0;
+        RefObjectSet set;
+        set.insert(new TestObject(&destroyCount));
+        set.insert(new TestObject(&destroyCount));
+        CHECK(destroyCount == 0);
+        set.clear();
+        CHECK(destroyCount == 2);
+    }
+
+    SUBCASE("grow-and-reuse")
+    {
+        int destroyCount = 0;
+        static constexpr int kCount = 1000;
+        std::vector<RefPtr<TestObject>> objects;
+        for (int i = 0; i < kCount; i++)
+            objects.push_back(new TestObject(&destroyCount));
+
+        RefObjectSet set;
+        for (int pass = 0; pass < 3; pass++)
+        {
+            for (int i = 0; i < kCount; i++)
+                CHECK(set.insert(objects[i]));
+            for (int i = 0; i < kCount; i++)
+                CHECK_FALSE(set.insert(objects[i]));
+            CHECK(set.size() == kCount);
+            for (int i = 0; i < kCount; i++)
+                CHECK(objects[i]->getReferenceCount() == 2);
+            set.clear();
+            for (int i = 0; i < kCount; i++)
+                CHECK(objects[i]->getReferenceCount() == 1);
+        }
+        CHECK(destroyCount == 0);
+    }
+
+    SUBCASE("reuse-after-grow")
+    {
+        // A large table reused for a few objects only releases those objects.
+        int destroyCount = 0;
+        RefObjectSet set;
+        for (int i = 0; i < 1000; i++)
+            set.insert(new TestObject(&destroyCount));
+        set.clear();
+        CHECK(destroyCount == 1000);
+
+        RefPtr<TestObject> a = new TestObject(&destroyCount);
+        RefPtr<TestObject> b = new TestObject(&destroyCount);
+        for (int pass = 0; pass < 3; pass++)
+        {
+            CHECK(set.insert(a));
+            CHECK(set.insert(b));
+            CHECK(set.size() == 2);
+            CHECK(a->getReferenceCount() == 2);
+            set.clear();
+            CHECK_FALSE(set.contains(a));
+            CHECK_FALSE(set.contains(b));
+            CHECK(a->getReferenceCount() == 1);
+            CHECK(b->getReferenceCount() == 1);
+        }
+        CHECK(destroyCount == 1000);
+    }
+
+    SUBCASE("destructor-releases")
+    {
+        int destroyCount = 0;
+        {
+            RefObjectSet set;
+            set.insert(new TestObject(&destroyCount));
+        }
+        CHECK(destroyCount == 1);
+    }
+}
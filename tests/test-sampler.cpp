@@ -132,7 +132,7 @@ static void testSampler(IDevice* device, const SamplerDesc& samplerDesc, std::sp
     }
 }
 
-GPU_TEST_CASE("sampler-filter-point", D3D11 | D3D12 | Vulkan | Metal | WGPU | CUDA)
+GPU_TEST_CASE("sampler-filter-point", D3D11 | D3D12 | Vulkan | Metal | WGPU | CUDA | CPU)
 {
     SamplerDesc desc = {};
     desc.minFilter = TextureFilteringMode::Point;
@@ -160,7 +160,7 @@ GPU_TEST_CASE("sampler-filter-point", D3D11 | D3D12 | Vulkan | Metal | WGPU | CU
     testSampler(device, desc, testRecords);
 }
 
-GPU_TEST_CASE("sampler-filter-linear", D3D11 | D3D12 | Vulkan | Metal | WGPU | CUDA)
+GPU_TEST_CASE("sampler-filter-linear", D3D11 | D3D12 | Vulkan | Metal | WGPU | CUDA | CPU)
 {
     SamplerDesc desc = {};
     desc.minFilter = TextureFilteringMode::Linear;
@@ -190,7 +190,7 @@ GPU_TEST_CASE("sampler-filter-linear", D3D11 | D3D12 | Vulkan | Metal | WGPU | C
     testSampler(device, desc, testRecords);
 }
 
-GPU_TEST_CASE("sampler-border-black-transparent", D3D11 | D3D12 | Vulkan | Metal | CUDA)
+GPU_TEST_CASE("sampler-border-black-transparent", D3D11 | D3D12 | Vulkan | Metal | CUDA | CPU)
 {
     SamplerDesc desc = {};
     desc.addressU = TextureAddressingMode::ClampToBorder;
@@ -205,7 +205,7 @@ GPU_TEST_CASE("sampler-border-black-transparent", D3D11 | D3D12 | Vulkan | Metal
     testSampler(device, desc, testRecords);
 }
 
-GPU_TEST_CASE("sampler-border-black-opaque", D3D11 | D3D12 | Vulkan | Metal | CUDA)
+GPU_TEST_CASE("sampler-border-black-opaque", D3D11 | D3D12 | Vulkan | Metal | CUDA | CPU)
 {
     SamplerDesc desc = {};
     desc.addressU = TextureAddressingMode::ClampToBorder;
@@ -225,7 +225,7 @@ GPU_TEST_CASE("sampler-border-black-opaque", D3D11 | D3D12 | Vulkan | Metal | CU
     testSampler(device, desc, testRecords);
 }
 
-GPU_TEST_CASE("sampler-border-white-opaque", D3D11 | D3D12 | Vulkan | Metal | CUDA)
+GPU_TEST_CASE("sampler-border-white-opaque", D3D11 | D3D12 | Vulkan | Metal | CUDA | CPU)
 {
     SamplerDesc desc = {};
     desc.addressU = TextureAddressingMode::ClampToBorder;
@@ -244,7 +244,7 @@ GPU_TEST_CASE("sampler-border-white-opaque", D3D11 | D3D12 | Vulkan | Metal | CU
     testSampler(device, desc, testRecords);
 }
 
-GPU_TEST_CASE("sampler-border-custom-color", D3D11 | D3D12 | Vulkan | Metal | CUDA)
+GPU_TEST_CASE("sampler-border-custom-color", D3D11 | D3D12 | Vulkan | Metal | CUDA | CPU)
 {
     if (!device->hasFeature(Feature::CustomBorderColor))
         SKIP("Custom border color not supported");
@@ -0,0 +1,45 @@
+#include "testing.h"
+
+#include "rhi-shared.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rhi;
+using namespace rhi::testing;
+
+GPU_TEST_CASE("shader-cache-component-ids", CPU)
+{
+    ShaderCache& shaderCache = getUnderlyingDevice(device)->m_shaderCache;
+
+    // Threads racing to create the same components agree on their IDs.
+    static constexpr int kThreadCount = 4;
+    static constexpr int kNameCount = 64;
+    std::vector<std::vector<ShaderComponentID>> ids(kThreadCount, std::vector<ShaderComponentID>(kNameCount));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadCount; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (int i = 0; i < kNameCount; ++i)
+                    ids[t][i] = shaderCache.getComponentId("ComponentIdTestType" + std::to_string(i));
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+    for (int i = 0; i < kNameCount; ++i)
+    {
+        for (int t = 1; t < kThreadCount; ++t)
+            CHECK_EQ(ids[t][i], ids[0][i]);
+        CHECK_EQ(shaderCache.getComponentName(ids[0][i]), "ComponentIdTestType" + std::to_string(i));
+    }
+
+    // Session types cached by pointer map to the same component as their name.
+    slang::TypeReflection* dynamicType = getUnderlyingDevice(device)->m_slangContext.session->getDynamicType();
+    ShaderComponentID dynamicId = shaderCache.getComponentId(dynamicType);
+    CHECK_EQ(shaderCache.getSessionTypeComponentId(dynamicType), dynamicId);
+    CHECK_EQ(shaderCache.getSessionTypeComponentId(dynamicType), dynamicId);
+}
@@ -920,17 +920,17 @@ void runTest(GpuTestContext* ctx)
 // These tests are super expensive because they re-create devices.
 // This is needed because slang doesn't support reloading modules at this time.
 
-GPU_TEST_CASE("shader-cache-source-file", D3D12 | Vulkan | DontCreateDevice)
+GPU_TEST_CASE("shader-cache-source-file", D3D12 | Vulkan | CPU | DontCreateDevice)
 {
     runTest<ShaderCacheTestSourceFile>(ctx);
 }
 
-GPU_TEST_CASE("shader-cache-source-string", D3D12 | Vulkan | DontCreateDevice)
+GPU_TEST_CASE("shader-cache-source-string", D3D12 | Vulkan | CPU | DontCreateDevice)
 {
     runTest<ShaderCacheTestSourceString>(ctx);
 }
 
-GPU_TEST_CASE("shader-cache-entry-point", D3D12 | Vulkan | DontCreateDevice)
+GPU_TEST_CASE("shader-cache-entry-point", D3D12 | Vulkan | CPU | DontCreateDevice)
 {
     runTest<ShaderCacheTestEntryPoint>(ctx);
 }
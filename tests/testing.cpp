@@ -627,6 +627,8 @@ ComPtr<IDevice> createTestingDevice(
             deviceDesc.persistentPipelineCache = extraOptions->persistentPipelineCache;
         deviceDesc.enableCompilationReports = extraOptions->enableCompilationReports;
         deviceDesc.pipelineCompilationMode = extraOptions->pipelineCompilationMode;
+        deviceDesc.recordPipelineManifest = extraOptions->recordPipelineManifest;
+        deviceDesc.maxSpecializedPipelineCount = extraOptions->maxSpecializedPipelineCount;
         deviceDesc.existingDeviceHandles = extraOptions->existingDeviceHandles;
         deviceDesc.enableAftermath = extraOptions->enableAftermath;
         deviceDesc.enableRayTracingValidation = extraOptions->enableRayTracingValidation;
@@ -807,6 +809,15 @@ ComPtr<IDevice> createTestingDevice(
         deviceDesc.next = &extDesc;
     }
 
+    CPUDeviceExtendedDesc cpuExtDesc = {};
+    if (deviceType == DeviceType::CPU && extraOptions)
+    {
+        cpuExtDesc.asyncQueue = extraOptions->cpuAsyncQueue;
+        cpuExtDesc.computeGrainSize = extraOptions->cpuComputeGrainSize;
+        cpuExtDesc.singleThreaded = extraOptions->cpuSingleThreaded;
+        deviceDesc.next = &cpuExtDesc;
+    }
+
 #if SLANG_RHI_DEBUG
     // We do not set the DebugLayerOptions here since this is done
     // higher up in the call-tree before creating devices.
@@ -331,6 +331,8 @@ struct DeviceExtraOptions
     IPersistentCache* persistentPipelineCache = nullptr;
     bool enableCompilationReports = false;
     PipelineCompilationMode pipelineCompilationMode = PipelineCompilationMode::Serial;
+    bool recordPipelineManifest = false;
+    uint32_t maxSpecializedPipelineCount = 0;
     DeviceNativeHandles existingDeviceHandles;
 
     // D3D12-specific (no effect for other devices): Limit the maximum shader model. When set to 0
@@ -338,6 +340,14 @@ struct DeviceExtraOptions
     // This value is passed to D3D12DeviceExtendedDesc::highestShaderModel.
     uint32_t d3d12HighestShaderModel = 0;
 
+    // CPU-specific (no effect for other devices): Execute submits on a dedicated queue thread.
+    // This value is passed to CPUDeviceExtendedDesc::asyncQueue.
+    bool cpuAsyncQueue = false;
+    // CPU-specific (no effect for other devices): Passed to CPUDeviceExtendedDesc::computeGrainSize.
+    uint32_t cpuComputeGrainSize = 0;
+    // CPU-specific (no effect for other devices): Passed to CPUDeviceExtendedDesc::singleThreaded.
+    bool cpuSingleThreaded = false;
+
     bool enableValidation = false;
     bool enableRayTracingValidation = false;
     bool enableAftermath = false;
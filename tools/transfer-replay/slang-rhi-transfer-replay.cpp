@@ -0,0 +1,186 @@
+// Replays a transfer command capture written by `ICommandBuffer::captureTransfers` and reports timings.
+//
+// Usage: slang-rhi-transfer-replay <capture> [--device <type>] [--per-command] [--repeat <count>] [--validation]
+
+#include <slang-rhi.h>
+
+#include "command-capture.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace rhi;
+
+static bool parseDeviceType(const char* str, DeviceType& outDeviceType)
+{
+    static const DeviceType kDeviceTypes[] = {
+        DeviceType::Default,
+        DeviceType::D3D11,
+        DeviceType::D3D12,
+        DeviceType::Vulkan,
+        DeviceType::Metal,
+        DeviceType::CPU,
+        DeviceType::CUDA,
+        DeviceType::WGPU,
+    };
+    auto toLower = [](std::string s)
+    {
+        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+        return s;
+    };
+    std::string name = toLower(str);
+    for (DeviceType deviceType : kDeviceTypes)
+    {
+        if (toLower(getRHI()->getDeviceTypeName(deviceType)) == name)
+        {
+            outDeviceType = deviceType;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void printUsage()
+{
+    printf("Usage: slang-rhi-transfer-replay <capture> [options]\n");
+    printf("Options:\n");
+    printf("  --device <type>   Device type (d3d11, d3d12, vulkan, metal, cpu, cuda, wgpu). Default: default\n");
+    printf("  --per-command     Submit and wait on every command (or pass) to measure its execution time\n");
+    printf("  --repeat <count>  Number of times to replay the capture. Default: 1\n");
+    printf("  --validation      Enable the debug layer\n");
+}
+
+int main(int argc, const char** argv)
+{
+    const char* capturePath = nullptr;
+    DeviceType deviceType = DeviceType::Default;
+    bool perCommand = false;
+    bool validation = false;
+    int repeat = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--device") == 0 && i + 1 < argc)
+        {
+            if (!parseDeviceType(argv[++i], deviceType))
+            {
+                fprintf(stderr, "Unknown device type '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (std::strcmp(arg, "--per-command") == 0)
+        {
+            perCommand = true;
+        }
+        else if (std::strcmp(arg, "--repeat") == 0 && i + 1 < argc)
+        {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--validation") == 0)
+        {
+            validation = true;
+        }
+        else if (arg[0] != '-' && !capturePath)
+        {
+            capturePath = arg;
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (!capturePath)
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::ifstream file(capturePath, std::ios::binary);
+    if (!file)
+    {
+        fprintf(stderr, "Failed to open '%s'\n", capturePath);
+        return 1;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    CaptureReplayer replayer;
+    if (SLANG_FAILED(replayer.load(data.data(), data.size())))
+    {
+        fprintf(stderr, "Invalid or incompatible capture '%s'\n", capturePath);
+        return 1;
+    }
+
+    DeviceDesc deviceDesc;
+    deviceDesc.deviceType = deviceType;
+    deviceDesc.enableValidation = validation;
+    ComPtr<IDevice> device;
+    if (SLANG_FAILED(getRHI()->createDevice(deviceDesc, device.writeRef())))
+    {
+        fprintf(stderr, "Failed to create device\n");
+        return 1;
+    }
+    ComPtr<ICommandQueue> queue;
+    if (SLANG_FAILED(device->getQueue(QueueType::Graphics, queue.writeRef())))
+    {
+        fprintf(stderr, "Failed to get queue\n");
+        return 1;
+    }
+    if (SLANG_FAILED(replayer.createObjects(device)))
+    {
+        fprintf(stderr, "Failed to create captured objects\n");
+        return 1;
+    }
+
+    printf("Device: %s (%s)\n", device->getInfo().adapterName, getRHI()->getDeviceTypeName(device->getDeviceType()));
+    printf("Capture: %u objects, %u commands\n", replayer.getObjectCount(), replayer.getCommandCount());
+
+    uint32_t commandCount = replayer.getCommandCount();
+    std::vector<double> encodeTimesUS(commandCount, 0.0);
+    std::vector<double> executeTimesMS(commandCount, 0.0);
+    double minTotalMS = 0.0;
+    double sumTotalMS = 0.0;
+    for (int iteration = 0; iteration < repeat; ++iteration)
+    {
+        double totalMS = 0.0;
+        if (SLANG_FAILED(replayer.replay(queue, perCommand, &totalMS)))
+        {
+            fprintf(stderr, "Replay failed\n");
+            return 1;
+        }
+        const auto& timings = replayer.getTimings();
+        for (uint32_t i = 0; i < commandCount; ++i)
+        {
+            encodeTimesUS[i] += timings[i].encodeTimeUS;
+            executeTimesMS[i] += timings[i].executeTimeMS;
+        }
+        minTotalMS = iteration == 0 ? totalMS : std::min(minTotalMS, totalMS);
+        sumTotalMS += totalMS;
+    }
+
+    printf("\n%6s  %-36s %12s", "#", "command", "encode (us)");
+    if (perCommand)
+        printf(" %13s", "execute (ms)");
+    printf("\n");
+    const auto& timings = replayer.getTimings();
+    for (uint32_t i = 0; i < commandCount; ++i)
+    {
+        const char* name = getCommandName(timings[i].id);
+        printf("%6u  %-36s %12.2f", i, name, encodeTimesUS[i] / repeat);
+        if (perCommand && executeTimesMS[i] > 0.0)
+            printf(" %13.3f", executeTimesMS[i] / repeat);
+        printf("\n");
+    }
+
+    printf("\nReplayed %u commands, %d iteration(s)\n", commandCount, repeat);
+    printf("Total time: avg %.3f ms, min %.3f ms\n", sumTotalMS / repeat, minTotalMS);
+    return 0;
+}